@@ -0,0 +1,227 @@
+/**
+ * @file cpu_topology.cpp
+ * @brief CPU topology reading from sysfs.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/devices/cpu_topology.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+
+namespace knp::devices::cpu
+{
+
+namespace
+{
+
+// Read the first line of a file.
+std::string read_line(const std::filesystem::path &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+
+// Parse a non-negative number, `sysfs` uses `-1` for unknown indexes.
+std::optional<uint64_t> parse_number(const std::string &text)
+{
+    size_t pos = 0;
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    if (pos == text.size() || !std::isdigit(static_cast<unsigned char>(text[pos]))) return std::nullopt;
+    return std::stoull(text.substr(pos));
+}
+
+
+std::optional<unsigned> read_index(const std::filesystem::path &path)
+{
+    const auto result = parse_number(read_line(path));
+    if (!result) return std::nullopt;
+    return static_cast<unsigned>(*result);
+}
+
+
+// Parse a CPU list in the `0-3,8,10-11` format.
+std::vector<unsigned> parse_cpu_list(const std::string &cpu_list)
+{
+    std::vector<unsigned> result;
+    std::istringstream stream(cpu_list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        const auto dash_pos = range.find('-');
+        const auto first = parse_number(range.substr(0, dash_pos));
+        if (!first) continue;
+        const auto last = dash_pos == std::string::npos ? first : parse_number(range.substr(dash_pos + 1));
+        if (!last) continue;
+        for (auto cpu = *first; cpu <= *last; ++cpu) result.push_back(static_cast<unsigned>(cpu));
+    }
+    return result;
+}
+
+
+// Parse a cache size in the `512K` format.
+uint64_t parse_cache_size(const std::string &text)
+{
+    const auto value = parse_number(text);
+    if (!value) return 0;
+    switch (text.empty() ? '\0' : text.back())
+    {
+        case 'K':
+            return *value * 1024;
+        case 'M':
+            return *value * 1024 * 1024;
+        case 'G':
+            return *value * 1024 * 1024 * 1024;
+        default:
+            return *value;
+    }
+}
+
+
+// Read the `MemTotal` value of a node `meminfo` file.
+uint64_t read_node_memory(const std::filesystem::path &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        // Line format: "Node 0 MemTotal:       16303940 kB".
+        const auto key_pos = line.find("MemTotal:");
+        if (key_pos == std::string::npos) continue;
+        const auto value = parse_number(line.substr(key_pos + sizeof("MemTotal:") - 1));
+        return value ? *value * 1024 : 0;
+    }
+    return 0;
+}
+
+
+// Read sizes of unified or data caches of a CPU.
+void read_cache_sizes(const std::filesystem::path &cpu_path, CpuTopology &topology)
+{
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(cpu_path / "cache", error))
+    {
+        if (entry.path().filename().string().rfind("index", 0) != 0) continue;
+        if (read_line(entry.path() / "type") == "Instruction") continue;
+        const auto level = read_index(entry.path() / "level");
+        const auto size = parse_cache_size(read_line(entry.path() / "size"));
+        if (level == 2U)
+            topology.l2_cache_bytes_ = size;
+        else if (level == 3U)
+            topology.l3_cache_bytes_ = size;
+    }
+}
+
+}  // namespace
+
+
+KNP_DECLSPEC CpuTopology get_cpu_topology(const std::filesystem::path &system_path)
+{
+    CpuTopology result;
+    const auto cpus_path = system_path / "cpu";
+    std::error_code error;
+    if (!std::filesystem::exists(cpus_path / "online", error))
+    {
+        SPDLOG_DEBUG("CPU topology is unknown: {} does not exist.", (cpus_path / "online").string());
+        return result;
+    }
+
+    std::vector<unsigned> online_cpus = parse_cpu_list(read_line(cpus_path / "online"));
+    for (const auto cpu : online_cpus)
+    {
+        const auto topology_path = cpus_path / ("cpu" + std::to_string(cpu)) / "topology";
+        const unsigned socket = read_index(topology_path / "physical_package_id").value_or(0);
+        const unsigned core_id = read_index(topology_path / "core_id").value_or(cpu);
+
+        if (std::find(result.sockets_.begin(), result.sockets_.end(), socket) == result.sockets_.end())
+        {
+            result.sockets_.push_back(socket);
+        }
+        auto core_iter = std::find_if(
+            result.cores_.begin(), result.cores_.end(),
+            [socket, core_id](const CpuCore &core) { return core.socket_ == socket && core.id_ == core_id; });
+        if (core_iter == result.cores_.end())
+            result.cores_.push_back({socket, core_id, {cpu}});
+        else
+            core_iter->threads_.push_back(cpu);
+    }
+    std::sort(result.sockets_.begin(), result.sockets_.end());
+    std::sort(
+        result.cores_.begin(), result.cores_.end(), [](const CpuCore &first, const CpuCore &second)
+        { return std::tie(first.socket_, first.id_) < std::tie(second.socket_, second.id_); });
+
+    // Processors of a system have caches of the same size, so the caches of the first CPU are read.
+    if (!online_cpus.empty()) read_cache_sizes(cpus_path / ("cpu" + std::to_string(online_cpus.front())), result);
+
+    const auto nodes_path = system_path / "node";
+    if (!std::filesystem::exists(nodes_path / "online", error))
+    {
+        // A system without NUMA support has a single node.
+        result.nodes_.push_back({0, std::move(online_cpus), 0});
+        return result;
+    }
+    for (const auto node : parse_cpu_list(read_line(nodes_path / "online")))
+    {
+        const auto node_path = nodes_path / ("node" + std::to_string(node));
+        result.nodes_.push_back(
+            {node, parse_cpu_list(read_line(node_path / "cpulist")), read_node_memory(node_path / "meminfo")});
+    }
+    return result;
+}
+
+
+KNP_DECLSPEC CpuTopology get_socket_topology(const CpuTopology &topology, unsigned socket)
+{
+    CpuTopology result;
+    result.l2_cache_bytes_ = topology.l2_cache_bytes_;
+    result.l3_cache_bytes_ = topology.l3_cache_bytes_;
+    if (std::find(topology.sockets_.begin(), topology.sockets_.end(), socket) == topology.sockets_.end()) return result;
+    result.sockets_.push_back(socket);
+
+    std::vector<unsigned> socket_cpus;
+    for (const auto &core : topology.cores_)
+    {
+        if (core.socket_ != socket) continue;
+        result.cores_.push_back(core);
+        socket_cpus.insert(socket_cpus.end(), core.threads_.begin(), core.threads_.end());
+    }
+    for (const auto &node : topology.nodes_)
+    {
+        NumaNode socket_node{node.id_, {}, node.memory_bytes_};
+        std::copy_if(
+            node.cpus_.begin(), node.cpus_.end(), std::back_inserter(socket_node.cpus_),
+            [&socket_cpus](unsigned cpu)
+            { return std::find(socket_cpus.begin(), socket_cpus.end(), cpu) != socket_cpus.end(); });
+        if (!socket_node.cpus_.empty()) result.nodes_.push_back(std::move(socket_node));
+    }
+    return result;
+}
+
+}  // namespace knp::devices::cpu
@@ -45,14 +45,17 @@ public:
 };
 
 
-CPU::CPU(uint32_t cpu_num) : cpu_num_(cpu_num), power_meter_{std::make_unique<CpuPower>(cpu_num)}
+CPU::CPU(uint32_t cpu_num)
+    : cpu_num_(cpu_num),
+      power_meter_{std::make_unique<CpuPower>(cpu_num)},
+      topology_(get_socket_topology(get_cpu_topology(), cpu_num))
 {
     cpu_name_ = "Unknown CPU " + std::to_string(cpu_num_);
     Device::base_.uid_ = knp::core::UID(boost::uuids::name_generator(core::UID(ns_uid))(cpu_name_.c_str()));
 }
 
 
-CPU::CPU(CPU&& other) : cpu_name_{std::move(other.cpu_name_)} {}
+CPU::CPU(CPU&& other) : cpu_name_{std::move(other.cpu_name_)}, topology_{std::move(other.topology_)} {}
 
 
 CPU::~CPU() {}
@@ -62,6 +65,7 @@ CPU& CPU::operator=(CPU&& other) noexcept
 {
     cpu_name_.swap(other.cpu_name_);
     power_meter_.swap(other.power_meter_);
+    std::swap(topology_, other.topology_);
     return *this;
 }
 
@@ -94,7 +98,10 @@ KNP_DECLSPEC std::vector<CPU> list_processors()
 {
     std::vector<CPU> result;
 
-    result.push_back(CPU(0));
+    // Sockets are found in the system topology, a system without it has a single socket.
+    const auto topology = get_cpu_topology();
+    if (topology.sockets_.empty()) result.push_back(CPU(0));
+    for (const auto socket : topology.sockets_) result.push_back(CPU(socket));
 
     return result;
 }
@@ -47,7 +47,10 @@ namespace knp::devices::cpu
 static constexpr const char* ns_uid = "0000-0000-0000-0000";
 
 
-CPU::CPU(uint32_t cpu_num) : cpu_num_(cpu_num), power_meter_{std::make_unique<CpuPower>(cpu_num)}
+CPU::CPU(uint32_t cpu_num)
+    : cpu_num_(cpu_num),
+      power_meter_{std::make_unique<CpuPower>(cpu_num)},
+      topology_(get_socket_topology(get_cpu_topology(), cpu_num))
 {
     auto pcm_instance = pcm::PCM::getInstance();
     const pcm::PCM::ErrorCode status = pcm_instance->program(pcm::PCM::DEFAULT_EVENTS, nullptr, true, ::getpid());
@@ -59,7 +62,12 @@ CPU::CPU(uint32_t cpu_num) : cpu_num_(cpu_num), power_meter_{std::make_unique<Cp
 }
 
 
-CPU::CPU(CPU&& other) : cpu_name_{std::move(other.cpu_name_)}, power_meter_{std::move(other.power_meter_)} {}
+CPU::CPU(CPU&& other)
+    : cpu_name_{std::move(other.cpu_name_)},
+      power_meter_{std::move(other.power_meter_)},
+      topology_{std::move(other.topology_)}
+{
+}
 
 
 CPU::~CPU() {}
@@ -69,6 +77,7 @@ CPU& CPU::operator=(CPU&& other) noexcept
 {
     cpu_name_.swap(other.cpu_name_);
     power_meter_.swap(other.power_meter_);
+    std::swap(topology_, other.topology_);
     return *this;
 }
 
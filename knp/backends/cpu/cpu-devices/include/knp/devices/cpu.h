@@ -23,6 +23,7 @@
 
 #include <knp/core/device.h>
 #include <knp/core/impexp.h>
+#include <knp/devices/cpu_topology.h>
 
 #include <memory>
 #include <string>
@@ -102,6 +103,13 @@ public:
      */
     [[nodiscard]] float get_power() const override;
 
+    /**
+     * @brief Get topology of the processor in the CPU device socket.
+     * @details Use the topology to choose the number of threads and sizes of data processed by a thread.
+     * @return cores, caches and NUMA nodes of the socket.
+     */
+    [[nodiscard]] const CpuTopology &get_topology() const { return topology_; }
+
 private:
     /**
      * @brief CPU device constructor.
@@ -115,6 +123,7 @@ private:
     // cppcheck-suppress unusedStructMember
     std::string cpu_name_;
     mutable std::unique_ptr<CpuPower> power_meter_;
+    CpuTopology topology_;
 };
 
 
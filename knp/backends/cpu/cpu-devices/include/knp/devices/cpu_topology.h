@@ -0,0 +1,144 @@
+/**
+ * @file cpu_topology.h
+ * @brief CPU topology definition.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/impexp.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+
+/**
+ * @brief CPU device namespace.
+ */
+namespace knp::devices::cpu
+{
+
+/**
+ * @brief The CpuCore structure contains logical CPUs of a physical core.
+ */
+struct CpuCore
+{
+    /**
+     * @brief Index of the socket that contains the core.
+     */
+    unsigned socket_ = 0;
+
+    /**
+     * @brief Core index in the socket.
+     */
+    unsigned id_ = 0;
+
+    /**
+     * @brief Indexes of logical CPUs that are SMT siblings of the core.
+     */
+    std::vector<unsigned> threads_;
+};
+
+
+/**
+ * @brief The NumaNode structure contains logical CPUs and memory size of a NUMA node.
+ */
+struct NumaNode
+{
+    /**
+     * @brief Node index in the system.
+     */
+    unsigned id_ = 0;
+
+    /**
+     * @brief Indexes of logical CPUs of the node.
+     * @details A node can have memory only.
+     */
+    std::vector<unsigned> cpus_;
+
+    /**
+     * @brief Size of node memory in bytes.
+     */
+    uint64_t memory_bytes_ = 0;
+};
+
+
+/**
+ * @brief The CpuTopology structure describes sockets, cores, caches and NUMA nodes of processors.
+ */
+struct CpuTopology
+{
+    /**
+     * @brief Indexes of sockets.
+     */
+    std::vector<unsigned> sockets_;
+
+    /**
+     * @brief Physical cores.
+     */
+    std::vector<CpuCore> cores_;
+
+    /**
+     * @brief NUMA nodes.
+     */
+    std::vector<NumaNode> nodes_;
+
+    /**
+     * @brief Size of an L2 cache instance in bytes, `0` if unknown.
+     */
+    uint64_t l2_cache_bytes_ = 0;
+
+    /**
+     * @brief Size of an L3 cache instance in bytes, `0` if unknown.
+     */
+    uint64_t l3_cache_bytes_ = 0;
+
+    /**
+     * @brief Get number of logical CPUs.
+     * @return number of hardware threads of all cores.
+     */
+    [[nodiscard]] size_t get_threads_count() const
+    {
+        size_t result = 0;
+        for (const auto &core : cores_) result += core.threads_.size();
+        return result;
+    }
+};
+
+
+/**
+ * @brief Read topology of online processors.
+ * @details The topology is read from the `cpu` and `node` directories of `sysfs`. If the system has no NUMA
+ * information, all CPUs belong to node `0`. On systems without `sysfs` the topology is empty.
+ * @param system_path path to the directory that contains `cpu` and `node` directories.
+ * @return processor topology.
+ */
+KNP_DECLSPEC CpuTopology get_cpu_topology(const std::filesystem::path &system_path = "/sys/devices/system");
+
+
+/**
+ * @brief Get topology of a single socket.
+ * @details Nodes that have no CPUs of the socket are not included.
+ * @param topology topology of all processors.
+ * @param socket socket index.
+ * @return socket topology.
+ */
+KNP_DECLSPEC CpuTopology get_socket_topology(const CpuTopology &topology, unsigned socket);
+
+}  // namespace knp::devices::cpu
@@ -20,6 +20,7 @@
  */
 #pragma once
 #include <knp/backends/cpu-library/impl/blifat_population_impl.h>
+#include <knp/backends/cpu-library/impl/lazy_blifat_population_impl.h>
 #include <knp/backends/cpu-library/impl/synaptic_resource_stdp_impl.h>
 
 /**
@@ -43,6 +44,44 @@ std::optional<core::messaging::SpikeMessage> calculate_blifat_population(
 }
 
 
+/**
+ * @brief Make one execution step for a population of BLIFAT neurons that skips quiescent neurons.
+ * @details A neuron that cannot spike without input is not calculated until it receives a synaptic impact. Then the
+ * decay for all skipped steps is applied to the neuron at once.
+ * @tparam BlifatLikeNeuron type of a neuron with BLIFAT-like parameters.
+ * @tparam LazyDecayState type of lazy decay state. It must have `update_steps_`, `active_neurons_` and `is_active_`
+ * vectors.
+ * @param population population to update.
+ * @param state lazy decay state of the population. The state is initialized on the first call.
+ * @param endpoint message endpoint used for message exchange.
+ * @param step_n execution step.
+ * @return indexes of spiked neurons.
+ */
+template <class BlifatLikeNeuron, class LazyDecayState>
+std::optional<core::messaging::SpikeMessage> calculate_lazy_blifat_population(
+    knp::core::Population<BlifatLikeNeuron> &population, LazyDecayState &state, knp::core::MessageEndpoint &endpoint,
+    size_t step_n)
+{
+    return calculate_lazy_blifat_like_population_impl(population, state, endpoint, step_n);
+}
+
+
+/**
+ * @brief Apply skipped steps to all quiescent neurons of a lazily calculated population of BLIFAT neurons.
+ * @tparam BlifatLikeNeuron type of a neuron with BLIFAT-like parameters.
+ * @tparam LazyDecayState type of lazy decay state.
+ * @param population population to update.
+ * @param state lazy decay state of the population.
+ * @param next_step first step that is not calculated yet.
+ */
+template <class BlifatLikeNeuron, class LazyDecayState>
+void synchronize_lazy_blifat_population(
+    knp::core::Population<BlifatLikeNeuron> &population, LazyDecayState &state, size_t next_step)
+{
+    synchronize_lazy_blifat_like_population(population, state, next_step);
+}
+
+
 /**
  * @brief Make one execution step for a population of `SynapticResourceSTDPNeuron` neurons.
  * @tparam BlifatLikeNeuron type of a neuron with BLIFAT-like parameters.
@@ -21,6 +21,7 @@
 #pragma once
 #include <knp/backends/cpu-library/impl/delta_synapse_projection_impl.h>
 
+#include <memory_resource>
 #include <unordered_map>
 /**
  * @brief Namespace for CPU backends.
@@ -44,6 +45,21 @@ void calculate_delta_synapse_projection(
 }
 
 
+/**
+ * @brief Finish an execution step for a projection of delta synapses.
+ * @details Applies weight changes that a learning rule defers to the end of a step. Call after synaptic impacts of
+ * all projections are calculated.
+ * @tparam DeltaLikeSynapseType type of a synapse that requires synapse weight and delay as parameters.
+ * @param projection projection to update.
+ * @param step_n execution step.
+ */
+template <class DeltaLikeSynapseType>
+void finish_delta_synapse_projection_step(knp::core::Projection<DeltaLikeSynapseType> &projection, size_t step_n)
+{
+    WeightUpdateSTDP<DeltaLikeSynapseType>::finish_step(projection, step_n);
+}
+
+
 /**
  * @brief Process a part of projection synapses.
  * @tparam DeltaLikeSynapse type of a synapse that requires synapse weight and delay as parameters.
@@ -54,13 +70,16 @@ void calculate_delta_synapse_projection(
  * @param part_start index of the starting synapse.
  * @param part_size number of synapses to process.
  * @param mutex mutex.
+ * @param resource memory resource for temporary data of the part.
  */
 template <class DeltaLikeSynapse>
 void calculate_projection_part(
-    knp::core::Projection<DeltaLikeSynapse> &projection, const std::unordered_map<knp::core::Step, size_t> &message_in_data,
-    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex)
+    knp::core::Projection<DeltaLikeSynapse> &projection, const SpikeCounts &message_in_data,
+    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
 {
-    calculate_projection_part_impl(projection, message_in_data, future_messages, step_n, part_start, part_size, mutex);
+    calculate_projection_part_impl(
+        projection, message_in_data, future_messages, step_n, part_start, part_size, mutex, resource);
 }
 
 }  // namespace knp::backends::cpu
@@ -29,6 +29,8 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -50,6 +52,11 @@ inline const knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaS
 }
 
 
+/**
+ * @brief Closed form of additive STDP weight change for spike sequences.
+ * @details The formula is quadratic in the number of spikes. Backends use spike traces instead, which give the same
+ * result for all-to-all pairing of spikes.
+ */
 class STDPFormula
 {
 public:
@@ -80,7 +87,7 @@ public:
             for (const auto &t_n : postsynaptic_spikes)
             {
                 // cppcheck-suppress useStlAlgorithm
-                w_j += stdp_w(static_cast<float>(t_n - t_f));
+                w_j += stdp_w(static_cast<float>(t_n) - static_cast<float>(t_f));
             }
         }
         return w_j;
@@ -101,38 +108,172 @@ private:
 };
 
 
+/**
+ * @brief Get value of a spike trace at the given step.
+ * @param trace spike trace.
+ * @param step step not earlier than the last trace update.
+ * @param tau trace time constant.
+ * @return trace value.
+ */
+inline float get_trace_value(const synapse_traits::STDPSpikeTrace &trace, knp::core::Step step, float tau)
+{
+    return trace.value_ * std::exp(-static_cast<float>(step - trace.step_) / tau);
+}
+
+
+/**
+ * @brief Add a spike to a spike trace.
+ * @details Traces are decayed lazily: a trace is updated only when a neuron spikes, the decay of all steps since the
+ * previous update is applied at once.
+ * @param trace spike trace.
+ * @param step spike step.
+ * @param tau trace time constant.
+ * @param pairing spike pairing.
+ */
+inline void add_spike_to_trace(
+    synapse_traits::STDPSpikeTrace &trace, knp::core::Step step, float tau, synapse_traits::STDPPairing pairing)
+{
+    // Nearest-neighbour pairing forgets earlier spikes.
+    const float previous_value =
+        synapse_traits::STDPPairing::all_to_all == pairing ? get_trace_value(trace, step, tau) : 0.F;
+    trace.value_ = previous_value + 1.F;
+    trace.step_ = step;
+}
+
+
+/**
+ * @brief Get a trace of a neuron, the trace container grows if needed.
+ * @param traces neuron traces.
+ * @param neuron_index neuron index.
+ * @return reference to the neuron trace.
+ */
+inline synapse_traits::STDPSpikeTrace &get_neuron_trace(
+    std::vector<synapse_traits::STDPSpikeTrace> &traces, size_t neuron_index)
+{
+    if (neuron_index >= traces.size()) traces.resize(neuron_index + 1);
+    return traces[neuron_index];
+}
+
+
+/**
+ * @brief Add a weight change to the sum of pending changes of a synapse.
+ * @tparam SharedParameters shared parameters of additive STDP synapses.
+ * @param params shared synapse parameters.
+ * @param synapses_count number of synapses in the projection.
+ * @param synapse_index index of the synapse.
+ * @param weight_change weight change.
+ */
+template <class SharedParameters>
+void add_pending_weight_change(
+    SharedParameters &params, size_t synapses_count, size_t synapse_index, float weight_change)
+{
+    if (weight_change == 0) return;
+    if (params.pending_weight_changes_.size() < synapses_count) params.pending_weight_changes_.resize(synapses_count);
+    float &pending_change = params.pending_weight_changes_[synapse_index];
+    if (pending_change == 0) params.pending_synapses_.push_back(synapse_index);
+    pending_change += weight_change;
+}
+
+
+/**
+ * @brief Record weight changes of synapses leading to spiked neurons and add the spikes to postsynaptic traces.
+ * @details A postsynaptic spike is paired with earlier presynaptic spikes that are stored in presynaptic traces.
+ * @tparam DeltaLikeSynapse base synapse type.
+ * @param projection projection with additive STDP synapses.
+ * @param message spikes of postsynaptic neurons.
+ */
 template <class DeltaLikeSynapse>
-inline void append_spike_times(
-    knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection, const SpikeMessage &message,
-    const std::function<std::vector<size_t>(knp::core::messaging::SpikeIndex)> &synapse_index_getter,
-    std::vector<knp::core::Step> knp::synapse_traits::STDPAdditiveRule<DeltaLikeSynapse>::*spike_queue)
+void process_additive_stdp_postsynaptic_spikes(
+    knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
+        &projection,
+    const SpikeMessage &message)
 {
-    // Fill synapses spike queue.
-    for (auto neuron_index : message.neuron_indexes_)
+    auto &params = projection.get_shared_parameters().synapses_parameters_;
+    const auto step = message.header_.send_time_;
+    for (const auto neuron_index : message.neuron_indexes_)
     {
-        // Might be able to change it into "traces".
-        // TODO: Inefficient, MUST be cached.
-        for (auto synapse_index : synapse_index_getter(neuron_index))
+        for (const auto synapse_index : projection.get_postsynaptic_synapses(neuron_index))
         {
-            auto &rule = std::get<core::SynapseElementAccess::synapse_data>(projection[synapse_index]).rule_;
-            // Limit spike times queue.
-            if ((rule.*spike_queue).size() < rule.tau_minus_ + rule.tau_plus_)
-            {
-                (rule.*spike_queue).push_back(message.header_.send_time_);
-            }
+            const size_t presynaptic_index = projection.get_presynaptic_indexes()[synapse_index];
+            if (presynaptic_index >= params.presynaptic_traces_.size()) continue;
+            const auto &trace = params.presynaptic_traces_[presynaptic_index];
+            add_pending_weight_change(
+                params, projection.size(), synapse_index,
+                params.a_plus_ * get_trace_value(trace, step, params.tau_plus_));
+        }
+        add_spike_to_trace(
+            get_neuron_trace(params.postsynaptic_traces_, neuron_index), step, params.tau_minus_, params.pairing_);
+    }
+}
+
+
+/**
+ * @brief Record weight changes of synapses leading from spiked neurons and add the spikes to presynaptic traces.
+ * @details A presynaptic spike is paired with earlier and simultaneous postsynaptic spikes that are stored in
+ * postsynaptic traces.
+ * @tparam DeltaLikeSynapse base synapse type.
+ * @param projection projection with additive STDP synapses.
+ * @param message spikes of presynaptic neurons.
+ */
+template <class DeltaLikeSynapse>
+void process_additive_stdp_presynaptic_spikes(
+    knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
+        &projection,
+    const SpikeMessage &message)
+{
+    auto &params = projection.get_shared_parameters().synapses_parameters_;
+    const auto step = message.header_.send_time_;
+    for (const auto neuron_index : message.neuron_indexes_)
+    {
+        for (const auto synapse_index : projection.get_presynaptic_synapses(neuron_index))
+        {
+            const size_t postsynaptic_index = projection.get_postsynaptic_indexes()[synapse_index];
+            if (postsynaptic_index >= params.postsynaptic_traces_.size()) continue;
+            const auto &trace = params.postsynaptic_traces_[postsynaptic_index];
+            add_pending_weight_change(
+                params, projection.size(), synapse_index,
+                params.a_minus_ * get_trace_value(trace, step, params.tau_minus_));
         }
+        add_spike_to_trace(
+            get_neuron_trace(params.presynaptic_traces_, neuron_index), step, params.tau_plus_, params.pairing_);
     }
 }
 
 
-inline void append_spike_times(
-    knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection,
-    const std::vector<SpikeMessage> &spikes, const std::function<std::vector<size_t>(uint32_t)> &syn_index_getter,
-    std::vector<knp::core::Step> knp::synapse_traits::STDPAdditiveRule<knp::synapse_traits::DeltaSynapse>::*spike_queue)
+/**
+ * @brief Apply recorded weight changes to synapses if the update interval ends at the step.
+ * @tparam DeltaLikeSynapse base synapse type.
+ * @param projection projection with additive STDP synapses.
+ * @param step current step.
+ */
+template <class DeltaLikeSynapse>
+void apply_additive_stdp_weight_changes(
+    knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
+        &projection,
+    knp::core::Step step)
+{
+    const auto &params = projection.get_shared_parameters().synapses_parameters_;
+    const auto interval = std::max<uint32_t>(params.weight_update_interval_, 1);
+    if ((step + 1) % interval == 0) projection.flush_weight_changes();
+}
+
+
+/**
+ * @brief Apply weight changes that are deferred to the end of a step.
+ * @details Does nothing if the projection applies weight changes when spikes are registered.
+ * @tparam DeltaLikeSynapse base synapse type.
+ * @param projection projection with additive STDP synapses.
+ * @param step current step.
+ */
+template <class DeltaLikeSynapse>
+void finish_additive_stdp_step(
+    knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
+        &projection,
+    knp::core::Step step)
 {
-    for (const auto &msg : spikes)
+    if (projection.get_shared_parameters().synapses_parameters_.update_weights_at_step_end_)
     {
-        append_spike_times(projection, msg, syn_index_getter, spike_queue);
+        apply_additive_stdp_weight_changes(projection, step);
     }
 }
 
@@ -156,7 +297,7 @@ template <class DeltaLikeSynapse>
 void register_additive_stdp_spikes_part(
     knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
         &projection,
-    std::vector<SpikeMessage> &all_messages, uint64_t part_start, uint64_t part_end)
+    std::vector<SpikeMessage> &all_messages, knp::core::Step step, uint64_t part_start, uint64_t part_end)
 {
     if (part_start != 0) return;  // Not much sense to parallelize this by projection, so it's calculated just once.
     SPDLOG_DEBUG("Calculating additive STDP delta synapse projection...");
@@ -166,11 +307,7 @@ void register_additive_stdp_spikes_part(
 
     const auto &stdp_pops = projection.get_shared_parameters().stdp_populations_;
 
-    // Spike messages to process as usual.
-    std::vector<SpikeMessage> stdp_only_messages;
-    stdp_only_messages.reserve(all_messages.size());
-
-    // TODO: Remove cycles.
+    // Postsynaptic spikes are registered first, so they are not paired with simultaneous presynaptic spikes.
     for (auto &msg : all_messages)
     {
         const auto &stdp_pop_iter = stdp_pops.find(msg.header_.sender_uid_);
@@ -181,59 +318,27 @@ void register_additive_stdp_spikes_part(
 
         const auto &[uid, processing_type] = *stdp_pop_iter;
         assert(uid == msg.header_.sender_uid_);
-        if (processing_type == ProcessingType::STDPOnly || processing_type == ProcessingType::STDPAndSpike)
-        {
-            SPDLOG_TRACE("Add spikes to STDP projection postsynaptic history.");
-            append_spike_times(
-                projection, msg,
-                [&projection](uint32_t neuron_index)
-                { return projection.find_synapses(neuron_index, ProjectionType::Search::by_postsynaptic); },
-                &knp::synapse_traits::STDPAdditiveRule<knp::synapse_traits::DeltaSynapse>::postsynaptic_spike_times_);
-        }
-        if (processing_type == ProcessingType::STDPAndSpike)
-        {
-            SPDLOG_TRACE("Add spikes to STDP projection presynaptic history.");
-            append_spike_times(
-                projection, msg,
-                [&projection](uint32_t neuron_index)
-                { return projection.find_synapses(neuron_index, ProjectionType::Search::by_postsynaptic); },
-                &knp::synapse_traits::STDPAdditiveRule<knp::synapse_traits::DeltaSynapse>::presynaptic_spike_times_);
-        }
+        assert(processing_type == ProcessingType::STDPAndSpike || processing_type == ProcessingType::STDPOnly);
+        SPDLOG_TRACE("Add spikes to STDP projection postsynaptic traces.");
+        process_additive_stdp_postsynaptic_spikes(projection, msg);
         if (processing_type == ProcessingType::STDPOnly)
         {
             SPDLOG_TRACE("STDP-only synapse, remove message from list.");
             msg.neuron_indexes_ = {};
         }
-
-        assert(processing_type == ProcessingType::STDPAndSpike || processing_type == ProcessingType::STDPOnly);
     }
-}
 
-
-template <class DeltaLikeSynapse>
-void update_projection_weights_additive_stdp_part(
-    knp::core::Projection<knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, DeltaLikeSynapse>>
-        &projection,
-    uint64_t part_start, uint64_t part_end)
-{
-    // Update projection parameters.
-    for (uint64_t i = part_start; i < std::min<uint64_t>(projection.size(), part_end); ++i)
+    // Spikes sent via synapses are presynaptic.
+    for (const auto &msg : all_messages)
     {
-        auto &proj = projection[i];
-        SPDLOG_TRACE("Applying STDP rule...");
-        auto &rule = std::get<knp::core::synapse_data>(proj).rule_;
-        const auto period = rule.tau_plus_ + rule.tau_minus_;
+        SPDLOG_TRACE("Add spikes to STDP projection presynaptic traces.");
+        process_additive_stdp_presynaptic_spikes(projection, msg);
+    }
 
-        if (rule.presynaptic_spike_times_.size() >= period && rule.postsynaptic_spike_times_.size() >= period)
-        {
-            STDPFormula stdp_formula(rule.tau_plus_, rule.tau_minus_, 1, 1);
-            SPDLOG_TRACE("Old weight = {}.", std::get<knp::core::synapse_data>(proj).weight_);
-            std::get<knp::core::synapse_data>(proj).weight_ +=
-                stdp_formula(rule.presynaptic_spike_times_, rule.postsynaptic_spike_times_);
-            SPDLOG_TRACE("New weight = {}.", std::get<knp::core::synapse_data>(proj).weight_);
-            rule.presynaptic_spike_times_.clear();
-            rule.postsynaptic_spike_times_.clear();
-        }
+    // Weight changes are applied in batches, so plasticity does not slow down each spike.
+    if (!projection.get_shared_parameters().synapses_parameters_.update_weights_at_step_end_)
+    {
+        apply_additive_stdp_weight_changes(projection, step);
     }
 }
 
@@ -247,16 +352,16 @@ struct WeightUpdateSTDP<synapse_traits::STDP<synapse_traits::STDPAdditiveRule, D
         knp::core::Projection<Synapse> &projection, std::vector<SpikeMessage> &all_messages, knp::core::Step step,
         uint64_t part_start, uint64_t part_end)
     {
-        register_additive_stdp_spikes_part(projection, all_messages, part_start, part_end);
+        register_additive_stdp_spikes_part(projection, all_messages, step, part_start, part_end);
     }
 
     static void init_synapse(const knp::synapse_traits::synapse_parameters<Synapse> &projection, knp::core::Step step)
     {
     }
 
+    // Weight changes are applied when spikes are registered.
     static void modify_weights_part(knp::core::Projection<Synapse> &projection, uint64_t part_start, uint64_t part_end)
     {
-        update_projection_weights_additive_stdp_part(projection, part_start, part_end);
     }
 
     static void init_projection(
@@ -269,6 +374,11 @@ struct WeightUpdateSTDP<synapse_traits::STDP<synapse_traits::STDPAdditiveRule, D
     {
         modify_weights_part(projection, 0, projection.size());
     }
+
+    static void finish_step(knp::core::Projection<Synapse> &projection, knp::core::Step step)
+    {
+        finish_additive_stdp_step(projection, step);
+    }
 };
 
 
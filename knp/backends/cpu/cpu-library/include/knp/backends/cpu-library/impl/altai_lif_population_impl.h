@@ -24,6 +24,8 @@
 #include <knp/core/population.h>
 #include <knp/neuron-traits/altai_lif.h>
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "lif_population_impl.h"
@@ -32,80 +34,75 @@
 namespace knp::backends::cpu
 {
 
-// TODO: Maybe make this a .cpp and change library type from INTERFACE to STATIC later
-template <>
-void calculate_pre_input_state_lif<knp::neuron_traits::AltAILIF>(
-    knp::core::Population<knp::neuron_traits::AltAILIF> &population)
+/**
+ * @brief Leak the potential of an AltAI neuron and apply thresholds to it.
+ * @details Leak is applied in the same pass as thresholds, so every neuron is read and written once per step.
+ * @param neuron neuron to calculate.
+ * @return `true` if the neuron spiked.
+ */
+inline bool calculate_altai_lif_neuron(knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF> &neuron)
 {
-    for (auto &neuron : population)
-    {
-        neuron.potential_ = std::round(neuron.potential_);
+    // Leak sign is reversed if `leak_rev_` is set and potential is negative.
+    float potential = neuron.potential_;
+    const float leak = neuron.potential_leak_;
+    potential += (neuron.leak_rev_ && potential < 0) ? -leak : leak;
 
-        neuron.potential_ = neuron.do_not_save_ ? static_cast<float>(neuron.potential_reset_value_) : neuron.potential_;
-    }
+    const float threshold = neuron.activation_threshold_;
+    const float negative_threshold = -static_cast<float>(neuron.negative_activation_threshold_);
+    const float reset = neuron.potential_reset_value_;
+    const bool is_diff = neuron.is_diff_;
+    const bool is_reset = neuron.is_reset_;
+
+    const bool spiked = potential >= threshold;
+    const float diff_potential = is_diff ? potential - threshold : potential;
+    potential = spiked ? (is_reset ? reset : diff_potential) : potential;
+
+    // A neuron that was reset after a spike is not checked against the negative threshold.
+    const bool is_below = potential <= negative_threshold && !(spiked && is_reset);
+    const float negative_diff_potential = is_diff ? potential - negative_threshold : potential;
+    const float negative_potential =
+        neuron.saturate_ ? negative_threshold : (is_reset ? -reset : negative_diff_potential);
+    neuron.potential_ = is_below ? negative_potential : potential;
+    return spiked;
 }
 
 
-void leak_potential(knp::core::Population<knp::neuron_traits::AltAILIF> &population)
+// TODO: Maybe make this a .cpp and change library type from INTERFACE to STATIC later
+template <>
+inline void calculate_pre_input_state_lif<knp::neuron_traits::AltAILIF>(
+    knp::core::Population<knp::neuron_traits::AltAILIF> &population)
 {
     for (auto &neuron : population)
     {
-        // -1 if leak_rev is true and potential < 0, 1 otherwise.
-        const int sign = (neuron.leak_rev_ && neuron.potential_ < 0) ? -1 : 1;
-        neuron.potential_ += neuron.potential_leak_ * sign;
+        const float potential = std::round(neuron.potential_);
+        neuron.potential_ = neuron.do_not_save_ ? static_cast<float>(neuron.potential_reset_value_) : potential;
     }
 }
 
 
 template <>
-void process_inputs_lif<knp::neuron_traits::AltAILIF>(
+inline void process_inputs_lif<knp::neuron_traits::AltAILIF>(
     knp::core::Population<knp::neuron_traits::AltAILIF> &population,
     const std::vector<knp::core::messaging::SynapticImpactMessage> &messages)
 {
-    for (const auto &msg : messages)
-    {
-        for (const auto &impact : msg.impacts_)
-        {
-            population[impact.postsynaptic_neuron_index_].potential_ += impact.impact_value_;
-        }
-    }
-    leak_potential(population);
+    // AltAI neurons add impacts of all types to the potential. Leak is applied together with thresholds.
+    auto &accumulator = get_impact_accumulator<float>();
+    accumulator.accumulate(messages, population.size());
+    for (const auto index : accumulator.get_targets()) population[index].potential_ += accumulator.get_total_sum(index);
+    accumulator.clear();
 }
 
 
 template <>
-knp::core::messaging::SpikeData calculate_spikes_lif<knp::neuron_traits::AltAILIF>(
+inline knp::core::messaging::SpikeData calculate_spikes_lif<knp::neuron_traits::AltAILIF>(
     knp::core::Population<knp::neuron_traits::AltAILIF> &population)
 {
+    // Negative spikes are not sent: KNP has no messages for them. Neurons below the negative threshold are only reset.
     knp::core::messaging::SpikeData spikes;
-    for (knp::core::messaging::SpikeIndex i = 0; i < population.size(); ++i)
+    for (size_t index = 0; index < population.size(); ++index)
     {
-        bool was_reset = false;
-        auto &neuron = population[i];
-        if (neuron.potential_ >= neuron.activation_threshold_)
-        {
-            spikes.push_back(i);
-            if (neuron.is_diff_) neuron.potential_ -= neuron.activation_threshold_;
-            if (neuron.is_reset_)
-            {
-                neuron.potential_ = neuron.potential_reset_value_;
-                was_reset = true;
-            }
-        }
-        if (neuron.potential_ <= -static_cast<float>(neuron.negative_activation_threshold_) && !was_reset)
-        {
-            // Might probably want a negative spike, but we don't have any of the sort in KNP. Not a large problem,
-            // just requires some conversion.
-            if (neuron.saturate_)
-            {
-                neuron.potential_ = -static_cast<float>(neuron.negative_activation_threshold_);
-                continue;
-            }
-            if (neuron.is_reset_)
-                neuron.potential_ = -neuron.potential_reset_value_;
-            else if (neuron.is_diff_)
-                neuron.potential_ += neuron.negative_activation_threshold_;
-        }
+        if (calculate_altai_lif_neuron(population[index]))
+            spikes.push_back(static_cast<knp::core::messaging::SpikeIndex>(index));
     }
     return spikes;
 }
@@ -55,6 +55,8 @@ struct WeightUpdateSTDP
 
 
     static void modify_weights(const knp::core::Projection<DeltaLikeSynapse> &projection) {}
+
+    static void finish_step(const knp::core::Projection<DeltaLikeSynapse> &projection, uint64_t step) {}
 };
 
 }  // namespace knp::backends::cpu
@@ -29,13 +29,16 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "impact_accumulator_impl.h"
 #include "synaptic_resource_stdp_impl.h"
 
 /**
@@ -43,16 +46,64 @@
  */
 namespace knp::backends::cpu
 {
+/**
+ * @brief Trait that is `true` for neurons with dopamine plasticity.
+ * @tparam Neuron neuron type.
+ */
+template <class Neuron>
+struct is_dopamine_plastic : std::false_type
+{
+};
+
+template <class BaseNeuron>
+struct is_dopamine_plastic<neuron_traits::SynapticResourceSTDPNeuron<BaseNeuron>> : std::true_type
+{
+};
+
 template <class Neuron>
 constexpr bool has_dopamine_plasticity()
 {
-    return false;
+    return is_dopamine_plastic<Neuron>::value;
 }
 
-template <>
-constexpr bool has_dopamine_plasticity<neuron_traits::SynapticResourceSTDPBLIFATNeuron>()
+
+/**
+ * @brief Check if static parameters of neurons are shared between all population neurons.
+ * @tparam Neuron neuron type.
+ * @return `true` if the population stores static neuron parameters once.
+ */
+template <class Neuron>
+constexpr bool has_shared_parameters()
 {
-    return true;
+    return !std::is_empty_v<neuron_traits::shared_neuron_parameters<Neuron>>;
+}
+
+
+/**
+ * @brief Call a function for each neuron in a range with the neuron state and its static parameters.
+ * @details For a population with shared parameters the function gets the same local copy of shared parameters for
+ * all neurons, otherwise the function gets the neuron parameters twice.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam Function type of function that takes neuron parameters, static parameters and neuron index.
+ * @param population population of neurons.
+ * @param part_start index of the first neuron.
+ * @param part_end index of the neuron following the last one.
+ * @param func function to call.
+ */
+template <class BlifatLikeNeuron, class Function>
+void for_each_blifat_like_neuron(
+    knp::core::Population<BlifatLikeNeuron> &population, size_t part_start, size_t part_end, Function func)
+{
+    if constexpr (has_shared_parameters<BlifatLikeNeuron>())
+    {
+        // The local copy cannot alias neuron states, so the compiler can keep shared parameters in registers.
+        const auto params = population.get_shared_parameters();
+        for (size_t i = part_start; i < part_end; ++i) func(population[i], params, i);
+    }
+    else
+    {
+        for (size_t i = part_start; i < part_end; ++i) func(population[i], population[i], i);
+    }
 }
 
 
@@ -109,71 +160,243 @@ void impact_blifat_like_neuron(
 }
 
 
+/**
+ * @brief Apply accumulated impacts to neurons from the given index range.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam ValueType type of accumulated sums.
+ * @tparam TargetIterator type of iterator over target neuron indexes.
+ * @param population population to update.
+ * @param accumulator accumulator with impacts on the population.
+ * @param targets_begin iterator to the first target neuron index in the range.
+ * @param targets_end iterator following the last target neuron index in the range.
+ * @param range_start index of the first neuron in the range.
+ * @param range_end index of the neuron following the last one in the range.
+ */
+template <class BlifatLikeNeuron, class ValueType, class TargetIterator>
+void apply_accumulated_impacts(
+    knp::core::Population<BlifatLikeNeuron> &population, const SynapticImpactAccumulator<ValueType> &accumulator,
+    TargetIterator targets_begin, TargetIterator targets_end, size_t range_start, size_t range_end)
+{
+    using OutputType = synapse_traits::OutputType;
+
+    for (auto target = targets_begin; target != targets_end; ++target)
+    {
+        const auto index = *target;
+        auto &neuron = population[index];
+        neuron.potential_ += accumulator.get_sum(OutputType::EXCITATORY, index) -
+                             accumulator.get_sum(OutputType::INHIBITORY_CURRENT, index);
+        neuron.inhibitory_conductance_ += accumulator.get_sum(OutputType::INHIBITORY_CONDUCTANCE, index);
+        neuron.dopamine_value_ += accumulator.get_sum(OutputType::DOPAMINE, index);
+        if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
+        {
+            neuron.is_being_forced_ |= accumulator.is_forced(index);
+        }
+    }
+    for (const auto &[index, value] : accumulator.get_blocking_impacts())
+    {
+        if (index < range_start || index >= range_end) continue;
+        impact_blifat_like_neuron<BlifatLikeNeuron>(population[index], OutputType::BLOCKING, value);
+    }
+}
+
+
+/**
+ * @brief Process impacts on a part of the population.
+ * @details Impacts are summed in dense arrays first, then the sums are applied to every target neuron at once. Disjoint
+ * parts of a population can be processed in parallel without locks.
+ * @param population population to update.
+ * @param impacts references to impacts on neurons of the part, usually returned by `split_impacts_by_part()`.
+ * @param part_start index of the first neuron to update.
+ * @param part_size number of neurons to update.
+ * @note The method is used for parallelization.
+ */
+template <class BlifatLikeNeuron>
+void process_inputs_part(
+    knp::core::Population<BlifatLikeNeuron> &population, const std::vector<SynapticImpactReference> &impacts,
+    size_t part_start, size_t part_size)
+{
+    using ValueType = decltype(neuron_traits::neuron_parameters<BlifatLikeNeuron>::potential_);
+
+    SPDLOG_TRACE("Process inputs part.");
+    const size_t part_end = std::min(part_start + part_size, population.size());
+    auto &accumulator = get_impact_accumulator<ValueType>();
+    accumulator.accumulate(impacts, part_start, part_end);
+    const auto &targets = accumulator.get_targets();
+    apply_accumulated_impacts(population, accumulator, targets.begin(), targets.end(), part_start, part_end);
+    accumulator.clear();
+}
+
+
 /**
  * @brief Process messages sent to the current population.
  * @param population population to update.
  * @param messages synaptic impact messages sent to the population.
- * @note The method is used for parallelization. See later if this method serves as a bottleneck.
+ * @note The method is used for parallelization.
  */
 template <class BlifatLikeNeuron>
 void process_inputs(
     knp::core::Population<BlifatLikeNeuron> &population,
     const std::vector<core::messaging::SynapticImpactMessage> &messages)
 {
-    SPDLOG_TRACE("Process inputs.");
-    for (const auto &message : messages)
-    {
-        for (const auto &impact : message.impacts_)
+    using ValueType = decltype(neuron_traits::neuron_parameters<BlifatLikeNeuron>::potential_);
+
+    auto &accumulator = get_impact_accumulator<ValueType>();
+    accumulator.accumulate(messages, population.size());
+    const auto &targets = accumulator.get_targets();
+    apply_accumulated_impacts(population, accumulator, targets.begin(), targets.end(), 0, population.size());
+    accumulator.clear();
+}
+
+
+/**
+ * @brief Flag of bursting feature: a neuron has a non-zero bursting phase or bursting period.
+ */
+constexpr unsigned blifat_bursting_feature = 1;
+
+
+/**
+ * @brief Flag of stochastic stimulation feature: a neuron has non-zero stochastic stimulation.
+ */
+constexpr unsigned blifat_stochastic_stimulation_feature = 2;
+
+
+/**
+ * @brief Flags of all optional features of BLIFAT-like neurons.
+ */
+constexpr unsigned all_blifat_features = blifat_bursting_feature | blifat_stochastic_stimulation_feature;
+
+
+/**
+ * @brief Find optional features that are used by neurons from the given index range.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @param population population of neurons.
+ * @param part_start index of the first neuron.
+ * @param part_end index of the neuron following the last one.
+ * @return combination of feature flags.
+ */
+template <class BlifatLikeNeuron>
+unsigned get_blifat_features(knp::core::Population<BlifatLikeNeuron> &population, size_t part_start, size_t part_end)
+{
+    unsigned features = 0;
+    for_each_blifat_like_neuron(
+        population, part_start, part_end,
+        [&features](const auto &neuron, const auto &params, size_t)
         {
-            auto &neuron = population[impact.postsynaptic_neuron_index_];
-            impact_blifat_like_neuron<BlifatLikeNeuron>(neuron, impact.synapse_type_, impact.impact_value_);
-            if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
-            {
-                if (impact.synapse_type_ == synapse_traits::OutputType::EXCITATORY)
-                {
-                    neuron.is_being_forced_ |= message.is_forcing_;
-                }
-            }
-        }
+            if (neuron.bursting_phase_ || params.bursting_period_) features |= blifat_bursting_feature;
+            if (params.stochastic_stimulation_) features |= blifat_stochastic_stimulation_feature;
+        });
+    return features;
+}
+
+
+/**
+ * @brief Call a function with a kernel specialization that supports the given features.
+ * @details Each combination of features has its own instantiation of a kernel, where the code of unused features is
+ * compiled out.
+ * @tparam Function type of function that takes `std::integral_constant` with feature flags.
+ * @param features combination of feature flags.
+ * @param func function to call.
+ */
+template <class Function>
+void dispatch_blifat_features(unsigned features, Function func)
+{
+    switch (features)
+    {
+        case 0:
+            func(std::integral_constant<unsigned, 0>{});
+            break;
+        case blifat_bursting_feature:
+            func(std::integral_constant<unsigned, blifat_bursting_feature>{});
+            break;
+        case blifat_stochastic_stimulation_feature:
+            func(std::integral_constant<unsigned, blifat_stochastic_stimulation_feature>{});
+            break;
+        default:
+            func(std::integral_constant<unsigned, all_blifat_features>{});
+            break;
     }
 }
 
 
 /**
  * @brief Calculate a single neuron state before impacts.
+ * @details Neuron must not use features that are not in `features`: such features are ignored.
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam features combination of feature flags supported by the kernel.
+ * @tparam StaticParameters type of static neuron parameters.
  * @param neuron neuron parameters.
+ * @param params static neuron parameters.
  */
-template <class BlifatLikeNeuron>
-void calculate_single_neuron_state(typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron)
+template <class BlifatLikeNeuron, unsigned features, class StaticParameters>
+void calculate_single_neuron_state_with_features(
+    typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron, const StaticParameters &params)
 {
-    neuron.dynamic_threshold_ *= neuron.threshold_decay_;
-    neuron.postsynaptic_trace_ *= neuron.postsynaptic_trace_decay_;
-    neuron.inhibitory_conductance_ *= neuron.inhibitory_conductance_decay_;
+    neuron.dynamic_threshold_ *= params.threshold_decay_;
+    neuron.postsynaptic_trace_ *= params.postsynaptic_trace_decay_;
+    neuron.inhibitory_conductance_ *= params.inhibitory_conductance_decay_;
     if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
     {
         neuron.dopamine_value_ = 0.0;
         neuron.is_being_forced_ = false;
     }
 
-    if (neuron.bursting_phase_ && !--neuron.bursting_phase_)
+    if constexpr ((features & blifat_bursting_feature) != 0)
     {
-        neuron.potential_ = neuron.potential_ * neuron.potential_decay_ + neuron.reflexive_weight_;
+        if (neuron.bursting_phase_ && !--neuron.bursting_phase_)
+        {
+            neuron.potential_ = neuron.potential_ * params.potential_decay_ + params.reflexive_weight_;
+        }
+        else
+        {
+            neuron.potential_ *= params.potential_decay_;
+        }
     }
     else
     {
-        neuron.potential_ *= neuron.potential_decay_;
+        neuron.potential_ *= params.potential_decay_;
     }
-    if (neuron.stochastic_stimulation_)
+    if constexpr ((features & blifat_stochastic_stimulation_feature) != 0)
     {
-        // Magic way to generate new random number.
-        neuron.random_number_generator_state_ = neuron.random_number_generator_state_ * 16644525LLU + 1013904223LLU;
-        neuron.potential_ += static_cast<unsigned short>(neuron.random_number_generator_state_) * neuron.stochastic_stimulation_ / 0x10000;
+        if (params.stochastic_stimulation_)
+        {
+            // Magic way to generate new random number.
+            neuron.random_number_generator_state_ =
+                neuron.random_number_generator_state_ * 16644525LLU + 1013904223LLU;
+            neuron.potential_ += static_cast<unsigned short>(neuron.random_number_generator_state_) *
+                                 params.stochastic_stimulation_ / 0x10000;
+        }
     }
     neuron.pre_impact_potential_ = neuron.potential_;
 }
 
 
+/**
+ * @brief Calculate a single neuron state before impacts.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam StaticParameters type of static neuron parameters.
+ * @param neuron neuron parameters.
+ * @param params static neuron parameters.
+ */
+template <class BlifatLikeNeuron, class StaticParameters>
+void calculate_single_neuron_state(
+    typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron, const StaticParameters &params)
+{
+    calculate_single_neuron_state_with_features<BlifatLikeNeuron, all_blifat_features>(neuron, params);
+}
+
+
+/**
+ * @brief Calculate a single neuron state before impacts.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @param neuron neuron parameters.
+ */
+template <class BlifatLikeNeuron>
+void calculate_single_neuron_state(typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron)
+{
+    calculate_single_neuron_state<BlifatLikeNeuron>(neuron, neuron);
+}
+
+
 /**
  * @brief Partially calculate population before it receives synaptic impact messages.
  * @param population population to update.
@@ -187,12 +410,20 @@ void calculate_neurons_state_part(
 {
     uint64_t part_end = std::min<uint64_t>(part_start + part_size, population.size());
     SPDLOG_TRACE("Calculate neuron state part.");
-    for (uint64_t i = part_start; i < part_end; ++i)
-    {
-        auto &neuron = population[i];
-        ++neuron.n_time_steps_since_last_firing_;
-        calculate_single_neuron_state<BlifatLikeNeuron>(neuron);
-    }
+    // Features are usually uniform within a part, so the kernel without unused features is selected for the part.
+    dispatch_blifat_features(
+        get_blifat_features(population, part_start, part_end),
+        [&population, part_start, part_end](auto features)
+        {
+            for_each_blifat_like_neuron(
+                population, part_start, part_end,
+                [](auto &neuron, const auto &params, size_t)
+                {
+                    ++neuron.n_time_steps_since_last_firing_;
+                    calculate_single_neuron_state_with_features<BlifatLikeNeuron, decltype(features)::value>(
+                        neuron, params);
+                });
+        });
 }
 
 
@@ -212,8 +443,17 @@ void calculate_neurons_state(
 }
 
 
-template <class BlifatLikeNeuron>
-bool calculate_neuron_post_input_state(typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron)
+/**
+ * @brief Calculate a single neuron state after impacts.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam StaticParameters type of static neuron parameters.
+ * @param neuron neuron parameters.
+ * @param params static neuron parameters.
+ * @return `true` if the neuron spiked.
+ */
+template <class BlifatLikeNeuron, class StaticParameters>
+bool calculate_neuron_post_input_state(
+    typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron, const StaticParameters &params)
 {
     bool spike = false;
     if (neuron.total_blocking_period_ <= 0)
@@ -233,40 +473,53 @@ bool calculate_neuron_post_input_state(typename knp::core::Population<BlifatLike
         neuron.total_blocking_period_ -= 1;
     }
 
-    if (neuron.inhibitory_conductance_ < 1.0)
+    if (neuron.inhibitory_conductance_ < 1)
     {
         neuron.potential_ -=
-            (neuron.potential_ - neuron.reversal_inhibitory_potential_) * neuron.inhibitory_conductance_;
+            (neuron.potential_ - params.reversal_inhibitory_potential_) * neuron.inhibitory_conductance_;
     }
     else
     {
-        neuron.potential_ = neuron.reversal_inhibitory_potential_;
+        neuron.potential_ = params.reversal_inhibitory_potential_;
     }
 
     // Three components of neuron threshold: "static", "common dynamic" and "implementation-specific dynamic".
-    if ((neuron.n_time_steps_since_last_firing_ > neuron.absolute_refractory_period_) &&
-        (neuron.potential_ >= neuron.activation_threshold_ + neuron.dynamic_threshold_ + neuron.additional_threshold_))
+    if ((neuron.n_time_steps_since_last_firing_ > params.absolute_refractory_period_) &&
+        (neuron.potential_ >= params.activation_threshold_ + neuron.dynamic_threshold_ + neuron.additional_threshold_))
     {
         SPDLOG_TRACE("Neuron spiked.");
         // Spike.
-        neuron.dynamic_threshold_ += neuron.threshold_increment_;
-        neuron.postsynaptic_trace_ += neuron.postsynaptic_trace_increment_;
+        neuron.dynamic_threshold_ += params.threshold_increment_;
+        neuron.postsynaptic_trace_ += params.postsynaptic_trace_increment_;
 
-        neuron.potential_ = neuron.potential_reset_value_;
-        neuron.bursting_phase_ = neuron.bursting_period_;
+        neuron.potential_ = params.potential_reset_value_;
+        neuron.bursting_phase_ = params.bursting_period_;
         neuron.n_time_steps_since_last_firing_ = 0;
         spike = true;
     }
 
-    if (neuron.potential_ < neuron.min_potential_)
+    if (neuron.potential_ < params.min_potential_)
     {
-        neuron.potential_ = neuron.min_potential_;
+        neuron.potential_ = params.min_potential_;
     }
 
     return spike;
 }
 
 
+/**
+ * @brief Calculate a single neuron state after impacts.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @param neuron neuron parameters.
+ * @return `true` if the neuron spiked.
+ */
+template <class BlifatLikeNeuron>
+bool calculate_neuron_post_input_state(typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters &neuron)
+{
+    return calculate_neuron_post_input_state<BlifatLikeNeuron>(neuron, neuron);
+}
+
+
 /**
  * @brief Finish calculation after the neurons get synaptic impacts.
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
@@ -278,13 +531,15 @@ void calculate_neurons_post_input_state(
     knp::core::Population<BlifatLikeNeuron> &population, knp::core::messaging::SpikeData &neuron_indexes)
 {
     SPDLOG_TRACE("Calculate neuron post-input state part.");
-    for (size_t index = 0; index < population.size(); ++index)
-    {
-        if (calculate_neuron_post_input_state<BlifatLikeNeuron>(population[index]))
+    for_each_blifat_like_neuron(
+        population, 0, population.size(),
+        [&neuron_indexes](auto &neuron, const auto &params, size_t index)
         {
-            neuron_indexes.push_back(index);
-        }
-    }
+            if (calculate_neuron_post_input_state<BlifatLikeNeuron>(neuron, params))
+            {
+                neuron_indexes.push_back(index);
+            }
+        });
 }
 
 
@@ -295,23 +550,26 @@ void calculate_neurons_post_input_state(
  * @param part_start index of the first neuron to update.
  * @param part_size number of neurons to calculate in a single call.
  * @param mutex mutex that is locked to update a message.
+ * @param resource memory resource for spiked neuron indexes of the part.
  * @note This method is used for parallelization.
  */
 template <class BlifatLikeNeuron>
 void calculate_neurons_post_input_state_part(
     knp::core::Population<BlifatLikeNeuron> &population, knp::core::messaging::SpikeMessage &message, size_t part_start,
-    size_t part_size, std::mutex &mutex)
+    size_t part_size, std::mutex &mutex, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
 {
     SPDLOG_TRACE("Calculate neuron post-input state part.");
     size_t part_end = std::min(part_start + part_size, population.size());
-    std::vector<size_t> output;
-    for (size_t i = part_start; i < part_end; ++i)
-    {
-        if (calculate_neuron_post_input_state<BlifatLikeNeuron>(population[i]))
+    std::pmr::vector<size_t> output(resource);
+    for_each_blifat_like_neuron(
+        population, part_start, part_end,
+        [&output](auto &neuron, const auto &params, size_t index)
         {
-            output.push_back(i);
-        }
-    }
+            if (calculate_neuron_post_input_state<BlifatLikeNeuron>(neuron, params))
+            {
+                output.push_back(index);
+            }
+        });
 
     // Updating common neuron indexes.
     const std::lock_guard<std::mutex> lock(mutex);
@@ -331,6 +589,60 @@ void finalize_population(
 }
 
 
+/**
+ * @brief Size of neuron data in bytes that is calculated in one tile by the fused population update.
+ * @details The tile fits into L2 cache together with accumulated impacts, so all calculation phases of a tile read
+ * neurons from cache.
+ */
+constexpr size_t blifat_tile_bytes = 128 * 1024;
+
+
+/**
+ * @brief Calculate all phases of a population step tile by tile.
+ * @details Each neuron goes through the same phases in the same order as in separate passes over the population: state
+ * before impacts, impacts and state after impacts. Neurons do not depend on each other within a step, so the results
+ * and the order of spiked neuron indexes do not change, but a large population is read from memory once per step.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @param population population to update.
+ * @param messages synaptic impact messages sent to the population.
+ * @param neuron_indexes output parameter, indexes of spiked neurons.
+ */
+template <class BlifatLikeNeuron>
+void calculate_neurons_tiled(
+    knp::core::Population<BlifatLikeNeuron> &population,
+    const std::vector<core::messaging::SynapticImpactMessage> &messages,
+    knp::core::messaging::SpikeData &neuron_indexes)
+{
+    using NeuronParameters = typename knp::core::Population<BlifatLikeNeuron>::NeuronParameters;
+    using ValueType = decltype(NeuronParameters::potential_);
+    constexpr size_t tile_size = std::max<size_t>(blifat_tile_bytes / sizeof(NeuronParameters), 1);
+
+    auto &accumulator = get_impact_accumulator<ValueType>();
+    accumulator.accumulate(messages, population.size());
+    const auto &targets = accumulator.get_targets();
+    auto tile_targets_begin = targets.begin();
+    for (size_t tile_start = 0; tile_start < population.size(); tile_start += tile_size)
+    {
+        const size_t tile_end = std::min(tile_start + tile_size, population.size());
+        calculate_neurons_state_part(population, tile_start, tile_end - tile_start);
+        // Targets are sorted, so targets of the tile follow targets of the previous tile.
+        const auto tile_targets_end = std::lower_bound(tile_targets_begin, targets.end(), tile_end);
+        apply_accumulated_impacts(population, accumulator, tile_targets_begin, tile_targets_end, tile_start, tile_end);
+        tile_targets_begin = tile_targets_end;
+        for_each_blifat_like_neuron(
+            population, tile_start, tile_end,
+            [&neuron_indexes](auto &neuron, const auto &params, size_t index)
+            {
+                if (calculate_neuron_post_input_state<BlifatLikeNeuron>(neuron, params))
+                {
+                    neuron_indexes.push_back(index);
+                }
+            });
+    }
+    accumulator.clear();
+}
+
+
 /**
  * @brief Process BLIFAT neuron population and return spiked neuron indexes.
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated the same as BLIFAT.
@@ -347,9 +659,8 @@ knp::core::messaging::SpikeData calculate_blifat_like_population_data(
     std::vector<core::messaging::SynapticImpactMessage> messages =
         endpoint.unload_messages<core::messaging::SynapticImpactMessage>(population.get_uid());
 
-    calculate_neurons_state(population, messages);
     knp::core::messaging::SpikeData neuron_indexes;
-    calculate_neurons_post_input_state(population, neuron_indexes);
+    calculate_neurons_tiled(population, messages, neuron_indexes);
 
     return neuron_indexes;
 }
@@ -23,12 +23,14 @@
 
 #include <knp/core/message_bus.h>
 #include <knp/core/projection.h>
+#include <knp/synapse-traits/compressed_delta.h>
 #include <knp/synapse-traits/delta.h>
 #include <knp/synapse-traits/stdp_synaptic_resource_rule.h>
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <memory_resource>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
@@ -47,6 +49,12 @@ namespace knp::backends::cpu
  */
 using MessageQueue = std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage>;
 
+/**
+ * @brief Type of the map of spiked neuron indexes to numbers of their spikes in a message.
+ * @details The map lives during a step, so it is allocated from a step arena.
+ */
+using SpikeCounts = std::pmr::unordered_map<knp::core::Step, size_t>;
+
 
 template <class ProjectionType>
 constexpr bool is_forcing()
@@ -62,51 +70,122 @@ constexpr bool is_forcing<knp::core::Projection<synapse_traits::DeltaSynapse>>()
 }
 
 
+template <>
+constexpr bool is_forcing<knp::core::Projection<synapse_traits::Float16DeltaSynapse>>()
+{
+    return true;
+}
+
+
+template <>
+constexpr bool is_forcing<knp::core::Projection<synapse_traits::BFloat16DeltaSynapse>>()
+{
+    return true;
+}
+
+
+template <>
+constexpr bool is_forcing<knp::core::Projection<synapse_traits::Int8DeltaSynapse>>()
+{
+    return true;
+}
+
+
+/**
+ * @brief Get weight of a delta-like synapse.
+ * @tparam DeltaLikeSynapse type of a synapse that has weight and delay parameters.
+ * @param projection projection that contains the synapse.
+ * @param synapse_index synapse index.
+ * @return synaptic weight.
+ */
+template <class DeltaLikeSynapse>
+float get_synapse_weight(const knp::core::Projection<DeltaLikeSynapse> &projection, size_t synapse_index)
+{
+    return projection.get_synapses_parameters()[synapse_index].weight_;
+}
+
+
+/**
+ * @brief Get weight of a compressed delta synapse.
+ * @details The weight is decoded using scale factors shared between projection synapses.
+ * @tparam WeightEncoding weight encoding type.
+ * @param projection projection that contains the synapse.
+ * @param synapse_index synapse index.
+ * @return decoded synaptic weight.
+ */
+template <class WeightEncoding>
+float get_synapse_weight(
+    const knp::core::Projection<synapse_traits::CompressedDeltaSynapse<WeightEncoding>> &projection,
+    size_t synapse_index)
+{
+    return projection.get_shared_parameters().synapses_parameters_.decode_weight(
+        projection.get_synapses_parameters()[synapse_index], projection.get_presynaptic_indexes()[synapse_index]);
+}
+
+
+/**
+ * @brief Get impacts of a projection message that is sent on the given step.
+ * @details The message is added to the queue if it does not exist.
+ * @tparam ProjectionType projection type.
+ * @param projection projection that sends the message.
+ * @param future_messages message queue.
+ * @param future_step step on which the message is sent.
+ * @param step_n current step.
+ * @return reference to message impacts.
+ */
+template <typename ProjectionType>
+std::vector<knp::core::messaging::SynapticImpact> &get_future_impacts(
+    const ProjectionType &projection, MessageQueue &future_messages, uint64_t future_step, uint64_t step_n)
+{
+    auto iter = future_messages.find(future_step);
+    if (iter == future_messages.end())
+    {
+        knp::core::messaging::SynapticImpactMessage message_out{
+            {projection.get_uid(), step_n},
+            projection.get_presynaptic(),
+            projection.get_postsynaptic(),
+            is_forcing<ProjectionType>(),
+            {}};
+        iter = future_messages.emplace(future_step, std::move(message_out)).first;
+    }
+    return iter->second.impacts_;
+}
+
+
 template <typename ProjectionType>
 MessageQueue::const_iterator calculate_delta_synapse_projection_data(
     ProjectionType &projection, std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages,
-    size_t step_n,
-    std::function<knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>(
-        const typename ProjectionType::SynapseParameters &)>
-        sp_getter = [](const typename ProjectionType::SynapseParameters &synapse_params) { return synapse_params; })
+    size_t step_n)
 {
     SPDLOG_TRACE("Calculating delta synapse projection data...");
     using SynapseType = typename ProjectionType::ProjectionSynapseType;
     WeightUpdateSTDP<SynapseType>::init_projection(projection, messages, step_n);
 
+    auto &synapses_parameters = projection.get_synapses_parameters();
+    const auto &postsynaptic_indexes = projection.get_postsynaptic_indexes();
     for (const auto &message : messages)
     {
         const auto &message_data = message.neuron_indexes_;
         for (const auto &spiked_neuron_index : message_data)
         {
-            auto synapses = projection.find_synapses(spiked_neuron_index, ProjectionType::Search::by_presynaptic);
-            for (auto synapse_index : synapses)
+            const auto synapses = projection.get_presynaptic_synapses(spiked_neuron_index);
+            auto synapse_iter = synapses.begin();
+            while (synapse_iter != synapses.end())
             {
-                auto &synapse = projection[synapse_index];
-                WeightUpdateSTDP<SynapseType>::init_synapse(std::get<core::synapse_data>(synapse), step_n);
-                const auto &synapse_params = sp_getter(std::get<core::synapse_data>(synapse));
-
+                // Consecutive synapses with the same delay are added to the delay slot as one block. If synapses are
+                // ordered by delay, each delay of the neuron has a single block.
+                const auto delay = synapses_parameters[*synapse_iter].delay_;
                 // The message is sent on step N - 1, received on step N.
-                size_t future_step = synapse_params.delay_ + step_n - 1;
-                knp::core::messaging::SynapticImpact impact{
-                    synapse_index, synapse_params.weight_, synapse_params.output_type_,
-                    static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
-                    static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
-
-                auto iter = future_messages.find(future_step);
-                if (iter != future_messages.end())
-                {
-                    iter->second.impacts_.push_back(impact);
-                }
-                else
+                auto &impacts = get_future_impacts(projection, future_messages, delay + step_n - 1, step_n);
+                for (; synapse_iter != synapses.end() && synapses_parameters[*synapse_iter].delay_ == delay;
+                     ++synapse_iter)
                 {
-                    knp::core::messaging::SynapticImpactMessage message_out{
-                        {projection.get_uid(), step_n},
-                        projection.get_presynaptic(),
-                        projection.get_postsynaptic(),
-                        is_forcing<ProjectionType>(),
-                        {impact}};
-                    future_messages.insert(std::make_pair(future_step, message_out));
+                    const auto synapse_index = *synapse_iter;
+                    auto &synapse_params = synapses_parameters[synapse_index];
+                    WeightUpdateSTDP<SynapseType>::init_synapse(synapse_params, step_n);
+                    impacts.push_back(
+                        {synapse_index, get_synapse_weight(projection, synapse_index), synapse_params.output_type_,
+                         static_cast<uint32_t>(spiked_neuron_index), postsynaptic_indexes[synapse_index]});
                 }
             }
         }
@@ -119,21 +198,23 @@ MessageQueue::const_iterator calculate_delta_synapse_projection_data(
 template <class DeltaLikeSynapse>
 void calculate_projection_part_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection,
-    const std::unordered_map<knp::core::Step, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
-    uint64_t part_start, uint64_t part_size, std::mutex &mutex)
+    const SpikeCounts &message_in_data, MessageQueue &future_messages, uint64_t step_n, uint64_t part_start,
+    uint64_t part_size, std::mutex &mutex, std::pmr::memory_resource *resource)
 {
     size_t part_end = std::min(part_start + part_size, static_cast<uint64_t>(projection.size()));
-    std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> container;
+    std::pmr::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> container(resource);
     WeightUpdateStdpMp<DeltaLikeSynapse>::init_projection_part(projection, message_in_data, step_n);
+    // Only the presynaptic index array is scanned, parameters are read for the spiked synapses.
+    const auto &presynaptic_indexes = projection.get_presynaptic_indexes();
     for (size_t synapse_index = part_start; synapse_index < part_end; ++synapse_index)
     {
-        auto &synapse = projection[synapse_index];
         // update_step(synapse.params_, step_n);
-        auto iter = message_in_data.find(std::get<core::source_neuron_id>(synapse));
+        auto iter = message_in_data.find(presynaptic_indexes[synapse_index]);
         if (iter == message_in_data.end())
         {
             continue;
         }
+        auto synapse = projection[synapse_index];
 
         // Add new impact.
         // The message is sent on step N - 1, received on step N.
@@ -141,7 +222,7 @@ void calculate_projection_part_impl(
         WeightUpdateStdpMp<DeltaLikeSynapse>::init_synapse(std::get<core::synapse_data>(synapse), step_n);
 
         knp::core::messaging::SynapticImpact impact{
-            synapse_index, std::get<core::synapse_data>(synapse).weight_ * iter->second,
+            synapse_index, get_synapse_weight(projection, synapse_index) * iter->second,
             std::get<core::synapse_data>(synapse).output_type_,
             static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
             static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
@@ -179,11 +260,14 @@ void calculate_projection_part_impl(
 /**
  * @brief Convert spike vector to unordered map.
  * @param message spike message.
+ * @param resource memory resource used by the map.
  * @return unordered map of `{index : number of instances}`. Number of instances usually equals `1`.
  */
-inline std::unordered_map<uint64_t, size_t> convert_spikes(const core::messaging::SpikeMessage &message)
+inline SpikeCounts convert_spikes(
+    const core::messaging::SpikeMessage &message,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
 {
-    std::unordered_map<knp::core::Step, size_t> result;
+    SpikeCounts result(resource);
     for (auto neuron_idx : message.neuron_indexes_)
     {
         auto iter = result.find(neuron_idx);
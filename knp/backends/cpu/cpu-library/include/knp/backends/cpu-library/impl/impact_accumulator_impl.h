@@ -0,0 +1,282 @@
+/**
+ * @file impact_accumulator_impl.h
+ * @brief Dense accumulator of synaptic impacts sent to a population.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/messaging/messaging.h>
+#include <knp/synapse-traits/output_types.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Reference to a synaptic impact of a message.
+ * @details References are used to split impacts by parts of a population without copying the impacts.
+ */
+struct SynapticImpactReference
+{
+    /**
+     * @brief Synaptic impact.
+     */
+    const core::messaging::SynapticImpact *impact_;
+
+    /**
+     * @brief `true` if the message that contains the impact is forcing.
+     */
+    bool is_forcing_;
+};
+
+
+/**
+ * @brief The SynapticImpactAccumulator class sums synaptic impacts in dense arrays indexed by postsynaptic neuron.
+ * @details Each output type has its own array of sums, so an impact is added without a branch on its type. After all
+ * messages are accumulated, the sums are applied to neurons in a single pass over sorted target indexes, and every
+ * neuron is written once. Impacts of the `BLOCKING` type replace a neuron value instead of adding to it, so they are
+ * also stored in the order of arrival. Arrays are indexed relative to the first neuron of the accumulated range, so
+ * an accumulator that processes a part of a population is sized for the part.
+ * @tparam ValueType type of accumulated sums.
+ */
+template <class ValueType>
+class SynapticImpactAccumulator
+{
+public:
+    /**
+     * @brief Number of output types that have arrays of sums.
+     */
+    static constexpr size_t output_types_count = static_cast<size_t>(synapse_traits::OutputType::BLOCKING) + 1;
+
+public:
+    /**
+     * @brief Add impacts from messages to the accumulator.
+     * @param messages synaptic impact messages sent to a population.
+     * @param neurons_count number of neurons in the population.
+     */
+    void accumulate(const std::vector<core::messaging::SynapticImpactMessage> &messages, size_t neurons_count)
+    {
+        start_range(0, neurons_count);
+        for (const auto &message : messages)
+        {
+            for (const auto &impact : message.impacts_)
+            {
+                if (impact.postsynaptic_neuron_index_ >= neurons_count) continue;
+                add(impact, message.is_forcing_);
+            }
+        }
+        collect_targets();
+    }
+
+    /**
+     * @brief Add impacts on neurons from the given index range to the accumulator.
+     * @details Impacts are usually returned by `split_impacts_by_part()`, so several accumulators can process disjoint
+     * ranges of the same population in parallel.
+     * @param impacts references to impacts on neurons from the range in the order of arrival.
+     * @param range_start index of the first neuron in the range.
+     * @param range_end index of the neuron following the last one in the range.
+     */
+    void accumulate(const std::vector<SynapticImpactReference> &impacts, size_t range_start, size_t range_end)
+    {
+        start_range(range_start, range_end);
+        for (const auto &reference : impacts)
+        {
+            const auto index = reference.impact_->postsynaptic_neuron_index_;
+            if (index < range_start || index >= range_end) continue;
+            add(*reference.impact_, reference.is_forcing_);
+        }
+        collect_targets();
+    }
+
+    /**
+     * @brief Get indexes of neurons that received impacts.
+     * @return sorted neuron indexes.
+     */
+    [[nodiscard]] const std::vector<size_t> &get_targets() const { return targets_; }
+
+    /**
+     * @brief Get sum of impact values of the given type.
+     * @param type output type.
+     * @param index neuron index.
+     * @return sum of impact values.
+     */
+    [[nodiscard]] ValueType get_sum(synapse_traits::OutputType type, size_t index) const
+    {
+        return sums_[static_cast<size_t>(type) * range_size_ + index - range_start_];
+    }
+
+    /**
+     * @brief Get sum of impact values of all types.
+     * @param index neuron index.
+     * @return sum of impact values.
+     */
+    [[nodiscard]] ValueType get_total_sum(size_t index) const
+    {
+        ValueType result{0};
+        for (size_t type = 0; type < output_types_count; ++type)
+        {
+            result += sums_[type * range_size_ + index - range_start_];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Check if a neuron received an excitatory impact from a forcing message.
+     * @param index neuron index.
+     * @return `true` if the neuron is forced.
+     */
+    [[nodiscard]] bool is_forced(size_t index) const { return is_forced_[index - range_start_]; }
+
+    /**
+     * @brief Get impacts of the `BLOCKING` type.
+     * @return pairs of neuron index and impact value in the order of arrival.
+     */
+    [[nodiscard]] const std::vector<std::pair<size_t, float>> &get_blocking_impacts() const
+    {
+        return blocking_impacts_;
+    }
+
+    /**
+     * @brief Reset accumulated values.
+     * @details Only values of target neurons are reset.
+     */
+    void clear()
+    {
+        for (const auto index : targets_)
+        {
+            const size_t offset = index - range_start_;
+            for (size_t type = 0; type < output_types_count; ++type)
+            {
+                sums_[type * range_size_ + offset] = ValueType{0};
+            }
+            is_target_[offset] = false;
+            is_forced_[offset] = false;
+        }
+        targets_.clear();
+        blocking_impacts_.clear();
+    }
+
+private:
+    void start_range(size_t range_start, size_t range_end)
+    {
+        range_start_ = range_start;
+        range_size_ = range_end - range_start;
+        // Arrays only grow, so they are not reallocated for ranges of different sizes. Unused values are always zero.
+        if (is_target_.size() < range_size_)
+        {
+            sums_.resize(range_size_ * output_types_count, ValueType{0});
+            is_target_.resize(range_size_, false);
+            is_forced_.resize(range_size_, false);
+        }
+    }
+
+    void add(const core::messaging::SynapticImpact &impact, bool is_forcing)
+    {
+        const size_t index = impact.postsynaptic_neuron_index_;
+        const size_t offset = index - range_start_;
+        const auto type = impact.synapse_type_;
+        sums_[static_cast<size_t>(type) * range_size_ + offset] += impact.impact_value_;
+        is_forced_[offset] = is_forced_[offset] || (is_forcing && type == synapse_traits::OutputType::EXCITATORY);
+        if (type == synapse_traits::OutputType::BLOCKING) blocking_impacts_.emplace_back(index, impact.impact_value_);
+        if (is_target_[offset]) return;
+        is_target_[offset] = true;
+        targets_.push_back(index);
+    }
+
+    void collect_targets()
+    {
+        // Dense targets are collected by a scan, which is cheaper than sorting.
+        if (targets_.size() * dense_targets_ratio > range_size_)
+        {
+            targets_.clear();
+            for (size_t offset = 0; offset < range_size_; ++offset)
+            {
+                if (is_target_[offset]) targets_.push_back(range_start_ + offset);
+            }
+        }
+        else
+        {
+            std::sort(targets_.begin(), targets_.end());
+        }
+    }
+
+private:
+    // Targets are scanned instead of sorted if more than 1/dense_targets_ratio of neurons received impacts.
+    static constexpr size_t dense_targets_ratio = 16;
+
+    std::vector<ValueType> sums_;
+    std::vector<bool> is_target_;
+    std::vector<bool> is_forced_;
+    std::vector<size_t> targets_;
+    std::vector<std::pair<size_t, float>> blocking_impacts_;
+    size_t range_start_ = 0;
+    size_t range_size_ = 0;
+};
+
+
+/**
+ * @brief Split impacts of messages by parts of a population.
+ * @details Every part gets references to impacts on its neurons in the order of arrival. Impacts are scanned once and
+ * are not copied, so processing of all parts is linear in the number of impacts. Messages must not be changed while
+ * the references are used.
+ * @param messages synaptic impact messages sent to a population.
+ * @param neurons_count number of neurons in the population.
+ * @param part_size number of neurons in a part.
+ * @return references to impacts of every part.
+ */
+inline std::vector<std::vector<SynapticImpactReference>> split_impacts_by_part(
+    const std::vector<core::messaging::SynapticImpactMessage> &messages, size_t neurons_count, size_t part_size)
+{
+    const size_t parts_count = (neurons_count + part_size - 1) / part_size;
+    std::vector<std::vector<SynapticImpactReference>> result(parts_count);
+    for (const auto &message : messages)
+    {
+        for (const auto &impact : message.impacts_)
+        {
+            const size_t part = impact.postsynaptic_neuron_index_ / part_size;
+            if (part >= parts_count) continue;
+            result[part].push_back({&impact, message.is_forcing_});
+        }
+    }
+    return result;
+}
+
+
+/**
+ * @brief Get an accumulator that belongs to the current thread.
+ * @details The accumulator is reused for all populations calculated by the thread. It is empty between calls of input
+ * processing functions.
+ * @tparam ValueType type of accumulated sums.
+ * @return reference to the accumulator.
+ */
+template <class ValueType>
+SynapticImpactAccumulator<ValueType> &get_impact_accumulator()
+{
+    thread_local SynapticImpactAccumulator<ValueType> accumulator;
+    return accumulator;
+}
+
+}  // namespace knp::backends::cpu
@@ -0,0 +1,255 @@
+/**
+ * @file lazy_blifat_population_impl.h
+ * @brief Event-driven calculation of BLIFAT neuron populations with lazy decay of quiescent neurons.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/message_bus.h>
+#include <knp/core/population.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "blifat_population_impl.h"
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Call a function for each neuron with an index from the list.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam Function type of function that takes neuron parameters, static parameters and neuron index.
+ * @param population population of neurons.
+ * @param neuron_indexes indexes of neurons.
+ * @param func function to call.
+ */
+template <class BlifatLikeNeuron, class Function>
+void for_each_blifat_like_neuron(
+    knp::core::Population<BlifatLikeNeuron> &population, const std::vector<size_t> &neuron_indexes, Function func)
+{
+    if constexpr (has_shared_parameters<BlifatLikeNeuron>())
+    {
+        const auto params = population.get_shared_parameters();
+        for (const auto index : neuron_indexes) func(population[index], params, index);
+    }
+    else
+    {
+        for (const auto index : neuron_indexes) func(population[index], population[index], index);
+    }
+}
+
+
+/**
+ * @brief Check if a neuron state can be updated lazily.
+ * @details A quiescent neuron cannot spike without input: its potential and thresholds only decay, and the neuron is
+ * not bursting, blocked or stimulated stochastically. A neuron is not blocked if its total blocking period is positive:
+ * zero blocks the neuron forever and a negative value blocks it for the number of steps. The state of a quiescent
+ * neuron after any number of steps without input can be calculated in closed form.
+ * @tparam StateType type of neuron state.
+ * @tparam StaticParameters type of static neuron parameters.
+ * @param neuron neuron state.
+ * @param params static neuron parameters.
+ * @return `true` if the neuron is quiescent.
+ */
+template <class StateType, class StaticParameters>
+bool is_quiescent_blifat_like_neuron(const StateType &neuron, const StaticParameters &params)
+{
+    const auto is_decay = [](auto decay) { return decay >= 0 && decay <= 1; };
+    return neuron.bursting_phase_ == 0 && neuron.total_blocking_period_ > 0 && neuron.inhibitory_conductance_ == 0 &&
+           neuron.dynamic_threshold_ >= 0 && params.stochastic_stimulation_ == 0 &&
+           is_decay(params.potential_decay_) && is_decay(params.threshold_decay_) &&
+           std::max<decltype(neuron.potential_)>(neuron.potential_, 0) <
+               params.activation_threshold_ + neuron.additional_threshold_;
+}
+
+
+/**
+ * @brief Apply a number of steps without input to a quiescent neuron.
+ * @details The result is the same as the result of calculating the neuron `steps` times without input, except for the
+ * rounding errors of exponentiation.
+ * @tparam StateType type of neuron state.
+ * @tparam StaticParameters type of static neuron parameters.
+ * @param neuron neuron state.
+ * @param params static neuron parameters.
+ * @param steps number of skipped steps.
+ */
+template <class StateType, class StaticParameters>
+void skip_quiescent_steps(StateType &neuron, const StaticParameters &params, uint64_t steps)
+{
+    if (!steps) return;
+
+    const auto exponent = static_cast<double>(steps);
+    neuron.n_time_steps_since_last_firing_ += steps;
+    neuron.dynamic_threshold_ *= std::pow(params.threshold_decay_, exponent);
+    neuron.postsynaptic_trace_ *= std::pow(params.postsynaptic_trace_decay_, exponent);
+    neuron.potential_ *= std::pow(params.potential_decay_, exponent);
+    neuron.pre_impact_potential_ = neuron.potential_;
+    if (neuron.potential_ < params.min_potential_) neuron.potential_ = params.min_potential_;
+    if (neuron.total_blocking_period_ > 0)
+    {
+        const auto blocking_period = neuron.total_blocking_period_ - static_cast<int64_t>(steps);
+        neuron.total_blocking_period_ = std::max<int64_t>(blocking_period, 0);
+    }
+}
+
+
+/**
+ * @brief Bring all neurons of a lazily calculated population to the state before the given step.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam LazyDecayState type of lazy decay state. It must have `update_steps_`, `active_neurons_` and `is_active_`
+ * vectors.
+ * @param population population of neurons.
+ * @param state lazy decay state of the population.
+ * @param next_step first step that is not calculated yet.
+ */
+template <class BlifatLikeNeuron, class LazyDecayState>
+void synchronize_lazy_blifat_like_population(
+    knp::core::Population<BlifatLikeNeuron> &population, LazyDecayState &state, knp::core::Step next_step)
+{
+    if (state.update_steps_.size() != population.size()) return;
+
+    std::vector<size_t> all_neurons(population.size());
+    std::iota(all_neurons.begin(), all_neurons.end(), 0);
+    for_each_blifat_like_neuron(
+        population, all_neurons,
+        [&state, next_step](auto &neuron, const auto &params, size_t index)
+        {
+            if (state.update_steps_[index] >= next_step) return;
+            skip_quiescent_steps(neuron, params, next_step - state.update_steps_[index]);
+            state.update_steps_[index] = next_step;
+        });
+}
+
+
+/**
+ * @brief Calculate active neurons of a BLIFAT population and return spiked neuron indexes.
+ * @details Only neurons that are not quiescent or that receive synaptic impacts are calculated. Steps that a quiescent
+ * neuron missed are applied to it in closed form before the neuron is calculated.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam LazyDecayState type of lazy decay state. It must have `update_steps_`, `active_neurons_` and `is_active_`
+ * vectors.
+ * @param population population of neurons.
+ * @param state lazy decay state of the population.
+ * @param endpoint message endpoint.
+ * @param step_n execution step.
+ * @return indexes of spiked neurons.
+ */
+template <class BlifatLikeNeuron, class LazyDecayState>
+knp::core::messaging::SpikeData calculate_lazy_blifat_like_population_data(
+    knp::core::Population<BlifatLikeNeuron> &population, LazyDecayState &state, knp::core::MessageEndpoint &endpoint,
+    knp::core::Step step_n)
+{
+    SPDLOG_DEBUG("Calculating lazy BLIFAT population {}...", std::string{population.get_uid()});
+    std::vector<core::messaging::SynapticImpactMessage> messages =
+        endpoint.unload_messages<core::messaging::SynapticImpactMessage>(population.get_uid());
+
+    if (state.update_steps_.size() != population.size())
+    {
+        // All neurons are calculated on the first step, because their states are unknown.
+        state.update_steps_.assign(population.size(), step_n);
+        state.is_active_.assign(population.size(), true);
+        state.active_neurons_.resize(population.size());
+        std::iota(state.active_neurons_.begin(), state.active_neurons_.end(), 0);
+    }
+
+    // Neurons that receive impacts become active.
+    const size_t active_count = state.active_neurons_.size();
+    for (const auto &message : messages)
+    {
+        for (const auto &impact : message.impacts_)
+        {
+            const auto index = impact.postsynaptic_neuron_index_;
+            if (state.is_active_[index]) continue;
+            state.is_active_[index] = true;
+            state.active_neurons_.push_back(index);
+        }
+    }
+    // Neuron indexes in spike messages must be ordered in the same way as for the population calculated every step.
+    if (state.active_neurons_.size() != active_count)
+    {
+        std::sort(state.active_neurons_.begin(), state.active_neurons_.end());
+    }
+
+    for_each_blifat_like_neuron(
+        population, state.active_neurons_,
+        [&state, step_n](auto &neuron, const auto &params, size_t index)
+        {
+            skip_quiescent_steps(neuron, params, step_n - state.update_steps_[index]);
+            state.update_steps_[index] = step_n + 1;
+            ++neuron.n_time_steps_since_last_firing_;
+            calculate_single_neuron_state<BlifatLikeNeuron>(neuron, params);
+        });
+    process_inputs(population, messages);
+
+    knp::core::messaging::SpikeData neuron_indexes;
+    std::vector<size_t> still_active;
+    still_active.reserve(state.active_neurons_.size());
+    for_each_blifat_like_neuron(
+        population, state.active_neurons_,
+        [&state, &neuron_indexes, &still_active](auto &neuron, const auto &params, size_t index)
+        {
+            if (calculate_neuron_post_input_state<BlifatLikeNeuron>(neuron, params)) neuron_indexes.push_back(index);
+            if (is_quiescent_blifat_like_neuron(neuron, params))
+                state.is_active_[index] = false;
+            else
+                still_active.push_back(index);
+        });
+    state.active_neurons_ = std::move(still_active);
+
+    return neuron_indexes;
+}
+
+
+/**
+ * @brief Make one execution step for a lazily calculated population of BLIFAT neurons.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @tparam LazyDecayState type of lazy decay state.
+ * @param population population of neurons.
+ * @param state lazy decay state of the population.
+ * @param endpoint message endpoint used for message exchange.
+ * @param step_n execution step.
+ * @return spike message if any neuron spiked.
+ */
+template <class BlifatLikeNeuron, class LazyDecayState>
+std::optional<core::messaging::SpikeMessage> calculate_lazy_blifat_like_population_impl(
+    knp::core::Population<BlifatLikeNeuron> &population, LazyDecayState &state, knp::core::MessageEndpoint &endpoint,
+    knp::core::Step step_n)
+{
+    auto neuron_indexes{calculate_lazy_blifat_like_population_data(population, state, endpoint, step_n)};
+    if (neuron_indexes.empty()) return {};
+
+    knp::core::messaging::SpikeMessage res_message{{population.get_uid(), step_n}, neuron_indexes};
+    endpoint.send_message(res_message);
+    SPDLOG_DEBUG("Sent {} spike(s).", res_message.neuron_indexes_.size());
+    return res_message;
+}
+
+}  // namespace knp::backends::cpu
@@ -26,6 +26,8 @@
 #include <mutex>
 #include <vector>
 
+#include "impact_accumulator_impl.h"
+
 /**
  * @brief CPU backend namespace.
  */
@@ -33,32 +35,6 @@ namespace knp::backends::cpu
 {
 
 
-/**
- * @brief LIF neuron reaction to input types.
- * @tparam BasicLifNeuron LIF neuron type.
- * @param neuron the neuron receiving the impact.
- * @param synapse_type synapse type.
- * @param impact_value synaptic impact value.
- */
-template <class BasicLifNeuron>
-void impact_neuron(
-    knp::neuron_traits::neuron_parameters<BasicLifNeuron> &neuron, const knp::synapse_traits::OutputType &synapse_type,
-    float impact_value)
-{
-    switch (synapse_type)
-    {
-        case knp::synapse_traits::OutputType::EXCITATORY:
-            neuron.potential_ += impact_value;
-            break;
-        case knp::synapse_traits::OutputType::INHIBITORY_CURRENT:
-            neuron.potential_ -= impact_value;
-            break;
-        default:
-            break;
-    }
-}
-
-
 /**
  * @brief Calculate neuron state before it starts accepting inputs.
  * @tparam BasicLifNeuron LIF neuron type.
@@ -79,13 +55,17 @@ void process_inputs_lif(
     knp::core::Population<BasicLifNeuron> &population,
     const std::vector<knp::core::messaging::SynapticImpactMessage> &messages)
 {
-    for (const auto &msg : messages)
+    using OutputType = knp::synapse_traits::OutputType;
+    using ValueType = decltype(neuron_traits::neuron_parameters<BasicLifNeuron>::potential_);
+
+    auto &accumulator = get_impact_accumulator<ValueType>();
+    accumulator.accumulate(messages, population.size());
+    for (const auto index : accumulator.get_targets())
     {
-        for (const knp::core::messaging::SynapticImpact &impact : msg.impacts_)
-        {
-            impact_neuron(population[impact.postsynaptic_neuron_index_], impact.synapse_type_, impact.impact_value_);
-        }
+        population[index].potential_ += accumulator.get_sum(OutputType::EXCITATORY, index) -
+                                        accumulator.get_sum(OutputType::INHIBITORY_CURRENT, index);
     }
+    accumulator.clear();
 }
 
 
@@ -0,0 +1,192 @@
+/**
+ * @file step_arena_impl.h
+ * @brief Monotonic arenas for temporary data that lives during a single step.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief The StepArena class is a monotonic memory resource for temporary data of a single step.
+ * @details Memory is never freed before `reset`. After a reset the arena buffer grows to the largest amount of memory
+ * used in a step, so steps of the same size do not allocate memory from the system.
+ */
+class StepArena : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @brief Construct an empty arena.
+     */
+    StepArena() { resource_.emplace(std::pmr::new_delete_resource()); }
+
+    /**
+     * @brief Free all memory allocated from the arena.
+     * @note All containers that use the arena must be destroyed before the call.
+     */
+    void reset()
+    {
+        high_water_mark_ = std::max(high_water_mark_, used_bytes_);
+        // The buffer is grown only if the arena used memory outside it.
+        const bool is_buffer_exceeded = used_bytes_ > buffer_.size();
+        used_bytes_ = 0;
+        resource_.reset();
+        if (is_buffer_exceeded) buffer_.resize(high_water_mark_ + high_water_mark_ / buffer_reserve_ratio);
+        if (buffer_.empty())
+            resource_.emplace(std::pmr::new_delete_resource());
+        else
+            resource_.emplace(buffer_.data(), buffer_.size(), std::pmr::new_delete_resource());
+    }
+
+    /**
+     * @brief Get number of bytes allocated from the arena since the last reset.
+     * @return number of bytes.
+     */
+    [[nodiscard]] size_t get_used_bytes() const { return used_bytes_; }
+
+    /**
+     * @brief Get the largest number of bytes allocated from the arena between resets.
+     * @return number of bytes.
+     */
+    [[nodiscard]] size_t get_high_water_mark() const { return std::max(high_water_mark_, used_bytes_); }
+
+protected:
+    /**
+     * @brief Allocate memory.
+     * @param bytes number of bytes.
+     * @param alignment alignment of allocated memory.
+     * @return pointer to allocated memory.
+     */
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        // Alignment padding is counted, so the buffer grown to the high-water mark fits the step.
+        used_bytes_ += bytes + alignment - 1;
+        return resource_->allocate(bytes, alignment);
+    }
+
+    /**
+     * @brief Memory is freed on reset only.
+     */
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    /**
+     * @brief Compare memory resources.
+     * @param other another memory resource.
+     * @return `true` if the other resource is the same arena.
+     */
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    // The buffer gets 1/buffer_reserve_ratio more than the high-water mark.
+    static constexpr size_t buffer_reserve_ratio = 4;
+
+    std::vector<std::byte> buffer_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    size_t used_bytes_ = 0;
+    size_t high_water_mark_ = 0;
+};
+
+
+/**
+ * @brief The StepArenas class contains a step arena for every thread that calculates a step.
+ * @details A thread gets its own arena, so allocations from an arena do not lock. Arenas belong to a backend, so
+ * backends that run in the same threads do not reset arenas of each other.
+ */
+class StepArenas
+{
+public:
+    /**
+     * @brief Construct arenas with a unique identifier.
+     */
+    StepArenas() : id_(next_id_++) {}
+
+    /**
+     * @brief Get the arena of the current thread.
+     * @details A thread caches the last arena it got, so repeated calls for the same arenas do not lock.
+     * @return reference to the arena.
+     */
+    StepArena &get_local()
+    {
+        // Identifiers are not reused, so a cached arena of destroyed arenas is never returned.
+        thread_local struct
+        {
+            uint64_t arenas_id_ = 0;
+            StepArena *arena_ = nullptr;
+        } cache;
+        if (cache.arenas_id_ == id_) return *cache.arena_;
+
+        const std::lock_guard lock(mutex_);
+        auto &arena = arenas_[std::this_thread::get_id()];
+        if (!arena) arena = std::make_unique<StepArena>();
+        cache = {id_, arena.get()};
+        return *arena;
+    }
+
+    /**
+     * @brief Reset arenas of all threads.
+     * @note The method must be called at the end of a step, when no thread uses the arenas.
+     */
+    void reset()
+    {
+        const std::lock_guard lock(mutex_);
+        for (auto &[thread_id, arena] : arenas_) arena->reset();
+    }
+
+    /**
+     * @brief Get the sum of high-water marks of all thread arenas.
+     * @return number of bytes.
+     */
+    [[nodiscard]] size_t get_high_water_mark() const
+    {
+        const std::lock_guard lock(mutex_);
+        size_t result = 0;
+        for (const auto &[thread_id, arena] : arenas_) result += arena->get_high_water_mark();
+        return result;
+    }
+
+private:
+    // Identifier `0` marks an empty thread cache.
+    static inline std::atomic<uint64_t> next_id_ = 1;
+
+    const uint64_t id_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<StepArena>> arenas_;
+};
+
+}  // namespace knp::backends::cpu
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory_resource>
 #include <numeric>
 #include <unordered_map>
 #include <utility>
@@ -49,9 +50,12 @@ inline bool is_neuroplastic_population(const core::AllPopulationsVariant &popula
 {
     using PopulationType =
         knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<knp::neuron_traits::BLIFATNeuron>>;
+    using Float32PopulationType =
+        knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<knp::neuron_traits::Float32BLIFATNeuron>>;
     constexpr size_t expected_index = boost::mp11::mp_find<core::AllPopulations, PopulationType>();
+    constexpr size_t float32_expected_index = boost::mp11::mp_find<core::AllPopulations, Float32PopulationType>();
     const size_t index = population.index();
-    return index == expected_index;
+    return index == expected_index || index == float32_expected_index;
 }
 
 
@@ -128,10 +132,11 @@ std::vector<synapse_traits::synapse_parameters<SynapseType> *> get_all_connected
     std::vector<synapse_traits::synapse_parameters<SynapseType> *> result;
     for (auto *projection : projections_to_neuron)
     {
-        auto synapses = projection->find_synapses(neuron_index, core::Projection<SynapseType>::Search::by_postsynaptic);
-        std::transform(
-            synapses.begin(), synapses.end(), std::back_inserter(result),
-            [&projection](auto const &index) { return &std::get<core::synapse_data>((*projection)[index]); });
+        // Cached synapse lists are used, so only the result is allocated.
+        for (const auto index : projection->get_postsynaptic_synapses(neuron_index))
+        {
+            result.push_back(&std::get<core::synapse_data>((*projection)[index]));
+        }
     }
     return result;
 }
@@ -186,31 +191,38 @@ neuron_traits::ISIPeriodType update_isi(
 
 
 /**
- * @brief Apply STDP to all presynaptic connections of a single population.
+ * @brief Apply STDP to presynaptic connections of spiked neurons from the given index range.
+ * @details A neuron and its presynaptic connections are changed independently of other neurons, so disjoint ranges
+ * of the same population can be processed in parallel.
  * @tparam NeuronType type of neuron that is compatible with STDP.
  * @param msg spikes emited by population.
  * @param working_projections all projections (those that are not connected, locked or are of a wrong type are
  * skipped).
  * @param population population.
  * @param step current network step.
+ * @param part_start index of the first neuron to process.
+ * @param part_size number of neurons to process.
  * @note all projections are supposed to be of the same type.
  */
 template <class NeuronType>
-void process_spiking_neurons(
+void process_spiking_neurons_part(
     const core::messaging::SpikeMessage &msg,
-    std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
-    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step)
+    const std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step,
+    size_t part_start, size_t part_size)
 {
     using SynapseType = synapse_traits::STDP<synapse_traits::STDPSynapticResourceRule, synapse_traits::DeltaSynapse>;
+    const size_t part_end = std::min(part_start + part_size, population.size());
     // It's very important that during this function no projection invalidates iterators.
     // Loop over neurons.
     for (const auto &spiked_neuron_index : msg.neuron_indexes_)
     {
+        if (spiked_neuron_index < part_start || spiked_neuron_index >= part_end) continue;
         auto synapse_params = get_all_connected_synapses<SynapseType>(working_projections, spiked_neuron_index);
         auto &neuron = population[spiked_neuron_index];
         neuron.last_spike_step_ = step;
         // Calculate neuron ISI status.
-        update_isi<neuron_traits::BLIFATNeuron>(neuron, step);
+        update_isi<NeuronType>(neuron, step);
         if (neuron_traits::ISIPeriodType::period_started == neuron.isi_status_)
         {
             neuron.stability_ -= neuron.stability_change_at_isi_;
@@ -267,20 +279,44 @@ void process_spiking_neurons(
 
 
 /**
- * @brief If a neuron resource is greater than `1` or `-1` it should be distributed among all synapses.
+ * @brief Apply STDP to all presynaptic connections of a single population.
+ * @tparam NeuronType type of neuron that is compatible with STDP.
+ * @param msg spikes emited by population.
+ * @param working_projections all projections (those that are not connected, locked or are of a wrong type are
+ * skipped).
+ * @param population population.
+ * @param step current network step.
+ * @note all projections are supposed to be of the same type.
+ */
+template <class NeuronType>
+void process_spiking_neurons(
+    const core::messaging::SpikeMessage &msg,
+    std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step)
+{
+    process_spiking_neurons_part<NeuronType>(msg, working_projections, population, step, 0, population.size());
+}
+
+
+/**
+ * @brief Distribute free resource of neurons from the given index range among their synapses.
  * @tparam NeuronType type of base neuron (BLIFAT for SynapticResourceSTDPBlifat).
  * @param working_projections list of STDP projections (`DeltaSynapse` only is supported now).
  * @param population reference to population.
  * @param step current step.
+ * @param part_start index of the first neuron to process.
+ * @param part_size number of neurons to process.
  */
 template <class NeuronType>
-void renormalize_resource(
-    std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
-    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step)
+void renormalize_resource_part(
+    const std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step,
+    size_t part_start, size_t part_size)
 {
     using SynapseType =
         knp::synapse_traits::STDP<knp::synapse_traits::STDPSynapticResourceRule, synapse_traits::DeltaSynapse>;
-    for (size_t neuron_index = 0; neuron_index < population.size(); ++neuron_index)
+    const size_t part_end = std::min(part_start + part_size, population.size());
+    for (size_t neuron_index = part_start; neuron_index < part_end; ++neuron_index)
     {
         auto &neuron = population[neuron_index];
         if (step - neuron.last_step_ <= neuron.isi_max_ &&
@@ -312,15 +348,42 @@ void renormalize_resource(
 }
 
 
+/**
+ * @brief If a neuron resource is greater than `1` or `-1` it should be distributed among all synapses.
+ * @tparam NeuronType type of base neuron (BLIFAT for SynapticResourceSTDPBlifat).
+ * @param working_projections list of STDP projections (`DeltaSynapse` only is supported now).
+ * @param population reference to population.
+ * @param step current step.
+ */
 template <class NeuronType>
-void do_dopamine_plasticity(
+void renormalize_resource(
     std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
     knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step)
+{
+    renormalize_resource_part(working_projections, population, step, 0, population.size());
+}
+
+
+/**
+ * @brief Apply dopamine plasticity to neurons from the given index range and their synapses.
+ * @tparam NeuronType type of base neuron (BLIFAT for SynapticResourceSTDPBlifat).
+ * @param working_projections list of STDP projections (`DeltaSynapse` only is supported now).
+ * @param population reference to population.
+ * @param step current step.
+ * @param part_start index of the first neuron to process.
+ * @param part_size number of neurons to process.
+ */
+template <class NeuronType>
+void do_dopamine_plasticity_part(
+    const std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step,
+    size_t part_start, size_t part_size)
 {
     using SynapseType =
         knp::synapse_traits::STDP<knp::synapse_traits::STDPSynapticResourceRule, synapse_traits::DeltaSynapse>;
     using SynapseParamType = knp::synapse_traits::synapse_parameters<SynapseType>;
-    for (size_t neuron_index = 0; neuron_index < population.size(); ++neuron_index)
+    const size_t part_end = std::min(part_start + part_size, population.size());
+    for (size_t neuron_index = part_start; neuron_index < part_end; ++neuron_index)
     {
         auto &neuron = population[neuron_index];
         // Dopamine processing. Dopamine punishment if forced does nothing.
@@ -364,6 +427,15 @@ void do_dopamine_plasticity(
 }
 
 
+template <class NeuronType>
+void do_dopamine_plasticity(
+    std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population, uint64_t step)
+{
+    do_dopamine_plasticity_part(working_projections, population, step, 0, population.size());
+}
+
+
 template <class DeltaLikeSynapse>
 struct WeightUpdateSTDP<synapse_traits::STDP<synapse_traits::STDPSynapticResourceRule, DeltaLikeSynapse>>
 {
@@ -380,6 +452,8 @@ struct WeightUpdateSTDP<synapse_traits::STDP<synapse_traits::STDPSynapticResourc
     }
 
     static void modify_weights(const knp::core::Projection<Synapse> &projection) {}
+
+    static void finish_step(const knp::core::Projection<Synapse> &projection, uint64_t step) {}
 };
 
 
@@ -389,7 +463,7 @@ struct WeightUpdateStdpMp
     using Synapse = DeltaLikeSynapse;
     static void init_projection_part(
         const knp::core::Projection<Synapse> &projection,
-        const std::unordered_map<knp::core::Step, size_t> &message_data, uint64_t step)
+        const std::pmr::unordered_map<knp::core::Step, size_t> &message_data, uint64_t step)
     {
     }
 
@@ -405,7 +479,7 @@ struct WeightUpdateStdpMp<synapse_traits::STDP<synapse_traits::STDPSynapticResou
     using Synapse = synapse_traits::STDP<synapse_traits::STDPSynapticResourceRule, DeltaLikeSynapse>;
     static void init_projection_part(
         const knp::core::Projection<Synapse> &projection,
-        const std::unordered_map<knp::core::Step, size_t> &message_data, uint64_t step)
+        const std::pmr::unordered_map<knp::core::Step, size_t> &message_data, uint64_t step)
     {
     }
 
@@ -428,7 +502,7 @@ void do_STDP_resource_plasticity(
     // 1. If neurons generated spikes, process these neurons.
     if (message.has_value())
     {
-        knp::backends::cpu::process_spiking_neurons<neuron_traits::BLIFATNeuron>(
+        knp::backends::cpu::process_spiking_neurons<NeuronType>(
             message.value(), working_projections, population, step);
     }
 
@@ -440,4 +514,29 @@ void do_STDP_resource_plasticity(
 }
 
 
+/**
+ * @brief Apply synaptic resource STDP to neurons from the given index range and their presynaptic connections.
+ * @details Learning phases of a neuron change only the neuron and the synapses leading to it. The result of
+ * processing all parts of a population is the same as the result of `do_STDP_resource_plasticity`.
+ * @note Postsynaptic synapse lists of working projections must be up to date before parts are processed in parallel.
+ * @tparam NeuronType type of base neuron.
+ * @param population population of neurons.
+ * @param working_projections unlocked STDP projections connected to the population.
+ * @param message spikes emitted by the population at the current step.
+ * @param step current step.
+ * @param part_start index of the first neuron to process.
+ * @param part_size number of neurons to process.
+ */
+template <class NeuronType>
+void do_STDP_resource_plasticity_part(
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<NeuronType>> &population,
+    const std::vector<StdpProjection<synapse_traits::DeltaSynapse> *> &working_projections,
+    const core::messaging::SpikeMessage &message, uint64_t step, size_t part_start, size_t part_size)
+{
+    process_spiking_neurons_part<NeuronType>(message, working_projections, population, step, part_start, part_size);
+    do_dopamine_plasticity_part(working_projections, population, step, part_start, part_size);
+    renormalize_resource_part(working_projections, population, step, part_start, part_size);
+}
+
+
 }  // namespace knp::backends::cpu
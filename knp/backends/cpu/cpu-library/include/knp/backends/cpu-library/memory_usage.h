@@ -0,0 +1,72 @@
+/**
+ * @file memory_usage.h
+ * @brief Memory usage estimation of CPU backend networks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/memory_usage.h>
+
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Get memory used by populations and projections of a CPU backend.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container. Its elements must have the `arg_` projection variant and
+ * the `messages_` synaptic message queue.
+ * @param populations populations loaded to the backend.
+ * @param projections projections loaded to the backend.
+ * @return estimated memory usage of the network.
+ */
+template <class PopulationContainer, class ProjectionContainer>
+core::MemoryUsage get_network_memory_usage(
+    const PopulationContainer &populations, const ProjectionContainer &projections)
+{
+    auto result = core::get_entities_memory_usage(populations, [](const auto &pop) -> const auto & { return pop; });
+    result += core::get_entities_memory_usage(projections, [](const auto &proj) -> const auto & { return proj.arg_; });
+    for (const auto &wrapper : projections) result.queues_ += core::get_messages_memory_usage(wrapper.messages_);
+    return result;
+}
+
+
+/**
+ * @brief Estimate memory used by populations and projections of a CPU backend before loading.
+ * @details Message queues are filled during execution, so they are not included.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations estimated memory usage of every population.
+ * @param projections estimated memory usage of every projection.
+ * @return estimated memory usage of the network in the backend.
+ */
+template <class PopulationContainer, class ProjectionContainer>
+core::MemoryUsage estimate_network_memory_usage(
+    const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections)
+{
+    return core::estimate_entities_memory_usage<typename PopulationContainer::value_type>(populations) +
+           core::estimate_entities_memory_usage<typename ProjectionContainer::value_type>(projections);
+}
+
+}  // namespace knp::backends::cpu
@@ -23,20 +23,27 @@
 #include <knp/backends/cpu-library/delta_synapse_projection.h>
 #include <knp/backends/cpu-library/impl/altai_lif_population_impl.h>
 #include <knp/backends/cpu-library/impl/blifat_population_impl.h>
+#include <knp/backends/cpu-library/impl/step_arena_impl.h>
 #include <knp/backends/cpu-library/impl/synaptic_resource_stdp_impl.h>
 #include <knp/backends/cpu-library/init.h>
 #include <knp/backends/cpu-multi-threaded/backend.h>
 #include <knp/backends/thread_pool/thread_pool.h>
 #include <knp/devices/cpu.h>
+#include <knp/devices/cpu_topology.h>
 #include <knp/meta/assert_helpers.h>
 #include <knp/meta/stringify.h>
 #include <knp/meta/variant_helpers.h>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <functional>
+#include <memory_resource>
 #include <optional>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/mp11.hpp>
@@ -46,16 +53,71 @@
 
 namespace knp::backends::multi_threaded_cpu
 {
+namespace
+{
+
+// Topology is read once, processors do not change while the process runs.
+const knp::devices::cpu::CpuTopology &get_system_topology()
+{
+    static const auto topology = knp::devices::cpu::get_cpu_topology();
+    return topology;
+}
+
+
+// Get the number of pool threads: one thread per physical core, as SMT siblings share caches and execution units.
+size_t get_default_thread_count(size_t thread_count)
+{
+    if (thread_count) return thread_count;
+    const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t cores_count = get_system_topology().cores_.size();
+    return cores_count ? std::min(cores_count, hardware_threads) : hardware_threads;
+}
+
+
+// Get the number of elements in a part, so that data of a part fits into half of the L2 cache of a core.
+size_t get_cache_part_size(size_t element_bytes, size_t default_part_size)
+{
+    // Parts smaller than this make task overhead larger than calculation.
+    constexpr size_t min_part_size = 64;
+    const auto l2_cache_bytes = static_cast<size_t>(get_system_topology().l2_cache_bytes_);
+    if (!l2_cache_bytes) return default_part_size;
+    return std::max(l2_cache_bytes / 2 / element_bytes, min_part_size);
+}
+
+}  // namespace
+
+
 MultiThreadedCPUBackend::MultiThreadedCPUBackend(
     size_t thread_count, size_t population_part_size, size_t projection_part_size)
-    : population_part_size_(population_part_size),
-      projection_part_size_(projection_part_size),
-      calc_pool_(std::make_unique<cpu_executors::ThreadPool>(
-          thread_count ? thread_count : std::thread::hardware_concurrency()))
+    : population_part_size_(population_part_size ? population_part_size : default_population_part_size),
+      projection_part_size_(projection_part_size ? projection_part_size : default_projection_part_size),
+      thread_count_(get_default_thread_count(thread_count)),
+      calc_pool_(std::make_unique<cpu_executors::ThreadPool>(thread_count_)),
+      step_arenas_(std::make_unique<cpu::StepArenas>())
 {
     SPDLOG_INFO(
-        "Multi-threaded CPU backend instance created, thread count = {}.",
-        thread_count ? thread_count : std::thread::hardware_concurrency());
+        "Multi-threaded CPU backend instance created, thread count = {}, population part size = {}, projection part "
+        "size = {}.",
+        thread_count_, population_part_size_, projection_part_size_);
+}
+
+
+MultiThreadedCPUBackend::~MultiThreadedCPUBackend() = default;
+
+
+size_t MultiThreadedCPUBackend::get_cache_population_part_size()
+{
+    return get_cache_part_size(
+        sizeof(neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>), default_population_part_size);
+}
+
+
+size_t MultiThreadedCPUBackend::get_cache_projection_part_size()
+{
+    // A synapse part reads synapse parameters and both neuron indexes of the synapses.
+    return get_cache_part_size(
+        sizeof(synapse_traits::synapse_parameters<synapse_traits::DeltaSynapse>) + 2 * sizeof(uint32_t),
+        default_projection_part_size);
 }
 
 
@@ -80,34 +142,35 @@ std::vector<std::string> MultiThreadedCPUBackend::get_supported_synapses() const
 }
 
 
+// Get a projection variant stored in a projection wrapper.
+constexpr auto get_projection_variant = [](auto &wrapper) -> auto & { return wrapper.arg_; };
+
+
+// Move parameters of a loaded population or projection to storage allocated according to a policy. Entities are moved
+// one by one while they are loaded, so that the whole network is not copied to memory allocated by `operator new`.
+template <class Variant>
+void set_loaded_storage_policy(Variant &variant, const std::shared_ptr<const core::StoragePolicy> &policy)
+{
+    if (policy) std::visit([&policy](auto &entity) { entity.set_storage_policy(policy); }, variant);
+}
+
+
 void MultiThreadedCPUBackend::calculate_populations_pre_impact()
 {
-    for (auto &population : populations_)
-    {
-        auto pop_size = std::visit([](auto &pop) { return pop.size(); }, population);
-        for (size_t neuron_index = 0; neuron_index < pop_size; neuron_index += population_part_size_)
+    population_types_.for_each(
+        populations_,
+        [this](auto &pop, size_t pop_index)
         {
-            std::visit(
-                [this, neuron_index](auto &pop)
-                {
-                    // Check if population is supported by backend. We don't need to repeat it.
-                    using T = std::decay_t<decltype(pop)>;
-                    if constexpr (
-                        boost::mp11::mp_find<SupportedPopulations, T>{} == boost::mp11::mp_size<SupportedPopulations>{})
-                    {
-                        static_assert(
-                            knp::meta::always_false_v<T>,
-                            "Population is not supported by the multi-threaded CPU backend.");
-                    }
-
-                    // Start threads.
-                    calc_pool_->post(
-                        knp::backends::cpu::calculate_neurons_state_part<typename T::PopulationNeuronType>,
-                        std::ref(pop), neuron_index, population_part_size_);
-                },
-                population);
-        }
-    }
+            using T = std::decay_t<decltype(pop)>;
+            // Start threads.
+            for (size_t neuron_index = 0; neuron_index < pop.size(); neuron_index += population_part_size_)
+            {
+                calc_pool_->post_on_node(
+                    get_population_node(pop_index, neuron_index),
+                    knp::backends::cpu::calculate_neurons_state_part<typename T::PopulationNeuronType>,
+                    std::ref(pop), neuron_index, population_part_size_);
+            }
+        });
     // Wait for all threads to finish their work.
     calc_pool_->join();
 }
@@ -115,73 +178,126 @@ void MultiThreadedCPUBackend::calculate_populations_pre_impact()
 
 void MultiThreadedCPUBackend::calculate_populations_impact()
 {
-    for (auto &population : populations_)
-    {
-        auto uid = std::visit([](auto &population) { return population.get_uid(); }, population);
-        auto messages = get_message_endpoint().unload_messages<knp::core::messaging::SynapticImpactMessage>(uid);
-        std::visit(
-            [this, &messages](auto &pop)
+    // Messages of large populations are shared by all tasks, so they must live until all tasks are finished.
+    std::vector<std::pair<
+        std::vector<knp::core::messaging::SynapticImpactMessage>,
+        std::vector<std::vector<knp::backends::cpu::SynapticImpactReference>>>>
+        shared_impacts;
+    shared_impacts.reserve(populations_.size());
+
+    population_types_.for_each(
+        populations_,
+        [this, &shared_impacts](auto &pop, size_t pop_index)
+        {
+            using T = std::decay_t<decltype(pop)>;
+            auto messages =
+                get_message_endpoint().unload_messages<knp::core::messaging::SynapticImpactMessage>(
+                    population_handles_[pop_index]);
+            if (messages.empty()) return;
+            if (pop.size() <= population_part_size_)
             {
-                using T = std::decay_t<decltype(pop)>;
-                calc_pool_->post(
+                calc_pool_->post_on_node(
+                    get_population_node(pop_index, 0),
                     knp::backends::cpu::process_inputs<typename T::PopulationNeuronType>, std::ref(pop),
                     std::move(messages));
-            },
-            population);
-    }
+                return;
+            }
+
+            // Large population: every task updates its own range of neurons and gets only impacts on that range.
+            auto &[part_messages, part_impacts] = shared_impacts.emplace_back();
+            part_messages = std::move(messages);
+            part_impacts = knp::backends::cpu::split_impacts_by_part(part_messages, pop.size(), population_part_size_);
+            for (size_t part = 0; part < part_impacts.size(); ++part)
+            {
+                if (part_impacts[part].empty()) continue;
+                calc_pool_->post_on_node(
+                    get_population_node(pop_index, part * population_part_size_),
+                    knp::backends::cpu::process_inputs_part<typename T::PopulationNeuronType>, std::ref(pop),
+                    std::cref(part_impacts[part]), part * population_part_size_, population_part_size_);
+            }
+        });
     calc_pool_->join();
 }
 
 
 std::vector<knp::core::messaging::SpikeMessage> MultiThreadedCPUBackend::calculate_populations_post_impact()
 {
+    // Messages are stored in the population order, so they are sent in the same order as before partitioning.
     std::vector<knp::core::messaging::SpikeMessage> spike_container(populations_.size());
-    for (size_t pop_index = 0; pop_index < populations_.size(); ++pop_index)
-    {
-        auto &population = populations_[pop_index];
-        auto &message = spike_container[pop_index];
-        message.header_.send_time_ = get_step();
-        message.header_.sender_uid_ = std::visit([](auto &population) { return population.get_uid(); }, population);
-
-        const size_t population_size = std::visit([](auto &population) { return population.size(); }, population);
-        for (size_t neuron_index = 0; neuron_index < population_size; neuron_index += population_part_size_)
-        {
-            std::visit(
-                [this, &message, neuron_index](auto &pop)
-                {
-                    using T = std::decay_t<decltype(pop)>;
 #if defined(_MSC_VER)
 #    pragma warning(push)
 #    pragma warning(disable : 4267)
 #endif
-                    calc_pool_->post(
-                        knp::backends::cpu::calculate_neurons_post_input_state_part<typename T::PopulationNeuronType>,
-                        std::ref(pop), std::ref(message), neuron_index, population_part_size_, std::ref(ep_mutex_));
-                },
-                population);
-        }
-    }
+    population_types_.for_each(
+        populations_,
+        [this, &spike_container](auto &pop, size_t pop_index)
+        {
+            using T = std::decay_t<decltype(pop)>;
+            auto &message = spike_container[pop_index];
+            message.header_.send_time_ = get_step();
+            message.header_.sender_uid_ = pop.get_uid();
+            auto calculate_part = [this](T &pop_ref, knp::core::messaging::SpikeMessage &message_ref, size_t start)
+            {
+                // The arena is taken in the pool thread, so every thread allocates from its own arena.
+                knp::backends::cpu::calculate_neurons_post_input_state_part<typename T::PopulationNeuronType>(
+                    pop_ref, message_ref, start, population_part_size_, ep_mutex_, &step_arenas_->get_local());
+            };
+            for (size_t neuron_index = 0; neuron_index < pop.size(); neuron_index += population_part_size_)
+            {
+                calc_pool_->post_on_node(
+                    get_population_node(pop_index, neuron_index), calculate_part, std::ref(pop), std::ref(message),
+                    neuron_index);
+            }
+        });
     calc_pool_->join();
-    for (size_t pop_id = 0; pop_id < populations_.size(); ++pop_id)
-    {
-        auto &message = spike_container[pop_id];
-        std::visit(
-            [this, &message](auto &pop)
+
+    // Projections of large plastic populations are shared between threads until the pool is joined.
+    using ResourceSTDPProjection = core::Projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>;
+    std::vector<std::vector<ResourceSTDPProjection *>> shared_projections;
+    shared_projections.reserve(populations_.size());
+    population_types_.for_each(
+        populations_,
+        [this, &spike_container, &shared_projections](auto &pop, size_t pop_index)
+        {
+            using T = std::decay_t<decltype(pop)>;
+            auto &message = spike_container[pop_index];
+            if constexpr (std::is_same_v<T, core::Population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>>)
             {
-                using T = std::decay_t<decltype(pop)>;
-                auto call_finalize = [](T &pop_ref, knp::core::messaging::SpikeMessage &message_ref,
-                                        ProjectionContainer &proj_ref, knp::core::Step step)
+                if (pop.size() > population_part_size_)
                 {
-                    knp::backends::cpu::finalize_population<typename T::PopulationNeuronType, ProjectionContainer>(
-                        pop_ref, message_ref, proj_ref, step);
-                };
-                calc_pool_->post(call_finalize, std::ref(pop), std::ref(message), std::ref(projections_), get_step());
-            },
-            populations_[pop_id]);
+                    // Learning is partitioned by postsynaptic neuron: a part changes only its neurons and the
+                    // synapses leading to them.
+                    const auto &working_projections = shared_projections.emplace_back(
+                        knp::backends::cpu::find_resource_stdp_projections(projections_, pop.get_uid()));
+                    // Synapse lists are built lazily, so they are built here before parallel searches.
+                    for (const auto *projection : working_projections)
+                    {
+                        std::ignore = projection->get_postsynaptic_synapses(0);
+                    }
+                    for (size_t neuron_index = 0; neuron_index < pop.size(); neuron_index += population_part_size_)
+                    {
+                        calc_pool_->post_on_node(
+                            get_population_node(pop_index, neuron_index),
+                            knp::backends::cpu::do_STDP_resource_plasticity_part<knp::neuron_traits::BLIFATNeuron>,
+                            std::ref(pop), std::cref(working_projections), std::cref(message), get_step(),
+                            neuron_index, population_part_size_);
+                    }
+                    return;
+                }
+            }
+            auto call_finalize = [](T &pop_ref, knp::core::messaging::SpikeMessage &message_ref,
+                                    ProjectionContainer &proj_ref, knp::core::Step step)
+            {
+                knp::backends::cpu::finalize_population<typename T::PopulationNeuronType, ProjectionContainer>(
+                    pop_ref, message_ref, proj_ref, step);
+            };
+            calc_pool_->post_on_node(
+                get_population_node(pop_index, 0), call_finalize, std::ref(pop), std::ref(message),
+                std::ref(projections_), get_step());
+        });
 #if defined(_MSC_VER)
 #    pragma warning(pop)
 #endif
-    }
     calc_pool_->join();
     return spike_container;
 }
@@ -223,36 +339,39 @@ void send_message(ProjectionWrapper &projection, core::MessageEndpoint &endpoint
 void MultiThreadedCPUBackend::calculate_projections()
 {
     SPDLOG_DEBUG("Calculating projections...");
-    std::vector<std::unordered_map<uint64_t, size_t>> converted_message_buffer;
+    // Converted messages live until the pool is joined, so they are allocated from the arena of this thread.
+    auto &arena = step_arenas_->get_local();
+    std::pmr::vector<cpu::SpikeCounts> converted_message_buffer(&arena);
     converted_message_buffer.reserve(projections_.size());
 
-    for (auto &projection : projections_)
-    {
-        auto uid = std::visit([](auto &proj) { return proj.get_uid(); }, projection.arg_);
-        auto msg_buf = get_message_endpoint().unload_messages<knp::core::messaging::SpikeMessage>(uid);
-        // We might want to add some preliminary function before, even if delta projection doesn't require it.
-        if (msg_buf.empty())
-        {
-            continue;
-        }
-
-        // Looping over synapses.
-        converted_message_buffer.emplace_back(cpu::convert_spikes(msg_buf[0]));
-        const auto proj_size = std::visit([](const auto &proj) { return proj.size(); }, projection.arg_);
-        for (size_t synapse_index = 0; synapse_index < proj_size; synapse_index += projection_part_size_)
+    projection_types_.for_each(
+        projections_, get_projection_variant,
+        [this, &arena, &converted_message_buffer](auto &proj, size_t index)
         {
-            std::visit(
-                [this, synapse_index, &converted_message_buffer, &projection](auto &proj)
-                {
-                    using T = std::decay_t<decltype(proj)>;
-                    calc_pool_->post(
-                        knp::backends::cpu::calculate_projection_part<typename T::ProjectionSynapseType>,
-                        std::ref(proj), std::ref(converted_message_buffer.back()), std::ref(projection.messages_),
-                        get_step(), synapse_index, projection_part_size_, std::ref(ep_mutex_));
-                },
-                projection.arg_);
-        }
-    }
+            using T = std::decay_t<decltype(proj)>;
+            auto msg_buf =
+                get_message_endpoint().unload_messages<knp::core::messaging::SpikeMessage>(projection_handles_[index]);
+            // We might want to add some preliminary function before, even if delta projection doesn't require it.
+            if (msg_buf.empty()) return;
+
+            // Looping over synapses.
+            auto &converted_messages = converted_message_buffer.emplace_back(cpu::convert_spikes(msg_buf[0], &arena));
+            auto calculate_part = [this](
+                                      T &proj_ref, const cpu::SpikeCounts &spikes, cpu::MessageQueue &future_messages,
+                                      uint64_t step, size_t start)
+            {
+                knp::backends::cpu::calculate_projection_part<typename T::ProjectionSynapseType>(
+                    proj_ref, spikes, future_messages, step, start, projection_part_size_, ep_mutex_,
+                    &step_arenas_->get_local());
+            };
+            for (size_t synapse_index = 0; synapse_index < proj.size(); synapse_index += projection_part_size_)
+            {
+                calc_pool_->post_on_node(
+                    get_projection_node(index, synapse_index), calculate_part, std::ref(proj),
+                    std::cref(converted_messages),
+                    std::ref(projections_[index].messages_), get_step(), synapse_index);
+            }
+        });
     calc_pool_->join();
     // Sending messages. It might be possible to parallelize this as well if we use more than one endpoint.
     for (auto &projection : projections_)
@@ -268,6 +387,12 @@ void MultiThreadedCPUBackend::calculate_projections()
 }
 
 
+size_t MultiThreadedCPUBackend::get_step_arena_high_water_mark() const
+{
+    return step_arenas_->get_high_water_mark();
+}
+
+
 std::vector<size_t> MultiThreadedCPUBackend::get_supported_projection_indexes() const
 {
     return knp::meta::get_supported_type_indexes<core::AllProjections, SupportedProjections>();
@@ -289,6 +414,8 @@ void MultiThreadedCPUBackend::_step()
     calculate_projections();
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
+    // Temporary data of the step is not used anymore.
+    step_arenas_->reset();
     auto step = gad_step();
     // Need to suppress "Unused variable" warning.
     (void)step;
@@ -302,10 +429,15 @@ void MultiThreadedCPUBackend::load_populations(const std::vector<PopulationVaria
     populations_.clear();
     populations_.reserve(populations.size());
 
+    // Home nodes of NUMA-aware storage are assigned after all entities are loaded.
+    const auto loaded_policy = is_numa_aware() ? nullptr : storage_policy_;
     for (const auto &population : populations)
     {
-        populations_.push_back(population);
+        set_loaded_storage_policy(populations_.emplace_back(population), loaded_policy);
     }
+    population_types_.build(populations_);
+    update_receiver_handles();
+    apply_population_storage_policy();
     SPDLOG_DEBUG("All populations loaded.");
 }
 
@@ -316,10 +448,15 @@ void MultiThreadedCPUBackend::load_projections(const std::vector<ProjectionVaria
     projections_.clear();
     projections_.reserve(projections.size());
 
+    // Home nodes of NUMA-aware storage are assigned after all entities are loaded.
+    const auto loaded_policy = is_numa_aware() ? nullptr : storage_policy_;
     for (const auto &projection : projections)
     {
-        projections_.push_back(ProjectionWrapper{projection});
+        set_loaded_storage_policy(projections_.emplace_back(ProjectionWrapper{projection}).arg_, loaded_policy);
     }
+    projection_types_.build(projections_, get_projection_variant);
+    update_receiver_handles();
+    apply_projection_storage_policy();
 
     SPDLOG_DEBUG("All projections loaded.");
 }
@@ -328,7 +465,14 @@ void MultiThreadedCPUBackend::load_projections(const std::vector<ProjectionVaria
 void MultiThreadedCPUBackend::load_all_projections(const std::vector<knp::core::AllProjectionsVariant> &projections)
 {
     SPDLOG_DEBUG("Loading projections [{}]...", projections.size());
-    knp::meta::load_from_container<SupportedProjections>(projections, projections_);
+    // Home nodes of NUMA-aware storage are assigned after all entities are loaded.
+    const auto loaded_policy = is_numa_aware() ? nullptr : storage_policy_;
+    knp::meta::load_from_container<SupportedProjections>(
+        projections, projections_,
+        [&loaded_policy](auto &wrapper) { set_loaded_storage_policy(wrapper.arg_, loaded_policy); });
+    projection_types_.build(projections_, get_projection_variant);
+    update_receiver_handles();
+    apply_projection_storage_policy();
     SPDLOG_DEBUG("All projections loaded.");
 }
 
@@ -336,11 +480,229 @@ void MultiThreadedCPUBackend::load_all_projections(const std::vector<knp::core::
 void MultiThreadedCPUBackend::load_all_populations(const std::vector<knp::core::AllPopulationsVariant> &populations)
 {
     SPDLOG_DEBUG("Loading populations [{}]...", populations.size());
-    knp::meta::load_from_container<SupportedPopulations>(populations, populations_);
+    // Home nodes of NUMA-aware storage are assigned after all entities are loaded.
+    const auto loaded_policy = is_numa_aware() ? nullptr : storage_policy_;
+    knp::meta::load_from_container<SupportedPopulations>(
+        populations, populations_,
+        [&loaded_policy](auto &population) { set_loaded_storage_policy(population, loaded_policy); });
+    population_types_.build(populations_);
+    update_receiver_handles();
+    apply_population_storage_policy();
     SPDLOG_DEBUG("All populations loaded.");
 }
 
 
+void MultiThreadedCPUBackend::update_receiver_handles()
+{
+    auto &endpoint = get_message_endpoint();
+    population_handles_.clear();
+    population_handles_.reserve(populations_.size());
+    for (const auto &population : populations_)
+    {
+        population_handles_.push_back(
+            endpoint.get_receiver_handle(std::visit([](const auto &pop) { return pop.get_uid(); }, population)));
+    }
+
+    projection_handles_.clear();
+    projection_handles_.reserve(projections_.size());
+    for (const auto &projection : projections_)
+    {
+        projection_handles_.push_back(
+            endpoint.get_receiver_handle(std::visit([](const auto &proj) { return proj.get_uid(); }, projection.arg_)));
+    }
+}
+
+
+void MultiThreadedCPUBackend::set_storage_policy(const core::StoragePolicy &policy)
+{
+    storage_policy_ = std::make_shared<const core::StoragePolicy>(policy);
+    apply_population_storage_policy();
+    apply_projection_storage_policy();
+}
+
+
+void MultiThreadedCPUBackend::set_numa_aware(bool numa_aware)
+{
+    if (numa_aware == is_numa_aware()) return;
+    std::vector<cpu_executors::NumaNode> nodes;
+    if (numa_aware)
+    {
+        // Nodes that have only memory get no workers.
+        for (auto &node : knp::devices::cpu::get_cpu_topology().nodes_)
+        {
+            if (!node.cpus_.empty()) nodes.push_back({node.id_, std::move(node.cpus_)});
+        }
+    }
+    if (numa_aware && nodes.empty())
+    {
+        SPDLOG_WARN("NUMA topology is unknown, topology-aware scheduling is not enabled.");
+        return;
+    }
+    // The old pool joins its workers before the new one is created.
+    calc_pool_.reset();
+    if (nodes.empty())
+    {
+        calc_pool_ = std::make_unique<cpu_executors::ThreadPool>(thread_count_);
+    }
+    else
+    {
+        calc_pool_ = std::make_unique<cpu_executors::ThreadPool>(thread_count_, nodes);
+    }
+    // Arenas are kept per thread, so arenas of the old workers are freed with them.
+    step_arenas_ = std::make_unique<cpu::StepArenas>();
+    numa_nodes_ = std::move(nodes);
+    SPDLOG_INFO("Topology-aware scheduling is {}, NUMA nodes = {}.", numa_aware ? "on" : "off", numa_nodes_.size());
+    apply_population_storage_policy();
+    apply_projection_storage_policy();
+}
+
+
+namespace
+{
+
+// Assign home nodes to part ranges of entities, balancing the number of elements between nodes. A part range is the
+// range of elements calculated by a single task.
+template <class Container, class Partition, class GetVariant>
+void assign_home_nodes(
+    Container &container, Partition &partition, GetVariant get_variant, size_t part_size, size_t nodes_count,
+    std::vector<std::vector<size_t>> &homes)
+{
+    std::vector<size_t> node_loads(std::max<size_t>(nodes_count, 1), 0);
+    homes.assign(container.size(), {});
+    partition.for_each(
+        container, get_variant,
+        [part_size, &node_loads, &homes](const auto &entity, size_t index)
+        {
+            // An empty entity gets a node too, as tasks of the whole entity are posted to the node of its first part.
+            const size_t parts_count = std::max<size_t>((entity.size() + part_size - 1) / part_size, 1);
+            homes[index].resize(parts_count);
+            for (size_t part = 0; part < parts_count; ++part)
+            {
+                const auto node_iter = std::min_element(node_loads.begin(), node_loads.end());
+                *node_iter += std::min(part_size, entity.size() - std::min(entity.size(), part * part_size));
+                homes[index][part] = static_cast<size_t>(node_iter - node_loads.begin());
+            }
+        });
+}
+
+
+// Bind pages of each part range of an array to the home node of the part.
+template <class ValueType>
+void bind_parts_to_nodes(
+    const ValueType *values, size_t size, size_t part_size, const std::vector<size_t> &part_nodes,
+    const std::vector<cpu_executors::NumaNode> &numa_nodes, const knp::core::StoragePolicy *policy)
+{
+    for (size_t part = 0; part < part_nodes.size() && part * part_size < size; ++part)
+    {
+        const size_t part_length = std::min(part_size, size - part * part_size);
+        knp::core::bind_storage_to_node(
+            values + part * part_size, part_length * sizeof(ValueType), numa_nodes[part_nodes[part]].id_, policy);
+    }
+}
+
+}  // namespace
+
+
+std::vector<std::shared_ptr<const core::StoragePolicy>> MultiThreadedCPUBackend::get_node_storage_policies() const
+{
+    // Large arrays are bound to the home node of their first part, smaller ones are placed there by the first touch of
+    // a home worker.
+    std::vector<std::shared_ptr<const core::StoragePolicy>> result;
+    result.reserve(numa_nodes_.size());
+    for (const auto &node : numa_nodes_)
+    {
+        auto policy = storage_policy_ ? *storage_policy_ : core::StoragePolicy{};
+        policy.numa_placement_ = core::StorageNumaPlacement::preferred_node;
+        policy.numa_node_ = node.id_;
+        result.push_back(std::make_shared<const core::StoragePolicy>(std::move(policy)));
+    }
+    return result;
+}
+
+
+void MultiThreadedCPUBackend::apply_population_storage_policy()
+{
+    // Populations and projections are calculated in different phases, so they are balanced separately.
+    assign_home_nodes(
+        populations_, population_types_, [](auto &variant) -> auto & { return variant; }, population_part_size_,
+        numa_nodes_.size(), population_nodes_);
+    if (!is_numa_aware())
+    {
+        if (!storage_policy_) return;
+        population_types_.for_each(
+            populations_, [this](auto &population, size_t) { population.set_storage_policy(storage_policy_); });
+        return;
+    }
+
+    const auto node_policies = get_node_storage_policies();
+    population_types_.for_each(
+        populations_,
+        [this, &node_policies](auto &population, size_t index)
+        {
+            const size_t node = get_population_node(index, 0);
+            calc_pool_->post_on_node(
+                node, [](auto &entity, const auto &policy) { entity.set_storage_policy(policy); },
+                std::ref(population), node_policies[node]);
+        });
+    calc_pool_->join();
+    // Parts of large populations are calculated on different nodes.
+    population_types_.for_each(
+        populations_,
+        [this](auto &population, size_t index)
+        {
+            // Neuron parameters are stored contiguously.
+            if (population.size() == 0) return;
+            bind_parts_to_nodes(
+                &population[0], population.size(), population_part_size_, population_nodes_[index], numa_nodes_,
+                storage_policy_.get());
+        });
+}
+
+
+void MultiThreadedCPUBackend::apply_projection_storage_policy()
+{
+    assign_home_nodes(
+        projections_, projection_types_, get_projection_variant, projection_part_size_, numa_nodes_.size(),
+        projection_nodes_);
+    if (!is_numa_aware())
+    {
+        if (!storage_policy_) return;
+        projection_types_.for_each(
+            projections_, get_projection_variant,
+            [this](auto &projection, size_t) { projection.set_storage_policy(storage_policy_); });
+        return;
+    }
+
+    const auto node_policies = get_node_storage_policies();
+    projection_types_.for_each(
+        projections_, get_projection_variant,
+        [this, &node_policies](auto &projection, size_t index)
+        {
+            const size_t node = get_projection_node(index, 0);
+            calc_pool_->post_on_node(
+                node, [](auto &entity, const auto &policy) { entity.set_storage_policy(policy); },
+                std::ref(projection), node_policies[node]);
+        });
+    calc_pool_->join();
+    // Parts of large projections are calculated on different nodes, a part reads synapses in its index range.
+    projection_types_.for_each(
+        projections_, get_projection_variant,
+        [this](auto &projection, size_t index)
+        {
+            const auto &part_nodes = projection_nodes_[index];
+            const auto bind_array = [this, &part_nodes](const auto &array)
+            {
+                bind_parts_to_nodes(
+                    array.data(), array.size(), projection_part_size_, part_nodes, numa_nodes_,
+                    storage_policy_.get());
+            };
+            bind_array(projection.get_synapses_parameters());
+            bind_array(projection.get_presynaptic_indexes());
+            bind_array(projection.get_postsynaptic_indexes());
+        });
+}
+
+
 std::vector<std::unique_ptr<knp::core::Device>> MultiThreadedCPUBackend::get_devices() const
 {
     std::vector<std::unique_ptr<knp::core::Device>> result;
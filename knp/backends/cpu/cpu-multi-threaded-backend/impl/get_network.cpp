@@ -19,6 +19,7 @@
  * limitations under the License.
  */
 
+#include <knp/backends/cpu-library/memory_usage.h>
 #include <knp/backends/cpu-multi-threaded/backend.h>
 #include <knp/meta/variant_helpers.h>
 
@@ -72,7 +73,13 @@ public:
         ++iter_;
         return *this;
     }
-    core::AllProjectionsVariant operator*() const override { return knp::meta::variant_cast(iter_->arg_); }
+    core::AllProjectionsVariant operator*() const override
+    {
+        // Copies of projections include weight changes that learning rules have not applied yet.
+        core::AllProjectionsVariant result = knp::meta::variant_cast(iter_->arg_);
+        std::visit([](auto &projection) { projection.flush_weight_changes(); }, result);
+        return result;
+    }
 
 private:
     MultiThreadedCPUBackend::ProjectionContainer::const_iterator iter_;
@@ -93,4 +100,22 @@ core::Backend::DataRanges MultiThreadedCPUBackend::get_network_data() const
     auto proj_range = std::make_pair(std::move(proj_begin), std::move(proj_end));
     return DataRanges{std::move(proj_range), std::move(pop_range)};
 }
+
+
+core::MemoryUsage MultiThreadedCPUBackend::get_memory_usage() const
+{
+    auto result = core::Backend::get_memory_usage();
+    result += knp::backends::cpu::get_network_memory_usage(populations_, projections_);
+    return result;
+}
+
+
+core::MemoryUsage MultiThreadedCPUBackend::estimate_memory_usage(
+    const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections)
+{
+    auto result = knp::backends::cpu::estimate_network_memory_usage<PopulationContainer, ProjectionContainer>(
+        populations, projections);
+    result.parameters_ += sizeof(MultiThreadedCPUBackend);
+    return result;
+}
 }  // namespace knp::backends::multi_threaded_cpu
@@ -32,13 +32,10 @@
 
 namespace knp::backends::cpu
 {
-template <>
-void finalize_population<
-    knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron,
-    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer>(
-    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population,
-    const knp::core::messaging::SpikeMessage &message,
-    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer &projections, knp::core::Step step)
+std::vector<knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> *>
+find_resource_stdp_projections(
+    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer &projections,
+    const knp::core::UID &population_uid)
 {
     using SynapseType = knp::synapse_traits::SynapticResourceSTDPDeltaSynapse;
     std::vector<knp::core::Projection<SynapseType> *> working_projections;
@@ -58,14 +55,25 @@ void finalize_population<
             continue;
         }
 
-        if (projection_ptr->get_postsynaptic() == population.get_uid())
+        if (projection_ptr->get_postsynaptic() == population_uid)
         {
             working_projections.push_back(projection_ptr);
         }
     }
+    return working_projections;
+}
+
 
+template <>
+void finalize_population<
+    knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron,
+    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer>(
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population,
+    const knp::core::messaging::SpikeMessage &message,
+    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer &projections, knp::core::Step step)
+{
     do_STDP_resource_plasticity<knp::neuron_traits::BLIFATNeuron, knp::synapse_traits::DeltaSynapse>(
-        population, working_projections, message, step);
+        population, find_resource_stdp_projections(projections, population.get_uid()), message, step);
 }
 
 }  //namespace knp::backends::cpu
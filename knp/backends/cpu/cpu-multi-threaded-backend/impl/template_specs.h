@@ -24,6 +24,8 @@
 #include <knp/backends/cpu-library/impl/blifat_population_impl.h>
 #include <knp/backends/cpu-multi-threaded/backend.h>
 
+#include <vector>
+
 /**
  * @brief Namespace for CPU backends.
  */
@@ -36,4 +38,16 @@ void finalize_population<
     knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population,
     const knp::core::messaging::SpikeMessage &message,
     multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer &projections, knp::core::Step step);
+
+
+/**
+ * @brief Find unlocked synaptic resource STDP projections connected to a population.
+ * @param projections projection container of the multi-threaded backend.
+ * @param population_uid UID of the postsynaptic population.
+ * @return pointers to found projections.
+ */
+std::vector<knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> *>
+find_resource_stdp_projections(
+    multi_threaded_cpu::MultiThreadedCPUBackend::ProjectionContainer &projections,
+    const knp::core::UID &population_uid);
 }  // namespace knp::backends::cpu
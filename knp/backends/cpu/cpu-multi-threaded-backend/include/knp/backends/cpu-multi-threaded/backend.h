@@ -26,7 +26,9 @@
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/core/storage_allocator.h>
 #include <knp/devices/cpu.h>
+#include <knp/meta/variant_helpers.h>
 #include <knp/neuron-traits/all_traits.h>
 #include <knp/synapse-traits/all_traits.h>
 
@@ -54,6 +56,18 @@ namespace knp::backends::cpu_executors
 class ThreadPool;
 }  // namespace knp::backends::cpu_executors
 
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+/**
+ * @brief The StepArenas class contains per-thread arenas for temporary data of a step.
+ */
+class StepArenas;
+}  // namespace knp::backends::cpu
+
 /**
  * @brief Namespace for multi-threaded backend.
  */
@@ -78,14 +92,17 @@ public:
     /**
      * @brief List of neuron types supported by the multi-threaded CPU backend.
      */
-    using SupportedNeurons =
-        boost::mp11::mp_list<knp::neuron_traits::BLIFATNeuron, knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron>;
+    using SupportedNeurons = boost::mp11::mp_list<
+        knp::neuron_traits::BLIFATNeuron, knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron,
+        knp::neuron_traits::HomogeneousBLIFATNeuron, knp::neuron_traits::Float32BLIFATNeuron>;
 
     /**
      * @brief List of synapse types supported by the multi-threaded CPU backend.
      */
-    using SupportedSynapses =
-        boost::mp11::mp_list<knp::synapse_traits::DeltaSynapse, knp::synapse_traits::SynapticResourceSTDPDeltaSynapse>;
+    using SupportedSynapses = boost::mp11::mp_list<
+        knp::synapse_traits::DeltaSynapse, knp::synapse_traits::SynapticResourceSTDPDeltaSynapse,
+        knp::synapse_traits::Float16DeltaSynapse, knp::synapse_traits::BFloat16DeltaSynapse,
+        knp::synapse_traits::Int8DeltaSynapse>;
 
     /**
      * @brief List of supported population types based on neuron types specified in `SupportedNeurons`.
@@ -146,10 +163,28 @@ public:
 
     /**
      * @brief Get a set of iterators for projections and populations.
+     * @details Projection copies include deferred weight changes.
      * @return `DataRanges` structure containing iterators.
      */
     [[nodiscard]] DataRanges get_network_data() const override;
 
+    /**
+     * @brief Get memory used by the backend.
+     * @return memory usage of loaded populations, projections and message queues.
+     */
+    [[nodiscard]] core::MemoryUsage get_memory_usage() const override;
+
+    /**
+     * @brief Estimate memory used by populations and projections loaded to the backend.
+     * @details Message queues are filled during execution, so they are not included.
+     * @param populations estimated memory usage of every population.
+     * @param projections estimated memory usage of every projection.
+     * @return estimated memory usage of the loaded network.
+     * @see Population::estimate_memory_usage(), Projection::estimate_memory_usage().
+     */
+    [[nodiscard]] static core::MemoryUsage estimate_memory_usage(
+        const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections);
+
 
     /**
      * @brief Types of constant population iterators.
@@ -164,19 +199,21 @@ public:
 public:
     /**
      * @brief Default constructor for multi-threaded CPU backend.
-     * @param thread_count number of threads.
-     * @param population_part_size number of synapses that are calculated in a single thread.
-     * @param projection_part_size number of neurons that are calculated in a single thread.
-     * @note If `thread_count` equals `0`, then the number of threads is calculated automatically.
+     * @details By default the pool gets one thread per physical core. Part sizes calculated from the CPU cache size
+     * can be passed from `get_cache_population_part_size()` and `get_cache_projection_part_size()`.
+     * @param thread_count number of threads. If `0`, the number of physical cores is used.
+     * @param population_part_size number of neurons that are calculated in a single thread. If `0`,
+     * `default_population_part_size` is used.
+     * @param projection_part_size number of synapses that are calculated in a single thread. If `0`,
+     * `default_projection_part_size` is used.
      */
     explicit MultiThreadedCPUBackend(
-        size_t thread_count = 0, size_t population_part_size = default_population_part_size,
-        size_t projection_part_size = default_projection_part_size);
+        size_t thread_count = 0, size_t population_part_size = 0, size_t projection_part_size = 0);
     /**
      * @brief Destructor for multi-threaded CPU backend.
      * @note All threads are stopped and joined on destruction by an internal thread pool object.
      */
-    ~MultiThreadedCPUBackend() override = default;
+    ~MultiThreadedCPUBackend() override;
 
 public:
     /**
@@ -327,6 +364,15 @@ public:
             std::visit([](auto &entity) { entity.lock_weights(); }, wrapper.arg_);
     }
 
+    /**
+     * @brief Apply deferred weight changes of all projections.
+     */
+    void flush_weight_changes() override
+    {
+        for (ProjectionWrapper &wrapper : projections_)
+            std::visit([](auto &entity) { entity.flush_weight_changes(); }, wrapper.arg_);
+    }
+
     /**
      * @brief Resume training by unlocking all projections.
      */
@@ -340,6 +386,87 @@ public:
             std::visit([](auto &entity) { entity.unlock_weights(); }, wrapper.arg_);
     }
 
+    /**
+     * @brief Set policy used to allocate neuron and synapse parameters of loaded populations and projections.
+     * @details Parameters of populations and projections that are already loaded are moved to the new storage.
+     * Populations and projections loaded later are moved to it when they are loaded.
+     * @note A loaded population or projection is copied to memory allocated by `operator new` and moved to the
+     * storage before the next one is copied. The source network must still fit in memory, so file-backed storage
+     * reduces memory used during execution, but does not allow loading networks larger than memory.
+     * @param policy storage policy.
+     */
+    void set_storage_policy(const core::StoragePolicy &policy);
+
+    /**
+     * @brief Get policy used to allocate neuron and synapse parameters.
+     * @return storage policy or `nullptr` if parameters are allocated by `operator new`.
+     */
+    [[nodiscard]] const std::shared_ptr<const core::StoragePolicy> &get_storage_policy() const
+    {
+        return storage_policy_;
+    }
+
+    /**
+     * @brief Enable or disable topology-aware scheduling.
+     * @details In the topology-aware mode workers are pinned to CPUs of NUMA nodes. Each part range of a population
+     * or projection, that is the range of neurons or synapses calculated by a single task, gets a home node. Parameters
+     * of a part range are moved to memory of its node, and the part is calculated by workers of the node unless they
+     * are busy. Homes are assigned so that nodes get similar numbers of neurons and synapses. Pages of huge page
+     * storage are bound whole, so part ranges shorter than a huge page stay on the node of the first part.
+     * @note If the system topology is unknown, the mode is not enabled. Parameters stay on their nodes after the mode
+     * is disabled.
+     * @param numa_aware `true` to enable topology-aware scheduling.
+     */
+    void set_numa_aware(bool numa_aware);
+
+    /**
+     * @brief Check if topology-aware scheduling is enabled.
+     * @return `true` if workers are pinned to NUMA nodes.
+     */
+    [[nodiscard]] bool is_numa_aware() const { return !numa_nodes_.empty(); }
+
+    /**
+     * @brief Get number of pool threads.
+     * @return number of threads.
+     */
+    [[nodiscard]] size_t get_thread_count() const { return thread_count_; }
+
+    /**
+     * @brief Get number of neurons that are calculated in a single thread.
+     * @return population part size.
+     */
+    [[nodiscard]] size_t get_population_part_size() const { return population_part_size_; }
+
+    /**
+     * @brief Get number of synapses that are calculated in a single thread.
+     * @return projection part size.
+     */
+    [[nodiscard]] size_t get_projection_part_size() const { return projection_part_size_; }
+
+    /**
+     * @brief Get number of neurons in a part whose data fits into half of the L2 cache of a core.
+     * @details Cache-sized parts are larger than default parts, so populations smaller than the part size multiplied
+     * by the thread count do not use all threads.
+     * @return population part size or `default_population_part_size` if the cache size is unknown.
+     */
+    [[nodiscard]] static size_t get_cache_population_part_size();
+
+    /**
+     * @brief Get number of synapses in a part whose data fits into half of the L2 cache of a core.
+     * @details Cache-sized parts are larger than default parts, so projections smaller than the part size multiplied
+     * by the thread count do not use all threads.
+     * @return projection part size or `default_projection_part_size` if the cache size is unknown.
+     */
+    [[nodiscard]] static size_t get_cache_projection_part_size();
+
+    /**
+     * @brief Get the largest amount of temporary step data allocated by the backend threads during a step.
+     * @details Temporary data of a step is allocated from per-thread arenas that are reset after the step. Arenas are
+     * freed when `set_numa_aware()` replaces the backend threads.
+     * @return sum of arena high-water marks of all threads in bytes.
+     */
+    [[nodiscard]] size_t get_step_arena_high_water_mark() const;
+
 protected:
     /**
      * @copydoc knp::core::Backend::_init()
@@ -349,18 +476,52 @@ protected:
 private:
     // Calculating pre-message neuron state, one thread per population_part_size_ neurons or less.
     void calculate_populations_pre_impact();
-    // Processing messages, one thread per population, probably very hard to go deeper unless atomic neuron params.
+    // Processing messages, one thread per population_part_size_ neurons for large populations.
     void calculate_populations_impact();
     // Do STDP logic for populations that support it. One thread per population.
     void do_STDP();
     // Calculating post input changes and outputs.
     std::vector<knp::core::messaging::SpikeMessage> calculate_populations_post_impact();
+    // Assign home NUMA nodes to loaded populations and move their parameters to storage allocated according to the
+    // storage policy.
+    void apply_population_storage_policy();
+    // Assign home NUMA nodes to loaded projections and move their parameters to storage allocated according to the
+    // storage policy.
+    void apply_projection_storage_policy();
+    // Get the home node of the part range that contains a neuron.
+    [[nodiscard]] size_t get_population_node(size_t population_index, size_t neuron_index) const
+    {
+        return population_nodes_[population_index][neuron_index / population_part_size_];
+    }
+    // Get the home node of the part range that contains a synapse.
+    [[nodiscard]] size_t get_projection_node(size_t projection_index, size_t synapse_index) const
+    {
+        return projection_nodes_[projection_index][synapse_index / projection_part_size_];
+    }
+    // Store endpoint handles of loaded populations and projections, so that the step loop doesn't search subscriptions.
+    void update_receiver_handles();
+    // Get storage policies that place arrays on NUMA nodes of the pool.
+    [[nodiscard]] std::vector<std::shared_ptr<const core::StoragePolicy>> get_node_storage_policies() const;
     PopulationContainer populations_;
     ProjectionContainer projections_;
+    // Runs of populations and projections of the same type for the step phases.
+    knp::meta::VariantPartition<PopulationVariants> population_types_;
+    knp::meta::VariantPartition<ProjectionVariants> projection_types_;
     const size_t population_part_size_;
     const size_t projection_part_size_;
+    const size_t thread_count_;
     std::unique_ptr<cpu_executors::ThreadPool> calc_pool_;
+    // Nodes used by the pool in the topology-aware mode.
+    std::vector<cpu_executors::NumaNode> numa_nodes_;
+    // Indexes of home nodes in `numa_nodes_` for each part range of every population and projection.
+    std::vector<std::vector<size_t>> population_nodes_;
+    std::vector<std::vector<size_t>> projection_nodes_;
+    // Endpoint handles of populations and projections.
+    std::vector<core::UIDHandle> population_handles_;
+    std::vector<core::UIDHandle> projection_handles_;
     std::mutex ep_mutex_;
+    std::shared_ptr<const core::StoragePolicy> storage_policy_;
+    std::unique_ptr<cpu::StepArenas> step_arenas_;
 };
 
 }  // namespace knp::backends::multi_threaded_cpu
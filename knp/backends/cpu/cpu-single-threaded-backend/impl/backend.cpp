@@ -87,51 +87,53 @@ SupportedVariants convert_variant(const AllVariants &input)
 }
 
 
+// Get a projection variant stored in a projection wrapper.
+constexpr auto get_projection_variant = [](auto &wrapper) -> auto & { return wrapper.arg_; };
+
+
+// Move parameters of a loaded population or projection to storage allocated according to a policy. Entities are moved
+// one by one while they are loaded, so that the whole network is not copied to memory allocated by `operator new`.
+template <class Variant>
+void set_loaded_storage_policy(Variant &variant, const std::shared_ptr<const core::StoragePolicy> &policy)
+{
+    if (policy) std::visit([&policy](auto &entity) { entity.set_storage_policy(policy); }, variant);
+}
+
+
 void SingleThreadedCPUBackend::_step()
 {
     SPDLOG_DEBUG("Starting step #{}...", get_step());
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
     // Calculate populations. This is the same as inference.
-    for (auto &population : populations_)
-    {
-        std::visit(
-            [this](auto &arg)
+    // Populations are calculated in the load order, the type is dispatched once per run of the same type.
+    population_types_.for_each(
+        populations_,
+        [this](auto &population, size_t index)
+        {
+            using T = typename std::decay_t<decltype(population)>::PopulationNeuronType;
+            if constexpr (boost::mp11::mp_find<LazyDecayNeurons, T>{} != boost::mp11::mp_size<LazyDecayNeurons>{})
             {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (
-                    boost::mp11::mp_find<SupportedPopulations, T>{} == boost::mp11::mp_size<SupportedPopulations>{})
+                if (lazy_decay_)
                 {
-                    static_assert(
-                        knp::meta::always_false_v<T>,
-                        "Population is not supported by the single-threaded CPU backend.");
+                    calculate_lazy_population(population, index);
+                    return;
                 }
-                auto message_opt = calculate_population(arg);
-            },
-            population);
-    }
+            }
+            calculate_population(population);
+        });
 
     // Continue inference.
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
     // Calculate projections.
-    for (auto &projection : projections_)
-    {
-        std::visit(
-            [this, &projection](auto &arg)
-            {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (
-                    boost::mp11::mp_find<SupportedProjections, T>{} == boost::mp11::mp_size<SupportedProjections>{})
-                {
-                    static_assert(
-                        knp::meta::always_false_v<T>,
-                        "Projection is not supported by the single-threaded CPU backend.");
-                }
-                calculate_projection(arg, projection.messages_);
-            },
-            projection.arg_);
-    }
+    projection_types_.for_each(
+        projections_, get_projection_variant,
+        [this](auto &projection, size_t index) { calculate_projection(projection, projections_[index].messages_); });
+    // Apply weight changes deferred to the end of the step.
+    projection_types_.for_each(
+        projections_, get_projection_variant, [this](auto &projection, size_t)
+        { knp::backends::cpu::finish_delta_synapse_projection_step(projection, get_step()); });
 
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
@@ -150,8 +152,10 @@ void SingleThreadedCPUBackend::load_populations(const std::vector<PopulationVari
 
     for (const auto &population : populations)
     {
-        populations_.push_back(population);
+        set_loaded_storage_policy(populations_.emplace_back(population), storage_policy_);
     }
+    lazy_decay_states_.assign(populations_.size(), LazyDecayState{});
+    population_types_.build(populations_);
     SPDLOG_DEBUG("All populations loaded.");
 }
 
@@ -164,8 +168,9 @@ void SingleThreadedCPUBackend::load_projections(const std::vector<ProjectionVari
 
     for (const auto &projection : projections)
     {
-        projections_.push_back(ProjectionWrapper{projection});
+        set_loaded_storage_policy(projections_.emplace_back(ProjectionWrapper{projection}).arg_, storage_policy_);
     }
+    projection_types_.build(projections_, get_projection_variant);
 
     SPDLOG_DEBUG("All projections loaded.");
 }
@@ -174,7 +179,10 @@ void SingleThreadedCPUBackend::load_projections(const std::vector<ProjectionVari
 void SingleThreadedCPUBackend::load_all_projections(const std::vector<knp::core::AllProjectionsVariant> &projections)
 {
     SPDLOG_DEBUG("Loading projections [{}]...", projections.size());
-    knp::meta::load_from_container<SupportedProjections>(projections, projections_);
+    knp::meta::load_from_container<SupportedProjections>(
+        projections, projections_,
+        [this](auto &wrapper) { set_loaded_storage_policy(wrapper.arg_, storage_policy_); });
+    projection_types_.build(projections_, get_projection_variant);
     SPDLOG_DEBUG("All projections loaded.");
 }
 
@@ -182,11 +190,40 @@ void SingleThreadedCPUBackend::load_all_projections(const std::vector<knp::core:
 void SingleThreadedCPUBackend::load_all_populations(const std::vector<knp::core::AllPopulationsVariant> &populations)
 {
     SPDLOG_DEBUG("Loading populations [{}]...", populations.size());
-    knp::meta::load_from_container<SupportedPopulations>(populations, populations_);
+    knp::meta::load_from_container<SupportedPopulations>(
+        populations, populations_,
+        [this](auto &population) { set_loaded_storage_policy(population, storage_policy_); });
+    lazy_decay_states_.assign(populations_.size(), LazyDecayState{});
+    population_types_.build(populations_);
     SPDLOG_DEBUG("All populations loaded.");
 }
 
 
+void SingleThreadedCPUBackend::set_storage_policy(const core::StoragePolicy &policy)
+{
+    storage_policy_ = std::make_shared<const core::StoragePolicy>(policy);
+    apply_population_storage_policy();
+    apply_projection_storage_policy();
+}
+
+
+void SingleThreadedCPUBackend::apply_population_storage_policy()
+{
+    if (!storage_policy_) return;
+    population_types_.for_each(
+        populations_, [this](auto &population, size_t) { population.set_storage_policy(storage_policy_); });
+}
+
+
+void SingleThreadedCPUBackend::apply_projection_storage_policy()
+{
+    if (!storage_policy_) return;
+    projection_types_.for_each(
+        projections_, get_projection_variant,
+        [this](auto &projection, size_t) { projection.set_storage_policy(storage_policy_); });
+}
+
+
 std::vector<std::unique_ptr<knp::core::Device>> SingleThreadedCPUBackend::get_devices() const
 {
     std::vector<std::unique_ptr<knp::core::Device>> result;
@@ -215,6 +252,48 @@ void SingleThreadedCPUBackend::_init()
 }
 
 
+void SingleThreadedCPUBackend::set_lazy_decay(bool enable)
+{
+    if (lazy_decay_ && !enable)
+    {
+        // Quiescent neurons have to get all skipped steps before they can be calculated every step.
+        synchronize_lazy_populations();
+        lazy_decay_states_.assign(populations_.size(), LazyDecayState{});
+    }
+    lazy_decay_ = enable;
+}
+
+
+void SingleThreadedCPUBackend::synchronize_lazy_populations()
+{
+    if (!lazy_decay_) return;
+
+    for (size_t index = 0; index < populations_.size(); ++index)
+    {
+        std::visit(
+            [this, &state = lazy_decay_states_[index]](auto &arg)
+            {
+                using T = typename std::decay_t<decltype(arg)>::PopulationNeuronType;
+                if constexpr (boost::mp11::mp_find<LazyDecayNeurons, T>{} != boost::mp11::mp_size<LazyDecayNeurons>{})
+                {
+                    knp::backends::cpu::synchronize_lazy_blifat_population(arg, state, get_step());
+                }
+            },
+            populations_[index]);
+    }
+}
+
+
+template <class BlifatLikeNeuron>
+std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_lazy_population(
+    core::Population<BlifatLikeNeuron> &population, size_t population_index)
+{
+    SPDLOG_TRACE("Calculate lazy BLIFAT-like population {}.", std::string(population.get_uid()));
+    return knp::backends::cpu::calculate_lazy_blifat_population(
+        population, lazy_decay_states_[population_index], get_message_endpoint(), get_step());
+}
+
+
 std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
     core::Population<knp::neuron_traits::BLIFATNeuron> &population)
 {
@@ -223,6 +302,14 @@ std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate
 }
 
 
+std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
+    core::Population<knp::neuron_traits::HomogeneousBLIFATNeuron> &population)
+{
+    SPDLOG_TRACE("Calculate homogeneous BLIFAT population {}.", std::string(population.get_uid()));
+    return knp::backends::cpu::calculate_blifat_population(population, get_message_endpoint(), get_step());
+}
+
+
 std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
     core::Population<neuron_traits::AltAILIF> &population)
 {
@@ -242,6 +329,26 @@ std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate
 }
 
 
+std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
+    core::Population<knp::neuron_traits::Float32BLIFATNeuron> &population)
+{
+    SPDLOG_TRACE("Calculate single-precision BLIFAT population {}.", std::string(population.get_uid()));
+    return knp::backends::cpu::calculate_blifat_population(population, get_message_endpoint(), get_step());
+}
+
+
+std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
+    knp::core::Population<knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron> &population)
+{
+    SPDLOG_TRACE(
+        "Calculate resource-based STDP-compatible single-precision BLIFAT population {}.",
+        std::string(population.get_uid()));
+    return knp::backends::cpu::calculate_resource_stdp_population<
+        neuron_traits::Float32BLIFATNeuron, synapse_traits::DeltaSynapse, ProjectionContainer>(
+        population, projections_, get_message_endpoint(), get_step());
+}
+
+
 void SingleThreadedCPUBackend::calculate_projection(
     knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue)
 {
@@ -271,8 +378,20 @@ void SingleThreadedCPUBackend::calculate_projection(
 }
 
 
+template <class WeightEncoding>
+void SingleThreadedCPUBackend::calculate_projection(
+    knp::core::Projection<knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>> &projection,
+    SynapticMessageQueue &message_queue)
+{
+    SPDLOG_TRACE("Calculate compressed delta synapse projection {}.", std::string(projection.get_uid()));
+    knp::backends::cpu::calculate_delta_synapse_projection(
+        projection, get_message_endpoint(), message_queue, get_step());
+}
+
+
 SingleThreadedCPUBackend::PopulationIterator SingleThreadedCPUBackend::begin_populations()
 {
+    synchronize_lazy_populations();
     return PopulationIterator{populations_.begin()};
 }
 
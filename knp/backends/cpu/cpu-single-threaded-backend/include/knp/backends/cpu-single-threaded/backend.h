@@ -25,7 +25,9 @@
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/core/storage_allocator.h>
 #include <knp/devices/cpu.h>
+#include <knp/meta/variant_helpers.h>
 #include <knp/neuron-traits/all_traits.h>
 #include <knp/synapse-traits/all_traits.h>
 
@@ -57,14 +59,24 @@ public:
      */
     using SupportedNeurons = boost::mp11::mp_list<
         knp::neuron_traits::BLIFATNeuron, knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron,
-        knp::neuron_traits::AltAILIF>;
+        knp::neuron_traits::AltAILIF, knp::neuron_traits::HomogeneousBLIFATNeuron,
+        knp::neuron_traits::Float32BLIFATNeuron, knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>;
 
     /**
      * @brief List of synapse types supported by the single-threaded CPU backend.
      */
     using SupportedSynapses = boost::mp11::mp_list<
         knp::synapse_traits::DeltaSynapse, knp::synapse_traits::AdditiveSTDPDeltaSynapse,
-        knp::synapse_traits::SynapticResourceSTDPDeltaSynapse>;
+        knp::synapse_traits::SynapticResourceSTDPDeltaSynapse, knp::synapse_traits::Float16DeltaSynapse,
+        knp::synapse_traits::BFloat16DeltaSynapse, knp::synapse_traits::Int8DeltaSynapse>;
+
+    /**
+     * @brief List of neuron types that can be calculated with lazy decay of quiescent neurons.
+     * @see set_lazy_decay().
+     */
+    using LazyDecayNeurons = boost::mp11::mp_list<
+        knp::neuron_traits::BLIFATNeuron, knp::neuron_traits::HomogeneousBLIFATNeuron,
+        knp::neuron_traits::Float32BLIFATNeuron>;
 
     /**
      * @brief List of supported population types based on neuron types specified in `SupportedNeurons`.
@@ -105,6 +117,15 @@ private:
         std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage> messages_;
     };
 
+    struct LazyDecayState
+    {
+        // Steps from which neuron states are not calculated.
+        std::vector<core::Step> update_steps_;
+        // Sorted indexes of neurons that are calculated every step.
+        std::vector<size_t> active_neurons_;
+        std::vector<bool> is_active_;
+    };
+
 public:
     /**
      * @brief Type of population container.
@@ -208,12 +229,16 @@ public:
 public:
     /**
      * @brief Get an iterator pointing to the first element of the population loaded to backend.
+     * @details If lazy decay is enabled, skipped steps are applied to quiescent neurons, so the populations have the
+     * state of the current step.
      * @return population iterator.
      */
     PopulationIterator begin_populations();
 
     /**
      * @brief Get an iterator pointing to the first element of the population loaded to backend.
+     * @note If lazy decay is enabled, quiescent neurons have the state of the step when they were last calculated.
+     * Use the non-constant overload or disable lazy decay to get the state of the current step.
      * @return constant population iterator.
      */
     PopulationConstIterator begin_populations() const;
@@ -288,6 +313,15 @@ public:
             std::visit([](auto &entity) { entity.lock_weights(); }, wrapper.arg_);
     }
 
+    /**
+     * @brief Apply deferred weight changes of all projections.
+     */
+    void flush_weight_changes() override
+    {
+        for (ProjectionWrapper &wrapper : projections_)
+            std::visit([](auto &entity) { entity.flush_weight_changes(); }, wrapper.arg_);
+    }
+
     /**
      * @brief Resume training by unlocking all projections.
      */
@@ -301,12 +335,71 @@ public:
             std::visit([](auto &entity) { entity.unlock_weights(); }, wrapper.arg_);
     }
 
+    /**
+     * @brief Enable or disable lazy decay of quiescent neurons.
+     * @details If lazy decay is enabled, a neuron of a population with a type from `LazyDecayNeurons` is not
+     * calculated while it receives no input and cannot spike. When the neuron gets a synaptic impact, the decay for all
+     * skipped steps is applied to the neuron in closed form. Per-step cost then depends on the number of active neurons
+     * instead of population size. Results are the same as without lazy decay up to rounding errors.
+     * @note Parameters of quiescent neurons are not updated while lazy decay is enabled, so constant population
+     * iterators and `get_network_data()` return the state of the step when a neuron was last calculated. Call the
+     * non-constant `begin_populations()` or disable lazy decay to bring all neurons to the current step.
+     * @param enable `true` to enable lazy decay.
+     */
+    void set_lazy_decay(bool enable);
+
+    /**
+     * @brief Check if lazy decay of quiescent neurons is enabled.
+     * @return `true` if lazy decay is enabled.
+     */
+    [[nodiscard]] bool is_lazy_decay_enabled() const { return lazy_decay_; }
+
+    /**
+     * @brief Set policy used to allocate neuron and synapse parameters of loaded populations and projections.
+     * @details Parameters of populations and projections that are already loaded are moved to the new storage.
+     * Populations and projections loaded later are moved to it when they are loaded.
+     * @note A loaded population or projection is copied to memory allocated by `operator new` and moved to the
+     * storage before the next one is copied. The source network must still fit in memory, so file-backed storage
+     * reduces memory used during execution, but does not allow loading networks larger than memory.
+     * @param policy storage policy.
+     */
+    void set_storage_policy(const core::StoragePolicy &policy);
+
+    /**
+     * @brief Get policy used to allocate neuron and synapse parameters.
+     * @return storage policy or `nullptr` if parameters are allocated by `operator new`.
+     */
+    [[nodiscard]] const std::shared_ptr<const core::StoragePolicy> &get_storage_policy() const
+    {
+        return storage_policy_;
+    }
+
     /**
      * @brief Get a set of iterators for projections and populations.
+     * @details Projection copies include deferred weight changes.
+     * @note If lazy decay is enabled, quiescent neurons have the state of the step when they were last calculated.
+     * @see set_lazy_decay().
      * @return `DataRanges` structure containing iterators.
      */
     [[nodiscard]] DataRanges get_network_data() const override;
 
+    /**
+     * @brief Get memory used by the backend.
+     * @return memory usage of loaded populations, projections and message queues.
+     */
+    [[nodiscard]] core::MemoryUsage get_memory_usage() const override;
+
+    /**
+     * @brief Estimate memory used by populations and projections loaded to the backend.
+     * @details Message queues are filled during execution, so they are not included.
+     * @param populations estimated memory usage of every population.
+     * @param projections estimated memory usage of every projection.
+     * @return estimated memory usage of the loaded network.
+     * @see Population::estimate_memory_usage(), Projection::estimate_memory_usage().
+     */
+    [[nodiscard]] static core::MemoryUsage estimate_memory_usage(
+        const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections);
+
 protected:
     /**
      * @brief Map used for message construction. It maps a message to its future output step.
@@ -318,6 +411,22 @@ protected:
      */
     void _init() override;
 
+    /**
+     * @brief Apply skipped steps to quiescent neurons of lazily calculated populations.
+     */
+    void synchronize_lazy_populations();
+
+    /**
+     * @brief Calculate population of BLIFAT-like neurons with lazy decay.
+     * @tparam BlifatLikeNeuron type of population neurons.
+     * @param population population to calculate.
+     * @param population_index index of the population in the population container.
+     * @return spike message with indexes of spiked neurons if population is emitting one.
+     */
+    template <class BlifatLikeNeuron>
+    std::optional<core::messaging::SpikeMessage> calculate_lazy_population(
+        knp::core::Population<BlifatLikeNeuron> &population, size_t population_index);
+
     /**
      * @brief Calculate population of BLIFAT neurons.
      * @note Population state will be changed during calculation.
@@ -327,6 +436,15 @@ protected:
     std::optional<core::messaging::SpikeMessage> calculate_population(
         knp::core::Population<knp::neuron_traits::BLIFATNeuron> &population);
 
+    /**
+     * @brief Calculate population of BLIFAT neurons with shared static parameters.
+     * @note Population state will be changed during calculation.
+     * @param population population to calculate.
+     * @return spike message with indexes of spiked neurons if population is emitting one.
+     */
+    std::optional<core::messaging::SpikeMessage> calculate_population(
+        knp::core::Population<knp::neuron_traits::HomogeneousBLIFATNeuron> &population);
+
     /**
      * @brief Calculate population of `SynapticResourceSTDPNeuron` neurons.
      * @note Population state will be changed during calculation.
@@ -336,6 +454,24 @@ protected:
     std::optional<core::messaging::SpikeMessage> calculate_population(
         knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population);
 
+    /**
+     * @brief Calculate population of BLIFAT neurons with single-precision parameters.
+     * @note Population state will be changed during calculation.
+     * @param population population to calculate.
+     * @return spike message with indexes of spiked neurons if population is emitting one.
+     */
+    std::optional<core::messaging::SpikeMessage> calculate_population(
+        knp::core::Population<knp::neuron_traits::Float32BLIFATNeuron> &population);
+
+    /**
+     * @brief Calculate population of `Float32SynapticResourceSTDPBLIFATNeuron` neurons.
+     * @note Population state will be changed during calculation.
+     * @param population population to calculate.
+     * @return spike message with indexes of spiked neurons if population is emitting one.
+     */
+    std::optional<core::messaging::SpikeMessage> calculate_population(
+        knp::core::Population<knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron> &population);
+
     /**
      * @brief Calculate population of 'AltAILIF' neurons.
      * @note Population state will be changed during calculation.
@@ -371,10 +507,34 @@ protected:
     void calculate_projection(
         knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> &projection,
         SynapticMessageQueue &message_queue);
+    /**
+     * @brief Calculate projection of delta synapses with reduced-precision weights.
+     * @note Projection will be changed during calculation.
+     * @tparam WeightEncoding weight encoding type.
+     * @param projection projection to calculate.
+     * @param message_queue message queue to send to projection for calculation.
+     */
+    template <class WeightEncoding>
+    void calculate_projection(
+        knp::core::Projection<knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>> &projection,
+        SynapticMessageQueue &message_queue);
+
+private:
+    // Move parameters of loaded populations to storage allocated according to the storage policy.
+    void apply_population_storage_policy();
+    // Move parameters of loaded projections to storage allocated according to the storage policy.
+    void apply_projection_storage_policy();
 
 private:
     PopulationContainer populations_;
     ProjectionContainer projections_;
+    // Runs of populations and projections of the same type for the step loop.
+    knp::meta::VariantPartition<PopulationVariants> population_types_;
+    knp::meta::VariantPartition<ProjectionVariants> projection_types_;
+    // Lazy decay states indexed the same way as populations.
+    std::vector<LazyDecayState> lazy_decay_states_;
+    bool lazy_decay_ = false;
+    std::shared_ptr<const core::StoragePolicy> storage_policy_;
 };
 
 }  // namespace knp::backends::single_threaded_cpu
@@ -20,27 +20,75 @@
  */
 #include <knp/backends/thread_pool/thread_pool_context.h>
 
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
 /**
  * @brief Namespace for CPU backend executors.
  */
 namespace knp::backends::cpu_executors
 {
-ThreadPoolContext::ThreadPoolContext(size_t num_threads) : pool_(num_threads)
+namespace
+{
+
+size_t get_workers_count(size_t num_threads, const std::vector<NumaNode> &nodes)
+{
+    if (num_threads) return num_threads;
+    size_t result = 0;
+    for (const auto &node : nodes) result += node.cpus_.size();
+    return result ? result : std::thread::hardware_concurrency();
+}
+
+
+void pin_current_thread([[maybe_unused]] unsigned cpu)
+{
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) return;
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0)
+    {
+        SPDLOG_WARN("Worker thread is not pinned to CPU {}.", cpu);
+    }
+#endif
+}
+
+}  // namespace
+
+
+ThreadPoolContext::ThreadPoolContext(size_t num_threads) : ThreadPoolContext(num_threads, std::vector<NumaNode>{}) {}
+
+
+ThreadPoolContext::ThreadPoolContext(size_t num_threads, const std::vector<NumaNode> &nodes)
+    : work_queues_(std::max<size_t>(nodes.size(), 1)),
+      node_conditions_(work_queues_.size()),
+      idle_workers_(work_queues_.size(), 0),
+      node_wakeups_(work_queues_.size(), 0),
+      pool_(get_workers_count(num_threads, nodes))
 {
+    num_threads = get_workers_count(num_threads, nodes);
     try
     {
         for (size_t thread_index = 0; thread_index < num_threads; ++thread_index)
         {
-            boost::asio::post(
-                pool_,
-                [this]
-                {
-                    std::unique_lock lock(mutex_);
-                    while (usage_state_ != Usage::FINISHED)
-                    {
-                        if (!execute_next(lock)) condition_.wait(lock);
-                    }
-                });
+            if (nodes.empty())
+            {
+                start_worker(0, std::nullopt);
+                continue;
+            }
+            // Workers are distributed between nodes in turn, so a smaller pool uses all nodes.
+            const size_t node = thread_index % nodes.size();
+            const auto &cpus = nodes[node].cpus_;
+            start_worker(
+                node, cpus.empty() ? std::nullopt
+                                   : std::optional<unsigned>(cpus[(thread_index / nodes.size()) % cpus.size()]));
         }
     }
     catch (...)
@@ -51,6 +99,54 @@ ThreadPoolContext::ThreadPoolContext(size_t num_threads) : pool_(num_threads)
 }
 
 
+void ThreadPoolContext::start_worker(size_t node, std::optional<unsigned> cpu)
+{
+    boost::asio::post(
+        pool_,
+        [this, node, cpu]
+        {
+            if (cpu) pin_current_thread(*cpu);
+            std::unique_lock lock(mutex_);
+            while (usage_state_ != Usage::FINISHED)
+            {
+                if (execute_next(lock, node)) continue;
+                ++idle_workers_[node];
+                node_conditions_[node].wait(
+                    lock, [this, node] { return node_wakeups_[node] > 0 || usage_state_ == Usage::FINISHED; });
+                // A worker that wakes on stop is not counted as notified.
+                if (node_wakeups_[node] > 0)
+                    --node_wakeups_[node];
+                else
+                    --idle_workers_[node];
+            }
+        });
+}
+
+
+void ThreadPoolContext::notify_worker(size_t node)
+{
+    // A worker of another node takes the task if all workers of the node are busy.
+    for (size_t shift = 0; shift < idle_workers_.size(); ++shift)
+    {
+        const size_t candidate = (node + shift) % idle_workers_.size();
+        if (idle_workers_[candidate] == 0) continue;
+        --idle_workers_[candidate];
+        ++node_wakeups_[candidate];
+        node_conditions_[candidate].notify_one();
+        return;
+    }
+    // All workers are busy, a thread that joins the pool can take the task.
+    condition_.notify_one();
+}
+
+
+void ThreadPoolContext::notify_all_workers()
+{
+    for (auto &node_condition : node_conditions_) node_condition.notify_all();
+    condition_.notify_all();
+}
+
+
 ThreadPoolContext::~ThreadPoolContext()
 {
     stop();
@@ -71,7 +167,10 @@ void ThreadPoolContext::do_work_finished(const std::shared_ptr<size_t> &task_cou
     if (--(*task_count) == 0)
     {
         usage_state_ = usage_state_ == Usage::STOPPING ? Usage::FINISHED : Usage::READY;
-        condition_.notify_all();
+        if (usage_state_ == Usage::FINISHED)
+            notify_all_workers();
+        else
+            condition_.notify_all();
     }
 }
 
@@ -94,11 +193,18 @@ void ThreadPoolContext::execute(std::unique_lock<std::mutex> &lock, std::shared_
 }
 
 
-bool ThreadPoolContext::execute_next(std::unique_lock<std::mutex> &lock)
+bool ThreadPoolContext::execute_next(std::unique_lock<std::mutex> &lock, size_t node)
 {
-    if (work_queue_.empty()) return false;
-    auto task(work_queue_.front());
-    work_queue_.pop();
+    // Tasks of the node are taken first, then a worker takes tasks of other nodes instead of waiting.
+    auto queue_iter = work_queues_.end();
+    for (size_t shift = 0; shift < work_queues_.size() && queue_iter == work_queues_.end(); ++shift)
+    {
+        auto candidate = work_queues_.begin() + static_cast<std::ptrdiff_t>((node + shift) % work_queues_.size());
+        if (!candidate->empty()) queue_iter = candidate;
+    }
+    if (queue_iter == work_queues_.end()) return false;
+    auto task(queue_iter->front());
+    queue_iter->pop();
     lock.unlock();
     execute(lock, task);
     return true;
@@ -109,15 +215,17 @@ void ThreadPoolContext::stop()
 {
     std::lock_guard lock_guard(mutex_);
     usage_state_ = usage_state_ == Usage::READY ? Usage::FINISHED : Usage::STOPPING;
-    condition_.notify_all();
+    notify_all_workers();
 }
 
 
-void ThreadPoolContext::post(const std::shared_ptr<Function> &task, const std::shared_ptr<size_t> &task_count)
+void ThreadPoolContext::post(
+    const std::shared_ptr<Function> &task, const std::shared_ptr<size_t> &task_count, size_t node)
 {
     std::lock_guard lock(mutex_);
-    work_queue_.push(task);
+    node %= work_queues_.size();
+    work_queues_[node].push(task);
     do_work_started(task_count);
-    condition_.notify_one();
+    notify_worker(node);
 }
 }  // namespace knp::backends::cpu_executors
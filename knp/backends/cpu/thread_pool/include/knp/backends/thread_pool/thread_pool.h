@@ -20,6 +20,7 @@
  */
 #pragma once
 #include <memory>
+#include <vector>
 
 #include "thread_pool_context.h"
 #include "thread_pool_executor.h"
@@ -59,6 +60,37 @@ public:
         boost::asio::post(executor_, std::bind(func, args...));
     }
 
+    /**
+     * @brief Create thread pool with workers pinned to CPUs of NUMA nodes.
+     * @param num_threads number of worker threads in the pool. If `0`, one worker is created for each CPU.
+     * @param nodes NUMA nodes used by the pool.
+     */
+    ThreadPool(size_t num_threads, const std::vector<NumaNode> &nodes)
+        : context_(std::make_unique<ThreadPoolContext>(num_threads, nodes)), executor_(*context_)
+    {
+    }
+
+    /**
+     * @brief Add task that is preferably executed by workers of a NUMA node.
+     * @tparam Func function type.
+     * @tparam Args function arguments.
+     * @param node node index. If the pool is not NUMA-aware, the index is ignored.
+     * @param func task to run in the pool.
+     * @param args function arguments (if required, use `std::ref`).
+     * @note Non-blocking method.
+     */
+    template <class Func, typename... Args>
+    void post_on_node(size_t node, Func func, Args... args)
+    {
+        executor_.post_on_node(std::bind(func, args...), node);
+    }
+
+    /**
+     * @brief Get number of NUMA nodes used by the pool.
+     * @return number of nodes or `1` if the pool is not NUMA-aware.
+     */
+    [[nodiscard]] size_t get_nodes_count() const { return context_->get_nodes_count(); }
+
     /**
      * @brief Wait until all threads stop processing.
      * @note Blocking method that waits indefinitely if at least one task never stops.
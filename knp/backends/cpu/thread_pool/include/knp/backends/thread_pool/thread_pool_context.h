@@ -23,9 +23,11 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/ts/executor.hpp>
@@ -37,6 +39,23 @@
 namespace knp::backends::cpu_executors
 {
 
+/**
+ * @brief The NumaNode structure contains logical CPUs of a NUMA node.
+ */
+struct NumaNode
+{
+    /**
+     * @brief Node index in the system.
+     */
+    unsigned id_ = 0;
+
+    /**
+     * @brief Indexes of logical CPUs of the node.
+     */
+    std::vector<unsigned> cpus_;
+};
+
+
 /**
  * @brief The ThreadPoolContext class is a service class used for creating pool executors.
  * @note Context lifetime should exceed lifetimes of its executors.\n
@@ -51,6 +70,16 @@ public:
      */
     explicit ThreadPoolContext(size_t num_threads = std::thread::hardware_concurrency());
 
+    /**
+     * @brief Construct a pool with workers pinned to CPUs of NUMA nodes.
+     * @details Workers are distributed between nodes in turn, each worker is pinned to a single CPU of its node. A
+     * task posted to a node is executed by a worker of the node if one is free, otherwise other workers take it.
+     * @param num_threads number of worker threads. If `0`, one worker is created for each CPU.
+     * @param nodes NUMA nodes used by the pool. If empty, workers are not pinned and all tasks are posted to a single
+     * queue.
+     */
+    ThreadPoolContext(size_t num_threads, const std::vector<NumaNode> &nodes);
+
     /**
      * @brief Blocking destructor.
      * @note The destructor sends signal for threads to finish working, then joins all worker threads.
@@ -59,6 +88,11 @@ public:
 
     // Move and assignment are implicitly deleted because of mutex.
 
+    /**
+     * @brief Get number of nodes to which tasks can be posted.
+     * @return number of task queues.
+     */
+    [[nodiscard]] size_t get_nodes_count() const { return work_queues_.size(); }
 
 private:
     enum class Usage
@@ -82,11 +116,21 @@ private:
 
     void execute(std::unique_lock<std::mutex> &lock, std::shared_ptr<Function> &work);
 
-    bool execute_next(std::unique_lock<std::mutex> &lock);
+    // Execute a task of the node queue or, if it is empty, a task of another node.
+    bool execute_next(std::unique_lock<std::mutex> &lock, size_t node = 0);
 
     void stop();
 
-    void post(const std::shared_ptr<Function> &task, const std::shared_ptr<size_t> &task_count);
+    void post(const std::shared_ptr<Function> &task, const std::shared_ptr<size_t> &task_count, size_t node = 0);
+
+    // Post a worker that executes tasks until the pool is stopped.
+    void start_worker(size_t node, std::optional<unsigned> cpu);
+
+    // Wake a single waiting worker, preferably of the given node.
+    void notify_worker(size_t node);
+
+    // Wake all waiting workers and threads that wait for tasks to finish.
+    void notify_all_workers();
 
 private:
     /**
@@ -94,10 +138,18 @@ private:
      */
     friend class ThreadPoolExecutor;
     std::mutex mutex_;
+    // Threads that wait for tasks to finish.
     std::condition_variable condition_;
     Usage usage_state_ = Usage::READY;
+    // Task queue of each node.
     // cppcheck-suppress unusedStructMember
-    std::queue<std::shared_ptr<Function>> work_queue_;
+    std::vector<std::queue<std::shared_ptr<Function>>> work_queues_;
+    // Workers of a node wait on the condition of the node, so a posted task wakes a worker of its node.
+    std::vector<std::condition_variable> node_conditions_;
+    // Number of waiting workers of each node that are not notified yet.
+    std::vector<size_t> idle_workers_;
+    // Number of notifications of each node that are not received by workers yet.
+    std::vector<size_t> node_wakeups_;
     boost::asio::thread_pool pool_;
 };
 
@@ -72,6 +72,19 @@ public:
         context_.post(new_task, task_count_);
     }
 
+    /**
+     * @brief Add a task that is preferably executed by workers of a NUMA node.
+     * @tparam Func function type.
+     * @param function function to add to task queue.
+     * @param node node index.
+     */
+    template <class Func>
+    void post_on_node(Func function, size_t node) const
+    {
+        auto new_task(std::make_shared<Task<Func>>(std::move(function), task_count_));
+        context_.post(new_task, task_count_, node);
+    }
+
     /**
      * @brief Wait for all tasks to finish.
      * @note The method does not join threads.
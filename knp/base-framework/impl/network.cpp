@@ -312,6 +312,27 @@ void Network::remove_projection(const core::UID &projection_uid)
 }
 
 
+core::MemoryUsage Network::get_memory_usage() const
+{
+    constexpr auto get_variant = [](const auto &entity) -> const auto & { return entity; };
+    auto result = core::get_entities_memory_usage(populations_, get_variant) +
+                  core::get_entities_memory_usage(projections_, get_variant);
+    result.parameters_ += sizeof(*this);
+    result.tags_ += base_.tags_.get_memory_usage();
+    return result;
+}
+
+
+core::MemoryUsage Network::estimate_memory_usage(
+    const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections)
+{
+    auto result = core::estimate_entities_memory_usage<PopulationContainer::value_type>(populations) +
+                  core::estimate_entities_memory_usage<ProjectionContainer::value_type>(projections);
+    result.parameters_ += sizeof(Network);
+    return result;
+}
+
+
 template <typename PopulationType>
 void Network::check_population_constraints(const PopulationType &population) const
 {
@@ -79,6 +79,12 @@ std::vector<core::AllProjectionsVariant> load_projections(const fs::path &proj_h
             result.emplace_back(load_projection<synapse_traits::DeltaSynapse>(group, proj_name));
         else if (proj_type == get_synapse_type_id<synapse_traits::SynapticResourceSTDPDeltaSynapse>())
             result.emplace_back(load_projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>(group, proj_name));
+        else if (proj_type == get_synapse_type_id<synapse_traits::Float16DeltaSynapse>())
+            result.emplace_back(load_projection<synapse_traits::Float16DeltaSynapse>(group, proj_name));
+        else if (proj_type == get_synapse_type_id<synapse_traits::BFloat16DeltaSynapse>())
+            result.emplace_back(load_projection<synapse_traits::BFloat16DeltaSynapse>(group, proj_name));
+        else if (proj_type == get_synapse_type_id<synapse_traits::Int8DeltaSynapse>())
+            result.emplace_back(load_projection<synapse_traits::Int8DeltaSynapse>(group, proj_name));
         // TODO: Add other supported types or better use a template.
     }
     return result;
@@ -109,6 +115,13 @@ std::vector<core::AllPopulationsVariant> load_populations(const fs::path &pop_h5
             result.emplace_back(load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(group, proj_name));
         else if (neuron_type == get_neuron_type_id<neuron_traits::AltAILIF>())
             result.emplace_back(load_population<neuron_traits::AltAILIF>(group, proj_name));
+        else if (neuron_type == get_neuron_type_id<neuron_traits::HomogeneousBLIFATNeuron>())
+            result.emplace_back(load_population<neuron_traits::HomogeneousBLIFATNeuron>(group, proj_name));
+        else if (neuron_type == get_neuron_type_id<neuron_traits::Float32BLIFATNeuron>())
+            result.emplace_back(load_population<neuron_traits::Float32BLIFATNeuron>(group, proj_name));
+        else if (neuron_type == get_neuron_type_id<neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>())
+            result.emplace_back(
+                load_population<neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>(group, proj_name));
         // TODO: Add other supported types or better use a template.
     }
     return result;
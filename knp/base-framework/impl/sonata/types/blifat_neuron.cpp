@@ -45,7 +45,15 @@ std::string get_neuron_type_name<neuron_traits::BLIFATNeuron>()
 }
 
 
-void save_static(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, HighFive::Group &group)
+template <>
+std::string get_neuron_type_name<neuron_traits::Float32BLIFATNeuron>()
+{
+    return "knp:Float32BlifatNeuron";
+}
+
+
+template <class Neuron>
+void save_static(const core::Population<Neuron> &population, HighFive::Group &group)
 {
     // TODO: Need to check if all parameters are the same. If not, save them into h5.
     // Static.
@@ -69,7 +77,8 @@ void save_static(const core::Population<knp::neuron_traits::BLIFATNeuron> &popul
 }
 
 
-void save_dynamic(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, HighFive::Group &group0)
+template <class Neuron>
+void save_dynamic(const core::Population<Neuron> &population, HighFive::Group &group0)
 {
     auto dynamic_group = group0.createGroup(dynamic_subgroup_name);
     PUT_NEURON_TO_DATASET(population, dynamic_threshold_, dynamic_group);
@@ -93,61 +102,89 @@ void add_population_to_h5<core::Population<knp::neuron_traits::BLIFATNeuron>>(
 }
 
 
+template <>
+void add_population_to_h5<core::Population<knp::neuron_traits::Float32BLIFATNeuron>>(
+    HighFive::File &file_h5, const core::Population<knp::neuron_traits::Float32BLIFATNeuron> &population)
+{
+    SPDLOG_DEBUG("Saving single-precision BLIFAT nodes...");
+    auto group0 = initialize_adding_population(population, file_h5);
+    save_static(population, group0);
+    save_dynamic(population, group0);
+}
+
+
+template <class Neuron>
 void load_static_parameters(
-    std::vector<neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>> &target, const HighFive::Group &group0)
+    std::vector<neuron_traits::neuron_parameters<Neuron>> &target, const HighFive::Group &group0)
 {
     const size_t group_size = target.size();
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, n_time_steps_since_last_firing_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, activation_threshold_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, threshold_decay_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, threshold_increment_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, postsynaptic_trace_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, postsynaptic_trace_decay_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, postsynaptic_trace_increment_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, inhibitory_conductance_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, inhibitory_conductance_decay_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, potential_decay_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, bursting_period_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, reflexive_weight_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, reversal_inhibitory_potential_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, absolute_refractory_period_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, potential_reset_value_, group0, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, min_potential_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, n_time_steps_since_last_firing_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, activation_threshold_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, threshold_decay_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, threshold_increment_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, postsynaptic_trace_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, postsynaptic_trace_decay_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, postsynaptic_trace_increment_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, inhibitory_conductance_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, inhibitory_conductance_decay_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, potential_decay_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, bursting_period_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, reflexive_weight_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, reversal_inhibitory_potential_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, absolute_refractory_period_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, potential_reset_value_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, min_potential_, group0, group_size);
 }
 
 
+template <class Neuron>
 void load_dynamic_parameters(
-    std::vector<neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>> &target, const HighFive::Group &group0)
+    std::vector<neuron_traits::neuron_parameters<Neuron>> &target, const HighFive::Group &group0)
 {
     const size_t group_size = target.size();
     auto dyn_group = group0.getGroup(dynamic_subgroup_name);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, dynamic_threshold_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, potential_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, pre_impact_potential_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, bursting_phase_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, total_blocking_period_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, dopamine_value_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, dynamic_threshold_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, pre_impact_potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, bursting_phase_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, total_blocking_period_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, Neuron, dopamine_value_, dyn_group, group_size);
 }
 
 
-template <>
-core::Population<neuron_traits::BLIFATNeuron> load_population<neuron_traits::BLIFATNeuron>(
-    const HighFive::Group &nodes_group, const std::string &population_name)
+template <class Neuron>
+core::Population<Neuron> load_blifat_population(const HighFive::Group &nodes_group, const std::string &population_name)
 {
-    SPDLOG_DEBUG("Loading BLIFAT nodes...");
     auto group0 = nodes_group.getGroup(population_name).getGroup("0");
     const size_t group_size = nodes_group.getGroup(population_name).getDataSet("node_id").getDimensions().at(0);
 
     // TODO: Load default neuron from JSON file.
-    std::vector<neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>> target(group_size);
+    std::vector<neuron_traits::neuron_parameters<Neuron>> target(group_size);
     load_static_parameters(target, group0);
     load_dynamic_parameters(target, group0);
 
     const knp::core::UID uid{boost::lexical_cast<boost::uuids::uuid>(population_name)};
-    core::Population<neuron_traits::BLIFATNeuron> out_population(
-        uid, [&target](size_t index) { return target[index]; }, group_size);
+    core::Population<Neuron> out_population(uid, [&target](size_t index) { return target[index]; }, group_size);
     return out_population;
 }
 
 
+template <>
+core::Population<neuron_traits::BLIFATNeuron> load_population<neuron_traits::BLIFATNeuron>(
+    const HighFive::Group &nodes_group, const std::string &population_name)
+{
+    SPDLOG_DEBUG("Loading BLIFAT nodes...");
+    return load_blifat_population<neuron_traits::BLIFATNeuron>(nodes_group, population_name);
+}
+
+
+template <>
+core::Population<neuron_traits::Float32BLIFATNeuron> load_population<neuron_traits::Float32BLIFATNeuron>(
+    const HighFive::Group &nodes_group, const std::string &population_name)
+{
+    SPDLOG_DEBUG("Loading single-precision BLIFAT nodes...");
+    return load_blifat_population<neuron_traits::Float32BLIFATNeuron>(nodes_group, population_name);
+}
+
+
 }  // namespace knp::framework::sonata
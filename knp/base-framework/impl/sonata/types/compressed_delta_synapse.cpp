@@ -0,0 +1,268 @@
+/**
+ * @file compressed_delta_synapse.cpp
+ * @brief Functions for loading and saving delta synapses with reduced-precision weights.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/projection.h>
+#include <knp/synapse-traits/compressed_delta.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "../csv_content.h"
+#include "../highfive.h"
+#include "../load_network.h"
+#include "../save_network.h"
+#include "type_id_defines.h"
+
+
+namespace knp::framework::sonata
+{
+
+namespace
+{
+
+// Compressed projections are stored with decoded weights in the same format as delta projections. Encoded weights and
+// scale factors are stored as well, so that a saved projection is loaded without quantizing its weights again.
+template <class WeightEncoding>
+core::Projection<synapse_traits::CompressedDeltaSynapse<WeightEncoding>> load_compressed_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    using SynapseType = synapse_traits::CompressedDeltaSynapse<WeightEncoding>;
+    using ProjectionType = core::Projection<SynapseType>;
+
+    SPDLOG_DEBUG("Loading edges for projection {}...", projection_name);
+    auto projection_group = edges_group.getGroup(projection_name);
+    auto group = projection_group.getGroup("0");
+    size_t group_size = projection_group.getDataSet("edge_group_id").getDimensions().at(0);
+
+    const auto weights =
+        read_parameter<float>(group, "syn_weight", group_size, synapse_traits::default_values<SynapseType>::weight_);
+    const auto delays = read_parameter<uint32_t>(
+        group, "delay", group_size, synapse_traits::default_values<SynapseType>::delay_);
+    if (std::any_of(
+            delays.begin(), delays.end(), [](uint32_t delay) { return delay > std::numeric_limits<uint16_t>::max(); }))
+        throw std::out_of_range("Synapse delay does not fit into a compressed synapse.");
+    const auto out_types = read_parameter<int>(
+        group, "output_type_", group_size,
+        static_cast<int>(synapse_traits::default_values<SynapseType>::output_type_));
+    const auto source_ids = read_parameter<size_t>(projection_group, "source_node_id", group_size, 0);
+    const auto target_ids = read_parameter<size_t>(projection_group, "target_node_id", group_size, 0);
+
+    const core::UID uid_from{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_to{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
+
+    ProjectionType proj(uid_own, uid_from, uid_to);
+    auto &shared_params = proj.get_shared_parameters().synapses_parameters_;
+
+    std::vector<typename WeightEncoding::StorageType> weight_codes;
+    if (group.exist("weight_code"))
+    {
+        group.getDataSet("weight_code").read(weight_codes);
+        shared_params.scale_ = projection_group.getAttribute("weight_scale").read<float>();
+        if (projection_group.exist("presynaptic_weight_scales"))
+            projection_group.getDataSet("presynaptic_weight_scales").read(shared_params.presynaptic_scales_);
+    }
+    else
+    {
+        // Files written by other tools contain only weight values.
+        float max_abs_weight = 0;
+        for (const auto weight : weights) max_abs_weight = std::max(max_abs_weight, std::fabs(weight));
+        shared_params.scale_ = WeightEncoding::get_scale(max_abs_weight);
+        weight_codes.reserve(weights.size());
+        for (size_t i = 0; i < weights.size(); ++i)
+            weight_codes.push_back(shared_params.encode_weight(weights[i], source_ids[i]));
+    }
+    if (weight_codes.size() != group_size)
+        throw std::runtime_error("Wrong number of encoded weights in the projection \"" + projection_name + "\".");
+
+    proj.add_synapses(
+        [&](size_t index) -> std::optional<typename ProjectionType::Synapse>
+        {
+            return typename ProjectionType::Synapse{
+                {weight_codes[index], static_cast<uint16_t>(delays[index]),
+                 static_cast<synapse_traits::OutputType>(out_types[index])},
+                source_ids[index],
+                target_ids[index]};
+        },
+        group_size);
+
+    if (projection_group.hasAttribute("is_locked"))
+    {
+        if (projection_group.getAttribute("is_locked").read<bool>())
+        {
+            proj.lock_weights();
+        }
+        else
+        {
+            proj.unlock_weights();
+        }
+    }
+
+    return proj;
+}
+
+
+template <class WeightEncoding>
+void add_compressed_projection_to_h5(
+    HighFive::File &file_h5,
+    const knp::core::Projection<synapse_traits::CompressedDeltaSynapse<WeightEncoding>> &projection)
+{
+    using SynapseType = synapse_traits::CompressedDeltaSynapse<WeightEncoding>;
+
+    if (!file_h5.exist("edges")) throw std::runtime_error("File does not contain the \"edges\" group.");
+
+    std::vector<uint64_t> source_ids, target_ids;
+    std::vector<uint32_t> delays;
+    std::vector<float> weights;
+    std::vector<typename WeightEncoding::StorageType> weight_codes;
+    std::vector<int> out_types;
+
+    source_ids.reserve(projection.size());
+    target_ids.reserve(projection.size());
+    delays.reserve(projection.size());
+    weights.reserve(projection.size());
+    weight_codes.reserve(projection.size());
+    out_types.reserve(projection.size());
+
+    const auto &shared_params = projection.get_shared_parameters().synapses_parameters_;
+    for (const auto &v : projection)
+    {
+        const auto &params = std::get<knp::core::synapse_data>(v);
+        source_ids.push_back(std::get<knp::core::source_neuron_id>(v));
+        target_ids.push_back(std::get<knp::core::target_neuron_id>(v));
+        delays.push_back(params.delay_);
+        weights.push_back(shared_params.decode_weight(params, std::get<knp::core::source_neuron_id>(v)));
+        weight_codes.push_back(params.weight_code_);
+        out_types.push_back(static_cast<int>(params.output_type_));
+    }
+
+    HighFive::Group proj_group = file_h5.createGroup("edges/" + std::string(projection.get_uid()));
+    HighFive::DataSet source_node_dataset = proj_group.createDataSet("source_node_id", source_ids);
+    source_node_dataset.createAttribute("node_population", std::string(projection.get_presynaptic()));
+
+    HighFive::DataSet target_node_dataset = proj_group.createDataSet("target_node_id", target_ids);
+    target_node_dataset.createAttribute("node_population", std::string(projection.get_postsynaptic()));
+
+    // At the moment we support only one synapse group.
+    proj_group.createDataSet("edge_group_id", std::vector(projection.size(), 0));
+    proj_group.createDataSet("edge_type_id", std::vector(projection.size(), get_synapse_type_id<SynapseType>()));
+
+    std::vector<uint64_t> group_index;
+    group_index.reserve(projection.size());
+    for (size_t i = 0; i < projection.size(); ++i) group_index.push_back(i);
+
+    proj_group.createDataSet("edge_group_index", group_index);
+
+    HighFive::Group syn_group = proj_group.createGroup("0");
+    syn_group.createDataSet("syn_weight", weights);
+    syn_group.createDataSet("weight_code", weight_codes);
+    proj_group.createAttribute("weight_scale", shared_params.scale_);
+    if (!shared_params.presynaptic_scales_.empty())
+        proj_group.createDataSet("presynaptic_weight_scales", shared_params.presynaptic_scales_);
+    syn_group.createDataSet("delay", delays);
+    syn_group.createDataSet("output_type_", out_types);
+    proj_group.createAttribute("is_locked", projection.is_locked());
+}
+
+}  // namespace
+
+
+template <>
+std::string get_synapse_type_name<synapse_traits::Float16DeltaSynapse>()
+{
+    return "knp:Float16DeltaSynapse";
+}
+
+
+template <>
+std::string get_synapse_type_name<synapse_traits::BFloat16DeltaSynapse>()
+{
+    return "knp:BFloat16DeltaSynapse";
+}
+
+
+template <>
+std::string get_synapse_type_name<synapse_traits::Int8DeltaSynapse>()
+{
+    return "knp:Int8DeltaSynapse";
+}
+
+
+template <>
+core::Projection<synapse_traits::Float16DeltaSynapse> load_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    return load_compressed_projection<synapse_traits::Float16WeightEncoding>(edges_group, projection_name);
+}
+
+
+template <>
+core::Projection<synapse_traits::BFloat16DeltaSynapse> load_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    return load_compressed_projection<synapse_traits::BFloat16WeightEncoding>(edges_group, projection_name);
+}
+
+
+template <>
+core::Projection<synapse_traits::Int8DeltaSynapse> load_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    return load_compressed_projection<synapse_traits::Int8WeightEncoding>(edges_group, projection_name);
+}
+
+
+template <>
+void add_projection_to_h5<core::Projection<synapse_traits::Float16DeltaSynapse>>(
+    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::Float16DeltaSynapse> &projection)
+{
+    add_compressed_projection_to_h5(file_h5, projection);
+}
+
+
+template <>
+void add_projection_to_h5<core::Projection<synapse_traits::BFloat16DeltaSynapse>>(
+    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::BFloat16DeltaSynapse> &projection)
+{
+    add_compressed_projection_to_h5(file_h5, projection);
+}
+
+
+template <>
+void add_projection_to_h5<core::Projection<synapse_traits::Int8DeltaSynapse>>(
+    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::Int8DeltaSynapse> &projection)
+{
+    add_compressed_projection_to_h5(file_h5, projection);
+}
+
+}  // namespace knp::framework::sonata
@@ -0,0 +1,148 @@
+/**
+ * @file homogeneous_blifat_neuron.cpp
+ * @brief Homogeneous BLIFAT neuron procedures.
+ * @kaspersky_support An. Vartenkov
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/population.h>
+#include <knp/core/uid.h>
+#include <knp/neuron-traits/homogeneous_blifat.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/lexical_cast.hpp>
+
+#include "../csv_content.h"
+#include "../highfive.h"
+#include "../load_network.h"
+#include "../save_network.h"
+#include "saving_initialization.h"
+#include "type_id_defines.h"
+
+
+// Shared parameters are saved for every node, so the file has the same layout as a file with BLIFAT neurons.
+#define PUT_SHARED_NEURON_PARAMETER_TO_DATASET(pop, param, group) \
+    group.createDataSet(#param, std::vector(pop.size(), pop.get_shared_parameters().param))
+
+
+#define LOAD_SHARED_NEURON_PARAMETER(target, parameter, h5_group, pop_size)                                  \
+    do                                                                                                        \
+    {                                                                                                         \
+        const auto values = read_parameter(                                                                   \
+            h5_group, #parameter, pop_size,                                                                   \
+            neuron_traits::default_values<neuron_traits::HomogeneousBLIFATNeuron>::parameter);                \
+        if (!values.empty()) target.parameter = values.front();                                              \
+    } while (false)
+
+
+namespace knp::framework::sonata
+{
+
+template <>
+std::string get_neuron_type_name<neuron_traits::HomogeneousBLIFATNeuron>()
+{
+    return "knp:HomogeneousBlifatNeuron";
+}
+
+
+template <>
+void add_population_to_h5<core::Population<knp::neuron_traits::HomogeneousBLIFATNeuron>>(
+    HighFive::File &file_h5, const core::Population<knp::neuron_traits::HomogeneousBLIFATNeuron> &population)
+{
+    SPDLOG_DEBUG("Saving homogeneous BLIFAT nodes...");
+    auto group0 = initialize_adding_population(population, file_h5);
+
+    // Static.
+    PUT_NEURON_TO_DATASET(population, n_time_steps_since_last_firing_, group0);
+    PUT_NEURON_TO_DATASET(population, postsynaptic_trace_, group0);
+    PUT_NEURON_TO_DATASET(population, inhibitory_conductance_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, activation_threshold_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, threshold_decay_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, threshold_increment_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, postsynaptic_trace_decay_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, postsynaptic_trace_increment_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, inhibitory_conductance_decay_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, potential_decay_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, bursting_period_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, reflexive_weight_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, reversal_inhibitory_potential_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, absolute_refractory_period_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, potential_reset_value_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, min_potential_, group0);
+    PUT_SHARED_NEURON_PARAMETER_TO_DATASET(population, stochastic_stimulation_, group0);
+
+    // Dynamic.
+    auto dynamic_group = group0.createGroup(dynamic_subgroup_name);
+    PUT_NEURON_TO_DATASET(population, dynamic_threshold_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, potential_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, pre_impact_potential_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, bursting_phase_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, total_blocking_period_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, dopamine_value_, dynamic_group);
+    PUT_NEURON_TO_DATASET(population, random_number_generator_state_, dynamic_group);
+}
+
+
+template <>
+core::Population<neuron_traits::HomogeneousBLIFATNeuron> load_population<neuron_traits::HomogeneousBLIFATNeuron>(
+    const HighFive::Group &nodes_group, const std::string &population_name)
+{
+    using NeuronType = neuron_traits::HomogeneousBLIFATNeuron;
+
+    SPDLOG_DEBUG("Loading homogeneous BLIFAT nodes...");
+    auto group0 = nodes_group.getGroup(population_name).getGroup("0");
+    const size_t group_size = nodes_group.getGroup(population_name).getDataSet("node_id").getDimensions().at(0);
+
+    std::vector<neuron_traits::neuron_parameters<NeuronType>> target(group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, n_time_steps_since_last_firing_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, postsynaptic_trace_, group0, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, inhibitory_conductance_, group0, group_size);
+
+    auto dyn_group = group0.getGroup(dynamic_subgroup_name);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, dynamic_threshold_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, pre_impact_potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, bursting_phase_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, total_blocking_period_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, dopamine_value_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, NeuronType, random_number_generator_state_, dyn_group, group_size);
+
+    const knp::core::UID uid{boost::lexical_cast<boost::uuids::uuid>(population_name)};
+    core::Population<NeuronType> out_population(uid, [&target](size_t index) { return target[index]; }, group_size);
+
+    // Values of the first node are used as shared parameters.
+    auto &shared_params = out_population.get_shared_parameters();
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, activation_threshold_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, threshold_decay_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, threshold_increment_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, postsynaptic_trace_decay_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, postsynaptic_trace_increment_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, inhibitory_conductance_decay_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, potential_decay_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, bursting_period_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, reflexive_weight_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, reversal_inhibitory_potential_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, absolute_refractory_period_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, potential_reset_value_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, min_potential_, group0, group_size);
+    LOAD_SHARED_NEURON_PARAMETER(shared_params, stochastic_stimulation_, group0, group_size);
+
+    return out_population;
+}
+
+}  // namespace knp::framework::sonata
@@ -23,6 +23,7 @@
 #include <knp/core/uid.h>
 #include <knp/neuron-traits/blifat.h>
 #include <knp/neuron-traits/stdp_synaptic_resource_rule.h>
+#include <knp/neuron-traits/stdp_type_traits.h>
 
 #include <spdlog/spdlog.h>
 
@@ -46,9 +47,19 @@ std::string get_neuron_type_name<neuron_traits::SynapticResourceSTDPBLIFATNeuron
 
 
 template <>
-void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron>>(
-    HighFive::File &file_h5, const core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population)
+std::string get_neuron_type_name<neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>()
+{
+    return "knp:Float32SynapticResourceRuleBlifatNeuron";
+}
+
+
+template <class BaseNeuron>
+void add_resource_population_to_h5(
+    HighFive::File &file_h5,
+    const core::Population<knp::neuron_traits::SynapticResourceSTDPNeuron<BaseNeuron>> &population)
 {
+    using ResourceNeuron = knp::neuron_traits::SynapticResourceSTDPNeuron<BaseNeuron>;
+
     // TODO: It would be better if such functions were generated automatically.
     SPDLOG_TRACE("Adding population {} to HDF5...", std::string(population.get_uid()));
 
@@ -58,7 +69,7 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
 
     std::vector<size_t> neuron_ids;
     // std::vector<int> neuron_type_ids(
-    //     population.size(), get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>());
+    //     population.size(), get_neuron_type_id<ResourceNeuron>());
 
     neuron_ids.reserve(population.size());
 
@@ -68,8 +79,7 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
     population_group.createDataSet("node_group_index", neuron_ids);
     population_group.createDataSet("node_group_id", std::vector<size_t>(population.size(), 0));
     population_group.createDataSet(
-        "node_type_id",
-        std::vector<size_t>(population.size(), get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>()));
+        "node_type_id", std::vector<size_t>(population.size(), get_neuron_type_id<ResourceNeuron>()));
     auto group0 = population_group.createGroup("0");
 
     // TODO: Need to check if all parameters are the same. If not, then save them into h5.
@@ -130,6 +140,23 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
 }
 
 
+template <>
+void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron>>(
+    HighFive::File &file_h5, const core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population)
+{
+    add_resource_population_to_h5(file_h5, population);
+}
+
+
+template <>
+void add_population_to_h5<core::Population<knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>>(
+    HighFive::File &file_h5,
+    const core::Population<knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron> &population)
+{
+    add_resource_population_to_h5(file_h5, population);
+}
+
+
 #define LOAD_NEURONS_PARAMETER_DEF(target, parameter, h5_group, pop_size, def_neuron)             \
     do                                                                                            \
     {                                                                                             \
@@ -138,21 +165,19 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
     } while (false)
 
 
-using ResourceNeuron = neuron_traits::SynapticResourceSTDPBLIFATNeuron;
-using ResourceNeuronParams = neuron_traits::neuron_parameters<ResourceNeuron>;
-
-
-template <>
-core::Population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>
-load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(
+template <class BaseNeuron>
+core::Population<neuron_traits::SynapticResourceSTDPNeuron<BaseNeuron>> load_resource_population(
     const HighFive::Group &nodes_group, const std::string &population_name)
 {
+    using ResourceNeuron = neuron_traits::SynapticResourceSTDPNeuron<BaseNeuron>;
+    using ResourceNeuronParams = neuron_traits::neuron_parameters<ResourceNeuron>;
+
     SPDLOG_DEBUG("Loading nodes for population {}...", population_name);
     auto group = nodes_group.getGroup(population_name).getGroup("0");
     const size_t group_size = nodes_group.getGroup(population_name).getDataSet("node_id").getDimensions().at(0);
 
     // TODO: Load default neuron from JSON file.
-    ResourceNeuronParams default_params{neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>{}};
+    ResourceNeuronParams default_params{neuron_traits::neuron_parameters<BaseNeuron>{}};
     std::vector<ResourceNeuronParams> target(group_size, default_params);
     // BLIFAT parameters.
     LOAD_NEURONS_PARAMETER_DEF(target, n_time_steps_since_last_firing_, group, group_size, default_params);
@@ -196,17 +221,35 @@ load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(
 
     // Dynamic parameters.
     auto dyn_group = group.getGroup("dynamics_params");
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, dynamic_threshold_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, potential_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, pre_impact_potential_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, bursting_phase_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, total_blocking_period_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, dopamine_value_, dyn_group, group_size);
-    LOAD_NEURONS_PARAMETER(target, neuron_traits::BLIFATNeuron, additional_threshold_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, dynamic_threshold_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, pre_impact_potential_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, bursting_phase_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, total_blocking_period_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, dopamine_value_, dyn_group, group_size);
+    LOAD_NEURONS_PARAMETER(target, BaseNeuron, additional_threshold_, dyn_group, group_size);
 
     const knp::core::UID uid{boost::lexical_cast<boost::uuids::uuid>(population_name)};
     return core::Population<ResourceNeuron>(
         uid, [&target](size_t index) { return target[index]; }, group_size);
 }
 
+
+template <>
+core::Population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>
+load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(
+    const HighFive::Group &nodes_group, const std::string &population_name)
+{
+    return load_resource_population<neuron_traits::BLIFATNeuron>(nodes_group, population_name);
+}
+
+
+template <>
+core::Population<neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>
+load_population<neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>(
+    const HighFive::Group &nodes_group, const std::string &population_name)
+{
+    return load_resource_population<neuron_traits::Float32BLIFATNeuron>(nodes_group, population_name);
+}
+
 }  // namespace knp::framework::sonata
@@ -389,6 +389,22 @@ public:
      */
     [[nodiscard]] size_t projections_count() const { return projections_.size(); }
 
+    /**
+     * @brief Get memory used by the network.
+     * @return memory usage of network populations, projections and tags.
+     */
+    [[nodiscard]] core::MemoryUsage get_memory_usage() const;
+
+    /**
+     * @brief Estimate memory used by a network before its construction.
+     * @param populations estimated memory usage of every network population.
+     * @param projections estimated memory usage of every network projection.
+     * @return estimated memory usage of the network.
+     * @see Population::estimate_memory_usage(), Projection::estimate_memory_usage().
+     */
+    [[nodiscard]] static core::MemoryUsage estimate_memory_usage(
+        const std::vector<core::MemoryUsage> &populations, const std::vector<core::MemoryUsage> &projections);
+
 public:
     /**
      * @brief Get network UID.
@@ -63,4 +63,16 @@ struct WeightAccessor
     void operator()(SynapseParametersType &syn_params, const WeightType &weight) const { syn_params.weight_ = weight; }
 };
 
+
+/**
+ * @brief `WeightAccessor` specialization for synapses with reduced-precision weights.
+ * @details Encoded weights can be decoded only with scale factors of a projection, so the accessor does not provide
+ * access to them, and such synapses are not normalized. Normalize a delta synapse projection before compressing it.
+ * @tparam WeightEncoding weight encoding type.
+ */
+template <typename WeightEncoding>
+struct WeightAccessor<knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>>
+{
+};
+
 }  // namespace knp::framework::normalization
@@ -56,7 +56,7 @@ void normalize_synapses(
     knp::core::Projection<SynapseType> &projection, DataGetter<SynapseType> getter, DataSetter<SynapseType> setter,
     ValueCorrector corrector)
 {
-    for (auto &synapse : projection)
+    for (auto &&synapse : projection)
     {
         auto &synapse_data = std::get<knp::core::synapse_data>(synapse);
         // TODO: replace with DataGetter<ElementType>, when C++23 will be used.
@@ -67,6 +67,7 @@ void normalize_synapses(
 
 /**
  * @brief Normalize parameters of all synapses in a network.
+ * @details Projections whose synapse parameters cannot be read by `DataGetter` are not changed.
  * @tparam DataGetter type of the class containing method to get parameter value.
  * @tparam DataSetter type of the class containing method to set parameter value.
  * @tparam ValueCorrector type of the normalization function for synapse parameters.
@@ -84,9 +85,14 @@ void normalize_synapses(knp::framework::Network &network, ValueCorrector correct
             [&corrector](auto &projection)
             {
                 using SynapseType = typename std::decay_t<decltype(projection)>::ProjectionSynapseType;
-                normalize_synapses<SynapseType, DataGetter, DataSetter>(
-                    const_cast<knp::core::Projection<SynapseType> &>(projection), DataGetter<SynapseType>(),
-                    DataSetter<SynapseType>(), corrector);
+                using SynapseParametersType = typename knp::core::Projection<SynapseType>::SynapseParameters;
+                // Skip projections whose synapse parameters cannot be accessed.
+                if constexpr (std::is_invocable_v<DataGetter<SynapseType>, const SynapseParametersType &>)
+                {
+                    normalize_synapses<SynapseType, DataGetter, DataSetter>(
+                        const_cast<knp::core::Projection<SynapseType> &>(projection), DataGetter<SynapseType>(),
+                        DataSetter<SynapseType>(), corrector);
+                }
             },
             projection_variant);
     }
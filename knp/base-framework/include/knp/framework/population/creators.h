@@ -20,10 +20,13 @@
 #pragma once
 
 #include <knp/core/population.h>
+#include <knp/neuron-traits/homogeneous_blifat.h>
 
 #include <cinttypes>
 #include <optional>
 #include <random>
+#include <stdexcept>
+#include <tuple>
 
 #include "neuron_parameters_generators.h"
 
@@ -97,6 +100,71 @@ template <typename NeuronType>
     return core::Population<NeuronType>(neurons_generators::make_clone<NeuronType>(source_neuron), neuron_count);
 }
 
+
+/**
+ * @brief Generate a population of BLIFAT neurons with shared static parameters from a population of BLIFAT neurons.
+ * @details The new population has the same UID as the source population. Static parameters are taken from the first
+ * neuron of the source population.
+ * @param source_population source population.
+ * @throw std::invalid_argument if static parameters of source population neurons differ.
+ * @return population of homogeneous BLIFAT neurons.
+ */
+[[nodiscard]] inline core::Population<neuron_traits::HomogeneousBLIFATNeuron> make_homogeneous(
+    const core::Population<neuron_traits::BLIFATNeuron>& source_population)
+{
+    auto get_static_parameters = [](const auto& neuron)
+    {
+        return std::make_tuple(
+            neuron.activation_threshold_, neuron.threshold_decay_, neuron.threshold_increment_,
+            neuron.postsynaptic_trace_decay_, neuron.postsynaptic_trace_increment_,
+            neuron.inhibitory_conductance_decay_, neuron.potential_decay_, neuron.reflexive_weight_,
+            neuron.reversal_inhibitory_potential_, neuron.potential_reset_value_, neuron.min_potential_,
+            neuron.stochastic_stimulation_, neuron.bursting_period_, neuron.absolute_refractory_period_);
+    };
+
+    core::Population<neuron_traits::HomogeneousBLIFATNeuron> result(
+        source_population.get_uid(),
+        [&source_population](size_t index)
+        {
+            const auto& neuron = source_population[index];
+            neuron_traits::neuron_parameters<neuron_traits::HomogeneousBLIFATNeuron> state;
+            state.n_time_steps_since_last_firing_ = neuron.n_time_steps_since_last_firing_;
+            state.additional_threshold_ = neuron.additional_threshold_;
+            state.dynamic_threshold_ = neuron.dynamic_threshold_;
+            state.postsynaptic_trace_ = neuron.postsynaptic_trace_;
+            state.inhibitory_conductance_ = neuron.inhibitory_conductance_;
+            state.potential_ = neuron.potential_;
+            state.pre_impact_potential_ = neuron.pre_impact_potential_;
+            state.total_blocking_period_ = neuron.total_blocking_period_;
+            state.dopamine_value_ = neuron.dopamine_value_;
+            state.bursting_phase_ = neuron.bursting_phase_;
+            state.random_number_generator_state_ = neuron.random_number_generator_state_;
+            return state;
+        },
+        source_population.size());
+
+    if (!source_population.size()) return result;
+
+    const auto& first_neuron = source_population[0];
+    const auto static_parameters = get_static_parameters(first_neuron);
+    for (const auto& neuron : source_population)
+    {
+        if (get_static_parameters(neuron) != static_parameters)
+            throw std::invalid_argument("Static parameters of population neurons differ.");
+    }
+
+    auto& shared_params = result.get_shared_parameters();
+    std::tie(
+        shared_params.activation_threshold_, shared_params.threshold_decay_, shared_params.threshold_increment_,
+        shared_params.postsynaptic_trace_decay_, shared_params.postsynaptic_trace_increment_,
+        shared_params.inhibitory_conductance_decay_, shared_params.potential_decay_, shared_params.reflexive_weight_,
+        shared_params.reversal_inhibitory_potential_, shared_params.potential_reset_value_,
+        shared_params.min_potential_, shared_params.stochastic_stimulation_, shared_params.bursting_period_,
+        shared_params.absolute_refractory_period_) = static_parameters;
+
+    return result;
+}
+
 }  // namespace creators
 
 }  // namespace knp::framework::population
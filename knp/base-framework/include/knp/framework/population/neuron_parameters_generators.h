@@ -20,6 +20,7 @@
 #pragma once
 
 #include <knp/core/population.h>
+#include <knp/core/random.h>
 
 #include <cinttypes>
 #include <optional>
@@ -56,7 +57,7 @@ template <typename NeuronType, template <typename...> class Container>
 
 /**
  * @brief Generate neurons with random parameter values.
- * @details This generator uses MT19937 RNG with uniform integer distribution.
+ * @details Parameter values of a neuron depend only on the neuron index and the generator seed.
  * @warning Neuron parameter values are absolutely random: generator doesn't pay attention to the limits.
  * @tparam NeuronType type of neuron parameters.
  */
@@ -66,8 +67,9 @@ class MakeRandom
 public:
     /**
      * @brief Constructor.
+     * @param seed random generator seed.
      */
-    MakeRandom() : mt_(std::random_device()()), dist_(0, 255) {}
+    explicit MakeRandom(uint64_t seed = std::random_device()()) : random_(seed) {}
 
     /**
      * @brief Call operator.
@@ -77,13 +79,18 @@ public:
     [[nodiscard]] typename core::Population<NeuronType>::NeuronParameters operator()(size_t index)
     {
         typename core::Population<NeuronType>::NeuronParameters params;
-        for (size_t i = 0; i < sizeof(params); ++i) reinterpret_cast<uint8_t*>(&params)[i] = dist_(mt_);
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(params); ++i)
+        {
+            // Each random value fills 8 bytes of parameters.
+            if (i % sizeof(value) == 0) value = random_(index, i / sizeof(value));
+            reinterpret_cast<uint8_t*>(&params)[i] = static_cast<uint8_t>(value >> (8 * (i % sizeof(value))));
+        }
         return params;
     }
 
 private:
-    std::mt19937 mt_;
-    std::uniform_int_distribution<int> dist_;
+    knp::core::CounterBasedRandom random_;
 };
 
 
@@ -21,13 +21,18 @@
 #pragma once
 
 #include <knp/core/projection.h>
+#include <knp/synapse-traits/compressed_delta.h>
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <random>
+#include <stdexcept>
 #include <tuple>
+#include <vector>
 
 #include "synapse_generators.h"
 #include "synapse_parameters_generators.h"
@@ -337,4 +342,76 @@ template <typename DestinationSynapseType, typename SourceSynapseType>
         source_proj.size());
 }
 
+
+/**
+ * @brief Create a projection with reduced-precision weights from a delta synapse projection.
+ * @details Scale factors are selected so that the maximum absolute weight of the source projection or of each
+ * presynaptic neuron can be encoded. The new projection has the same UID as the source projection.
+ * @tparam WeightEncoding weight encoding type.
+ * @param source_proj source projection.
+ * @param per_presynaptic_scale if `true`, use a separate scale factor for synapses of each presynaptic neuron.
+ * @throw std::out_of_range if a synapse delay does not fit into 16 bits.
+ * @return projection of the `knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>` synapses.
+ */
+template <typename WeightEncoding>
+[[nodiscard]] knp::core::Projection<knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>> compress_projection(
+    const knp::core::Projection<knp::synapse_traits::DeltaSynapse> &source_proj, bool per_presynaptic_scale = false)
+{
+    using ResultSynapseType = knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>;
+    using ResultProjectionType = knp::core::Projection<ResultSynapseType>;
+
+    const auto &weights = source_proj.get_synapses_parameters();
+    const auto &presynaptic_indexes = source_proj.get_presynaptic_indexes();
+
+    // Compressed synapses store 16-bit delays.
+    for (const auto &params : weights)
+    {
+        if (params.delay_ > std::numeric_limits<uint16_t>::max())
+            throw std::out_of_range("Synapse delay does not fit into a compressed synapse.");
+    }
+
+    ResultProjectionType result(source_proj.get_uid(), source_proj.get_presynaptic(), source_proj.get_postsynaptic());
+    auto &shared_params = result.get_shared_parameters().synapses_parameters_;
+
+    if (per_presynaptic_scale)
+    {
+        std::vector<float> max_weights;
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            const auto presynaptic_index = presynaptic_indexes[i];
+            if (presynaptic_index >= max_weights.size()) max_weights.resize(presynaptic_index + 1, 0.0F);
+            max_weights[presynaptic_index] = std::max(max_weights[presynaptic_index], std::fabs(weights[i].weight_));
+        }
+        shared_params.presynaptic_scales_.reserve(max_weights.size());
+        for (const auto max_weight : max_weights)
+            shared_params.presynaptic_scales_.push_back(WeightEncoding::get_scale(max_weight));
+    }
+    else
+    {
+        float max_weight = 0;
+        for (const auto &params : weights) max_weight = std::max(max_weight, std::fabs(params.weight_));
+        shared_params.scale_ = WeightEncoding::get_scale(max_weight);
+    }
+
+    result.add_synapses(
+        [&source_proj, &shared_params](size_t index) -> std::optional<typename ResultProjectionType::Synapse>
+        {
+            const auto synapse = source_proj[index];
+            const auto &params = std::get<knp::core::synapse_data>(synapse);
+            const auto presynaptic_index = std::get<knp::core::source_neuron_id>(synapse);
+            return typename ResultProjectionType::Synapse{
+                {shared_params.encode_weight(params.weight_, presynaptic_index), static_cast<uint16_t>(params.delay_),
+                 params.output_type_},
+                presynaptic_index, std::get<knp::core::target_neuron_id>(synapse)};
+        },
+        source_proj.size());
+
+    if (source_proj.is_locked())
+        result.lock_weights();
+    else
+        result.unlock_weights();
+
+    return result;
+}
+
 }  // namespace knp::framework::projection::creators
@@ -22,6 +22,7 @@
 
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/core/random.h>
 
 #include <algorithm>
 #include <exception>
@@ -237,17 +238,18 @@ public:
      * @param postsynaptic_pop_size postsynaptic population neuron count.
      * @param connection_probability connection probability.
      * @param syn_gen generator of synapse parameters.
+     * @param seed random generator seed. Generators with the same seed make the same connections.
      */
     FixedProbability(
         size_t presynaptic_pop_size, size_t postsynaptic_pop_size, double connection_probability,
         parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
-            parameters_generators::default_synapse_gen<SynapseType>)
+            parameters_generators::default_synapse_gen<SynapseType>,
+        uint64_t seed = std::random_device()())
         : presynaptic_pop_size_(presynaptic_pop_size),
           postsynaptic_pop_size_(postsynaptic_pop_size),
           connection_probability_(connection_probability),
           syn_gen_(syn_gen),
-          mt_(std::random_device()()),
-          dist_(0, 1)
+          random_(seed)
     {
         if (connection_probability > 1 || connection_probability < 0)
             throw std::logic_error("Incorrect probability, set probability between 0 and 1.");
@@ -263,7 +265,8 @@ public:
         const size_t index0 = index % presynaptic_pop_size_;
         const size_t index1 = index / presynaptic_pop_size_;
 
-        if (dist_(mt_) < connection_probability_) return std::make_tuple(syn_gen_(index0, index1), index0, index1);
+        if (random_.uniform(index) < connection_probability_)
+            return std::make_tuple(syn_gen_(index0, index1), index0, index1);
         return std::nullopt;
     }
 
@@ -272,8 +275,7 @@ private:
     size_t postsynaptic_pop_size_;
     double connection_probability_;
     parameters_generators::SynGen2ParamsType<SynapseType> syn_gen_;
-    std::mt19937 mt_;
-    std::uniform_real_distribution<double> dist_;
+    knp::core::CounterBasedRandom random_;
 };
 
 
@@ -307,7 +309,7 @@ template <typename SynapseType>
 /**
  * @brief The FixedNumberPost class is a definition of a generator that makes connections between each presynaptic
  * neuron and a fixed number of random postsynaptic neurons.
- * @details This connector uses MT19937 generator with uniform integer distribution.
+ * @details Random postsynaptic neuron index depends only on the synapse index and the generator seed.
  * @warning It doesn't get "real" populations and can't be used with populations that contain non-contiguous indexes.
  * @tparam SynapseType projection synapse type.
  */
@@ -320,16 +322,17 @@ public:
      * @param presynaptic_pop_size presynaptic population neuron count.
      * @param postsynaptic_pop_size postsynaptic population neuron count.
      * @param syn_gen generator of synapse parameters.
+     * @param seed random generator seed. Generators with the same seed make the same connections.
      */
     FixedNumberPost(
         size_t presynaptic_pop_size, size_t postsynaptic_pop_size,
         std::function<typename knp::core::Projection<SynapseType>::SynapseParameters(size_t index0, size_t index1)>
-            syn_gen = parameters_generators::default_synapse_gen<SynapseType>)
+            syn_gen = parameters_generators::default_synapse_gen<SynapseType>,
+        uint64_t seed = std::random_device()())
         : presynaptic_pop_size_(presynaptic_pop_size),
           postsynaptic_pop_size_(postsynaptic_pop_size),
           syn_gen_(syn_gen),
-          mt_(std::random_device()()),
-          dist_(0, postsynaptic_pop_size - 1)
+          random_(seed)
     {
     }
 
@@ -341,7 +344,7 @@ public:
     [[nodiscard]] typename std::optional<typename knp::core::Projection<SynapseType>::Synapse> operator()(size_t index)
     {
         const size_t index0 = index % presynaptic_pop_size_;
-        const size_t index1 = dist_(mt_);
+        const size_t index1 = random_.uniform_int(index, 0, postsynaptic_pop_size_);
 
         return std::make_tuple(syn_gen_(index0, index1), index0, index1);
     }
@@ -350,15 +353,14 @@ private:
     size_t presynaptic_pop_size_;
     size_t postsynaptic_pop_size_;
     parameters_generators::SynGen2ParamsType<SynapseType> syn_gen_;
-    std::mt19937 mt_;
-    std::uniform_int_distribution<size_t> dist_;
+    knp::core::CounterBasedRandom random_;
 };
 
 
 /**
  * @brief The FixedNumberPre class is a definition of a generator that makes connections between each postsynaptic
  * neuron and a fixed number of random presynaptic neurons.
- * @details This uses MT19937 generator with uniform integer distribution.
+ * @details Random presynaptic neuron index depends only on the synapse index and the generator seed.
  * @warning It doesn't get "real" populations and can't be used with populations that contain non-contiguous indexes.
  * @tparam SynapseType projection synapse type.
  */
@@ -371,16 +373,17 @@ public:
      * @param presynaptic_pop_size presynaptic population neuron count.
      * @param postsynaptic_pop_size postsynaptic population neuron count.
      * @param syn_gen generator of synapse parameters.
+     * @param seed random generator seed. Generators with the same seed make the same connections.
      */
     FixedNumberPre(
         size_t presynaptic_pop_size, size_t postsynaptic_pop_size,
         std::function<typename knp::core::Projection<SynapseType>::SynapseParameters(size_t index0, size_t index1)>
-            syn_gen = parameters_generators::default_synapse_gen<SynapseType>)
+            syn_gen = parameters_generators::default_synapse_gen<SynapseType>,
+        uint64_t seed = std::random_device()())
         : presynaptic_pop_size_(presynaptic_pop_size),
           postsynaptic_pop_size_(postsynaptic_pop_size),
           syn_gen_(syn_gen),
-          mt_(std::random_device()()),
-          dist_(0, presynaptic_pop_size - 1)
+          random_(seed)
     {
     }
 
@@ -391,7 +394,7 @@ public:
      */
     [[nodiscard]] typename std::optional<typename knp::core::Projection<SynapseType>::Synapse> operator()(size_t index)
     {
-        const size_t index0 = dist_(mt_);
+        const size_t index0 = random_.uniform_int(index, 0, presynaptic_pop_size_);
         const size_t index1 = index % postsynaptic_pop_size_;
 
         return std::make_tuple(syn_gen_(index0, index1), index0, index1);
@@ -401,8 +404,7 @@ private:
     size_t presynaptic_pop_size_;
     size_t postsynaptic_pop_size_;
     parameters_generators::SynGen2ParamsType<SynapseType> syn_gen_;
-    std::mt19937 mt_;
-    std::uniform_int_distribution<size_t> dist_;
+    knp::core::CounterBasedRandom random_;
 };
 
 
@@ -54,6 +54,19 @@ Backend::~Backend()
 }
 
 
+MemoryUsage Backend::get_memory_usage() const
+{
+    MemoryUsage result;
+    for (const auto &subscription : message_endpoint_.get_endpoint_subscriptions())
+    {
+        result.queues_ += std::visit(
+            [](const auto &sub) { return get_messages_memory_usage(sub.get_messages()); }, subscription.second);
+    }
+    result.tags_ = base_.tags_.get_memory_usage();
+    return result;
+}
+
+
 void Backend::pre_start()
 {
     if (running())
@@ -83,6 +96,7 @@ void Backend::start()
         {
             _step();
         }
+        flush_weight_changes();
     }
     catch (...)
     {
@@ -103,6 +117,7 @@ void Backend::start(const RunPredicate& run_predicate)
         {
             _step();
         }
+        flush_weight_changes();
     }
     catch (...)
     {
@@ -131,6 +146,7 @@ void Backend::start(const RunPredicate& pre_step, const RunPredicate& post_step)
                 break;
             }
         }
+        flush_weight_changes();
     }
     catch (...)
     {
@@ -62,7 +62,10 @@ std::pair<size_t, UID> MessageEndpoint::get_subscription_key(const MessageEndpoi
 MessageEndpoint::MessageEndpoint(MessageEndpoint &&endpoint) noexcept
     : impl_(std::move(endpoint.impl_)),
       subscriptions_(std::move(endpoint.subscriptions_)),
-      senders_(std::move(endpoint.senders_))
+      senders_(std::move(endpoint.senders_)),
+      sender_handles_(std::move(endpoint.sender_handles_)),
+      receiver_handles_(std::move(endpoint.receiver_handles_)),
+      routes_outdated_(std::move(endpoint.routes_outdated_))
 {
 }
 
@@ -81,6 +84,7 @@ Subscription<MessageType> &MessageEndpoint::subscribe(const UID &receiver, const
 
     if (!senders_) senders_ = std::make_shared<std::unordered_set<knp::core::UID, knp::core::uid_hash>>();
     senders_->insert(senders.begin(), senders.end());
+    *routes_outdated_ = true;
 
     if (iter != subscriptions_.end())
     {
@@ -92,23 +96,37 @@ Subscription<MessageType> &MessageEndpoint::subscribe(const UID &receiver, const
     auto sub_variant = SubscriptionVariant{Subscription<MessageType>{receiver, senders}};
     auto insert_res = subscriptions_.emplace(std::make_pair(index, receiver), sub_variant);
     auto &sub = std::get<index>(insert_res.first->second);
+    watch_senders(sub);
     return sub;
 }
 
 
+template <class MessageType>
+void MessageEndpoint::watch_senders(Subscription<MessageType> &subscription)
+{
+    // The handler must not capture the endpoint, because the endpoint can be moved.
+    subscription.set_senders_handler(
+        [senders = std::weak_ptr{senders_}, routes_outdated = routes_outdated_](const UID &sender, bool is_added)
+        {
+            *routes_outdated = true;
+            // The bus must pass messages from new senders. Removed senders are dropped when routes are updated,
+            // because other subscriptions can receive messages from them.
+            if (auto senders_ptr = senders.lock(); senders_ptr && is_added) senders_ptr->insert(sender);
+        });
+}
+
+
 template <typename MessageType>
 bool MessageEndpoint::unsubscribe(const UID &receiver)
 {
     SPDLOG_DEBUG("Unsubscribing {}...", std::string(receiver));
     constexpr auto index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
     auto iter = subscriptions_.find(std::make_pair(index, receiver));
-    if (iter != subscriptions_.end())
-    {
-        subscriptions_.erase(iter);
-        return true;
-    }
+    if (iter == subscriptions_.end()) return false;
+
+    subscriptions_.erase(iter);
     update_senders();
-    return false;
+    return true;
 }
 
 
@@ -116,11 +134,15 @@ void MessageEndpoint::remove_receiver(const UID &receiver)
 {
     SPDLOG_DEBUG("Removing receiver {}...", std::string(receiver));
 
-    for (auto sub_iter = subscriptions_.begin(); sub_iter != subscriptions_.end(); ++sub_iter)
+    for (auto sub_iter = subscriptions_.begin(); sub_iter != subscriptions_.end();)
     {
         if (get_receiver_uid(sub_iter->second) == receiver)
         {
-            subscriptions_.erase(sub_iter);
+            sub_iter = subscriptions_.erase(sub_iter);
+        }
+        else
+        {
+            ++sub_iter;
         }
     }
     update_senders();
@@ -151,32 +173,33 @@ bool MessageEndpoint::receive_message()
 
     SPDLOG_TRACE("Subscription count = {}.", subscriptions_.size());
 
-    // Find a subscription.
-    for (auto &&[k, sub_variant] : subscriptions_)
+    if (*routes_outdated_) update_routes();
+
+    // Sender UID is translated to a handle once, subscriptions are found by the handle.
+    const UIDHandle sender_handle = sender_handles_.get_handle(sender_uid);
+    if (sender_handle == invalid_uid_handle)
     {
-        if (sub_variant.index() != type_index)
+        SPDLOG_TRACE("No subscriptions for sender with UID {}.", std::string(sender_uid));
+        return true;
+    }
+
+    for (auto *sub_variant : routes_[sender_handle])
+    {
+        if (sub_variant->index() != type_index)
         {
             SPDLOG_TRACE(
                 "Subscription message type index does not match the message type index [{} != {}].",
-                sub_variant.index(), type_index);
+                sub_variant->index(), type_index);
             continue;
         }
 
         std::visit(
-            [&sender_uid, &message](auto &&subscription)
+            [&message](auto &&subscription)
             {
-                SPDLOG_TRACE("Sender UID: {}.", std::string(sender_uid));
-                if (subscription.has_sender(sender_uid))
-                {
-                    SPDLOG_TRACE("Subscription has sender with UID {}.", std::string(sender_uid));
-                    subscription.add_message(
-                        std::get<typename std::decay_t<decltype(subscription)>::MessageType>(message));
-                    SPDLOG_TRACE("Message was added to the subscription {}.", std::string(sender_uid));
-                }
+                subscription.add_message(std::get<typename std::decay_t<decltype(subscription)>::MessageType>(message));
             },
-            sub_variant);
-
-        // sub_variant.swap(v);
+            *sub_variant);
+        SPDLOG_TRACE("Message was added to the subscription {}.", std::string(get_receiver_uid(*sub_variant)));
     }
 
     return true;
@@ -219,6 +242,33 @@ std::vector<MessageType> MessageEndpoint::unload_messages(const knp::core::UID &
 }
 
 
+template <class MessageType>
+std::vector<MessageType> MessageEndpoint::unload_messages(UIDHandle receiver_handle)
+{
+    constexpr size_t index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
+
+    if (*routes_outdated_) update_routes();
+    if (receiver_handle >= receiver_routes_.size()) return {};
+
+    for (auto *sub_variant : receiver_routes_[receiver_handle])
+    {
+        if (sub_variant->index() != index) continue;
+        Subscription<MessageType> &subscription = std::get<index>(*sub_variant);
+        auto result = std::move(subscription.get_messages());
+        subscription.clear_messages();
+        return result;
+    }
+
+    return {};
+}
+
+
+UIDHandle MessageEndpoint::get_receiver_handle(const UID &receiver)
+{
+    return receiver_handles_.register_uid(receiver);
+}
+
+
 void MessageEndpoint::update_senders()
 {
     if (!senders_) senders_ = std::make_shared<std::unordered_set<knp::core::UID, knp::core::uid_hash>>();
@@ -227,19 +277,56 @@ void MessageEndpoint::update_senders()
     new_senders.reserve(senders_->size());
     for (const auto &sub : subscriptions_)
     {
-        auto sub_senders = std::visit([](auto &sub_var) { return sub_var.get_senders(); }, sub.second);
+        const auto &sub_senders =
+            std::visit([](auto &sub_var) -> const auto & { return sub_var.get_senders(); }, sub.second);
         new_senders.insert(sub_senders.begin(), sub_senders.end());
     }
+    *senders_ = std::move(new_senders);
+    *routes_outdated_ = true;
+}
+
+
+void MessageEndpoint::update_routes()
+{
+    // Senders removed from subscriptions are still in the set.
+    update_senders();
+    sender_handles_.clear();
+    routes_.clear();
+    receiver_routes_.clear();
+
+    for (auto &sub : subscriptions_)
+    {
+        std::visit(
+            [this, &sub](const auto &subscription)
+            {
+                for (const auto &sender_uid : subscription.get_senders())
+                {
+                    const UIDHandle handle = sender_handles_.register_uid(sender_uid);
+                    if (handle >= routes_.size()) routes_.resize(handle + 1);
+                    routes_[handle].push_back(&sub.second);
+                }
+            },
+            sub.second);
+
+        const UIDHandle receiver_handle = receiver_handles_.register_uid(get_receiver_uid(sub.second));
+        if (receiver_handle >= receiver_routes_.size()) receiver_routes_.resize(receiver_handle + 1);
+        receiver_routes_[receiver_handle].push_back(&sub.second);
+    }
+
+    *routes_outdated_ = false;
 }
 
 
 namespace cm = knp::core::messaging;
 
-#define INSTANCE_MESSAGES_FUNCTIONS(n, template_for_instance, message_type)                \
-    template Subscription<cm::message_type> &MessageEndpoint::subscribe<cm::message_type>( \
-        const UID &receiver, const std::vector<UID> &senders);                             \
-    template bool MessageEndpoint::unsubscribe<cm::message_type>(const UID &receiver);     \
-    template std::vector<cm::message_type> MessageEndpoint::unload_messages<cm::message_type>(const UID &receiver_uid);
+#define INSTANCE_MESSAGES_FUNCTIONS(n, template_for_instance, message_type)                    \
+    template Subscription<cm::message_type> &MessageEndpoint::subscribe<cm::message_type>(     \
+        const UID &receiver, const std::vector<UID> &senders);                                 \
+    template bool MessageEndpoint::unsubscribe<cm::message_type>(const UID &receiver);         \
+    template std::vector<cm::message_type> MessageEndpoint::unload_messages<cm::message_type>( \
+        const UID &receiver_uid);                                                              \
+    template std::vector<cm::message_type> MessageEndpoint::unload_messages<cm::message_type>( \
+        UIDHandle receiver_handle);
 
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_MESSAGES_FUNCTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_MESSAGES))
 
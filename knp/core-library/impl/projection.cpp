@@ -23,6 +23,13 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
 
 // Index functions.
 template <class Index, class Connection>
@@ -49,56 +56,98 @@ std::vector<size_t> find_indexes_by_type(const Index &val, size_t neuron_index)
 }
 
 
-/**
- * @brief Remove a synapse with a given index.
- * @param index index of a synapse.
- * @return true if an element was found and erased.
- */
-template <class Index, class Projection>
-bool erase_synapse(Index &val, size_t index)
+// Synapse list functions.
+template <class NeuronIndexes, class SynapseIndexes>
+void build_synapse_lists(
+    const NeuronIndexes &neuron_indexes, SynapseIndexes &offsets, SynapseIndexes &synapses_by_neuron)
 {
-    auto num_erased = val.template get<typename Projection::mi_synapse_index>().erase(index);
-    return num_erased > 0;
+    // Counting sort of synapses by neuron, synapses of a neuron keep their order.
+    const size_t neurons_count =
+        neuron_indexes.empty() ? 0 : *std::max_element(neuron_indexes.cbegin(), neuron_indexes.cend()) + size_t{1};
+    offsets.assign(neurons_count + 1, 0);
+    for (const auto neuron_index : neuron_indexes) ++offsets[neuron_index + 1];
+    std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+
+    synapses_by_neuron.resize(neuron_indexes.size());
+    std::vector<size_t> positions(offsets.cbegin(), offsets.cend() - 1);
+    for (size_t i = 0; i < neuron_indexes.size(); ++i)
+    {
+        synapses_by_neuron[positions[neuron_indexes[i]]++] = i;
+    }
 }
 
 
-/**
- * @brief Remove elements by their indexes in a single pass.
- * @tparam T value type.
- * @param data vector that will be modified by deletion.
- * @param to_remove indexes of the elements to remove
- * @warning Indexes must be sorted.
- */
-template <class T, class IndexContainer>
-void remove_by_index(std::vector<T> &data, const IndexContainer &to_remove)
+// Plasticity state functions.
+template <class SharedParameters>
+size_t get_shared_plasticity_memory_usage(const SharedParameters &)
+{
+    return 0;
+}
+
+
+template <class SynapseType>
+size_t get_shared_plasticity_memory_usage(
+    const knp::synapse_traits::shared_synapse_parameters<
+        knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, SynapseType>> &params)
+{
+    return knp::core::get_heap_memory_usage(params.presynaptic_traces_) +
+           knp::core::get_heap_memory_usage(params.postsynaptic_traces_) +
+           knp::core::get_heap_memory_usage(params.pending_weight_changes_) +
+           knp::core::get_heap_memory_usage(params.pending_synapses_);
+}
+
+
+// Deferred weight change functions.
+template <class SharedParameters, class SynapsesContainer>
+void apply_pending_weight_changes(SharedParameters &, SynapsesContainer &)
 {
-    if (to_remove.empty()) return;
+}
+
 
-    size_t cor_counter = 0;
-    for (const auto rem_index : to_remove)
+template <class SynapseType, class SynapsesContainer>
+void apply_pending_weight_changes(
+    knp::synapse_traits::shared_synapse_parameters<
+        knp::synapse_traits::STDP<knp::synapse_traits::STDPAdditiveRule, SynapseType>> &params,
+    SynapsesContainer &synapses_parameters)
+{
+    for (const auto synapse_index : params.pending_synapses_)
     {
-        data.erase(std::next(data.begin(), rem_index - cor_counter++));
+        synapses_parameters[synapse_index].weight_ += params.pending_weight_changes_[synapse_index];
+        params.pending_weight_changes_[synapse_index] = 0;
     }
+    params.pending_synapses_.clear();
+}
+
 
-    // Cool but incorrect (MSVC\14.40.33807\include\vector(56) : Assertion failed: can't dereference out of range vector
-    // iterator):
-    // size_t removed = 0;
-    // auto next_to_remove = to_remove.begin();
-    // size_t index = *next_to_remove;
-    // while (index + removed < data.size())
-    //{
-    //    while (index + removed == *next_to_remove)
-    //    {
-    //        ++next_to_remove;
-    //        ++removed;
-    //    }
-    //    data[index] = std::move(data[index + removed]);
-    //    ++index;
-    //}
-    // data.resize(data.size() - removed);
+template <class SharedParameters>
+size_t get_shared_heap_memory_usage(const SharedParameters &)
+{
+    return 0;
+}
+
+
+template <class WeightEncoding>
+size_t get_shared_heap_memory_usage(
+    const knp::synapse_traits::shared_synapse_parameters<knp::synapse_traits::CompressedDeltaSynapse<WeightEncoding>>
+        &params)
+{
+    return knp::core::get_heap_memory_usage(params.presynaptic_scales_);
 }
 
 
+template <class SharedParameters, class = void>
+struct has_stdp_populations : std::false_type
+{
+};
+
+
+template <class SharedParameters>
+struct has_stdp_populations<SharedParameters, std::void_t<decltype(SharedParameters::stdp_populations_)>>
+    : std::true_type
+{
+};
+
+
 namespace knp::core
 {
 using Connection = typename std::tuple<size_t, size_t, size_t>;
@@ -137,7 +186,7 @@ Projection<SynapseType>::Projection(
     {
         if (auto params = generator(i))
         {
-            parameters_.emplace_back(std::move(params.value()));
+            push_back_synapse(std::move(params.value()));
         }
     }
     reindex();
@@ -157,8 +206,7 @@ Projection<SynapseType>::Projection(
     {
         if (auto params = generator(i))
         {
-            auto &&[p, id_from, id_to] = std::move(params.value());
-            parameters_.emplace_back(Synapse{std::move(p), id_from, id_to});
+            push_back_synapse(std::move(params.value()));
         }
     }
     reindex();
@@ -188,18 +236,127 @@ std::vector<size_t> knp::core::Projection<SynapseType>::find_synapses(
 }
 
 
+template <typename SynapseType>
+typename knp::core::Projection<SynapseType>::SynapseIndexRange
+knp::core::Projection<SynapseType>::get_presynaptic_synapses(size_t neuron_index) const
+{
+    update_presynaptic_synapses();
+    if (neuron_index + 1 >= presynaptic_offsets_.size())
+    {
+        return {synapses_by_presynaptic_.cend(), synapses_by_presynaptic_.cend()};
+    }
+    return {synapses_by_presynaptic_.cbegin() + presynaptic_offsets_[neuron_index],
+            synapses_by_presynaptic_.cbegin() + presynaptic_offsets_[neuron_index + 1]};
+}
+
+
+template <typename SynapseType>
+typename knp::core::Projection<SynapseType>::SynapseIndexRange
+knp::core::Projection<SynapseType>::get_postsynaptic_synapses(size_t neuron_index) const
+{
+    update_postsynaptic_synapses();
+    if (neuron_index + 1 >= postsynaptic_offsets_.size())
+    {
+        return {synapses_by_postsynaptic_.cend(), synapses_by_postsynaptic_.cend()};
+    }
+    return {synapses_by_postsynaptic_.cbegin() + postsynaptic_offsets_[neuron_index],
+            synapses_by_postsynaptic_.cbegin() + postsynaptic_offsets_[neuron_index + 1]};
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::flush_weight_changes()
+{
+    apply_pending_weight_changes(shared_parameters_.synapses_parameters_, parameters_);
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::order_synapses_by_delay()
+{
+    // Pending weight changes are indexed by synapse.
+    flush_weight_changes();
+    const auto key = [this](size_t index)
+    { return std::make_tuple(presynaptic_indexes_[index], parameters_[index].delay_, postsynaptic_indexes_[index]); };
+    // Ordered synapses are not copied, so applying a storage policy again is cheap.
+    size_t unordered_index = 1;
+    while (unordered_index < parameters_.size() && !(key(unordered_index) < key(unordered_index - 1)))
+        ++unordered_index;
+    if (unordered_index >= parameters_.size()) return;
+
+    std::vector<size_t> order(parameters_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin(), order.end(), [&key](size_t first, size_t second) { return key(first) < key(second); });
+
+    is_index_updated_ = false;
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
+    // Reordered arrays keep the storage policy of the projection.
+    SynapsesContainer parameters(parameters_.get_allocator());
+    NeuronIndexContainer presynaptic_indexes(presynaptic_indexes_.get_allocator());
+    NeuronIndexContainer postsynaptic_indexes(postsynaptic_indexes_.get_allocator());
+    parameters.reserve(order.size());
+    presynaptic_indexes.reserve(order.size());
+    postsynaptic_indexes.reserve(order.size());
+    for (const auto index : order)
+    {
+        parameters.push_back(std::move(parameters_[index]));
+        presynaptic_indexes.push_back(presynaptic_indexes_[index]);
+        postsynaptic_indexes.push_back(postsynaptic_indexes_[index]);
+    }
+    parameters_ = std::move(parameters);
+    presynaptic_indexes_ = std::move(presynaptic_indexes);
+    postsynaptic_indexes_ = std::move(postsynaptic_indexes);
+}
+
+
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::add_synapses(
     SynapseGenerator generator, size_t num_iterations)  //!OCLINT(Parameters used)
 {
+    flush_weight_changes();
     const size_t starting_size = parameters_.size();
     is_index_updated_ = false;
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
     for (size_t i = 0; i < num_iterations; ++i)
     {
         if (auto data = generator(i))
         {
-            parameters_.emplace_back(std::move(data.value()));
+            push_back_synapse(std::move(data.value()));
+        }
+    }
+    return parameters_.size() - starting_size;
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::add_synapses(const std::vector<Synapse> &synapses)
+{
+    flush_weight_changes();
+    const size_t starting_size = parameters_.size();
+    parameters_.reserve(starting_size + synapses.size());
+    presynaptic_indexes_.reserve(starting_size + synapses.size());
+    postsynaptic_indexes_.reserve(starting_size + synapses.size());
+
+    const bool was_index_updated = is_index_updated_;
+    // Basic exception safety.
+    is_index_updated_ = false;
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
+    for (auto synapse : synapses)
+    {
+        push_back_synapse(std::move(synapse));
+    }
+
+    if (was_index_updated)
+    {
+        for (size_t i = starting_size; i < parameters_.size(); ++i)
+        {
+            insert_to_index(index_, Connection{presynaptic_indexes_[i], postsynaptic_indexes_[i], i});
         }
+        is_index_updated_ = true;
     }
     return parameters_.size() - starting_size;
 }
@@ -208,53 +365,176 @@ size_t knp::core::Projection<SynapseType>::add_synapses(
 template <typename SynapseType>
 void Projection<SynapseType>::clear()
 {
+    flush_weight_changes();
     parameters_.clear();
+    presynaptic_indexes_.clear();
+    postsynaptic_indexes_.clear();
     index_.clear();
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
 }
 
 
 template <typename SynapseType>
 void knp::core::Projection<SynapseType>::remove_synapse(size_t index)  //!OCLINT
 {
+    if (index >= parameters_.size()) throw std::out_of_range("Synapse index is out of range.");
+    flush_weight_changes();
+
+    // Indexes of all the following synapses change, so the index and synapse lists are rebuilt on the next search.
     is_index_updated_ = false;
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
+
     parameters_.erase(parameters_.begin() + index);
+    presynaptic_indexes_.erase(presynaptic_indexes_.begin() + index);
+    postsynaptic_indexes_.erase(postsynaptic_indexes_.begin() + index);
 }
 
 
 template <typename SynapseType>
-size_t knp::core::Projection<SynapseType>::remove_synapse_if(std::function<bool(const Synapse &)> predicate)  //!OCLINT
+size_t knp::core::Projection<SynapseType>::remove_synapses(const std::vector<size_t> &indexes)  //!OCLINT
 {
-    const size_t starting_size = parameters_.size();
-    is_index_updated_ = false;
-    parameters_.resize(std::remove_if(parameters_.begin(), parameters_.end(), predicate) - parameters_.begin());
-    return starting_size - parameters_.size();
+    std::vector<bool> to_remove(parameters_.size(), false);
+    for (const auto index : indexes)
+    {
+        if (index >= to_remove.size()) throw std::out_of_range("Synapse index is out of range.");
+        to_remove[index] = true;
+    }
+    return remove_marked_synapses(to_remove);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_synapse_if(  //!OCLINT
+    std::function<bool(const SynapseConstReference &)> predicate)
+{
+    std::vector<bool> to_remove(parameters_.size(), false);
+    for (size_t i = 0; i < to_remove.size(); ++i)
+    {
+        to_remove[i] = predicate(std::as_const(*this)[i]);
+    }
+    return remove_marked_synapses(to_remove);
 }
 
 
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::remove_postsynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
 {
+    return remove_neuron_synapses(neuron_index, Search::by_postsynaptic);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+{
+    return remove_neuron_synapses(neuron_index, Search::by_presynaptic);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_neuron_synapses(size_t neuron_index, Search search_method)
+{
+    std::vector<bool> to_remove(parameters_.size(), false);
+    if (is_index_updated_)
+    {
+        for (const auto index : find_synapses(neuron_index, search_method)) to_remove[index] = true;
+    }
+    else
+    {
+        // Scanning a single index array is cheaper than building the whole index.
+        const auto &neuron_indexes =
+            Search::by_presynaptic == search_method ? presynaptic_indexes_ : postsynaptic_indexes_;
+        for (size_t i = 0; i < neuron_indexes.size(); ++i) to_remove[i] = (neuron_indexes[i] == neuron_index);
+    }
+    return remove_marked_synapses(to_remove);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_marked_synapses(const std::vector<bool> &to_remove)
+{
+    flush_weight_changes();
     const size_t starting_size = parameters_.size();
-    bool was_index_updated = is_index_updated_;
+    const bool was_index_updated = is_index_updated_;
     // Basic exception safety.
     is_index_updated_ = false;
-    auto synapses_to_remove = find_synapses(neuron_index, Search::by_postsynaptic);
-    std::sort(synapses_to_remove.begin(), synapses_to_remove.end());
-    remove_by_index(parameters_, synapses_to_remove);
-    if (was_index_updated)
-        for (auto &synapse : synapses_to_remove) index_.erase(synapse);
+    is_presynaptic_synapses_updated_ = false;
+    is_postsynaptic_synapses_updated_ = false;
+
+    auto &index_by_synapse = index_.template get<mi_synapse_index>();
+
+    // Stable compaction of all the synapse arrays at once. Synapses are processed in increasing order, so the new
+    // index of a synapse is always free in the synapse index.
+    size_t new_size = 0;
+    for (size_t i = 0; i < starting_size; ++i)
+    {
+        if (to_remove[i])
+        {
+            if (was_index_updated) index_by_synapse.erase(i);
+            continue;
+        }
+        if (new_size != i)
+        {
+            parameters_[new_size] = std::move(parameters_[i]);
+            presynaptic_indexes_[new_size] = presynaptic_indexes_[i];
+            postsynaptic_indexes_[new_size] = postsynaptic_indexes_[i];
+            if (was_index_updated)
+            {
+                auto iter = index_by_synapse.find(i);
+                index_by_synapse.modify(iter, [new_size](Connection &connection) { connection.index_ = new_size; });
+            }
+        }
+        ++new_size;
+    }
+
+    parameters_.resize(new_size);
+    presynaptic_indexes_.resize(new_size);
+    postsynaptic_indexes_.resize(new_size);
 
     is_index_updated_ = was_index_updated;
-    return starting_size - parameters_.size();
+    return starting_size - new_size;
 }
 
 
 template <typename SynapseType>
-size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+MemoryUsage knp::core::Projection<SynapseType>::get_memory_usage() const
 {
-    // TODO: We now have a way to find them quickly, make use of it instead of disconnect_if.
-    return remove_synapse_if([neuron_index](const Synapse &synapse)
-                             { return std::get<knp::core::source_neuron_id>(synapse) == neuron_index; });
+    MemoryUsage result;
+    result.parameters_ = sizeof(*this) + get_heap_memory_usage(parameters_) +
+                         get_heap_memory_usage(presynaptic_indexes_) + get_heap_memory_usage(postsynaptic_indexes_) +
+                         get_shared_heap_memory_usage(shared_parameters_.synapses_parameters_);
+    result.index_ = index_.size() * index_node_size + (index_.template get<mi_presynaptic>().bucket_count() +
+                                                       index_.template get<mi_postsynaptic>().bucket_count() +
+                                                       index_.template get<mi_synapse_index>().bucket_count()) *
+                                                          sizeof(void *);
+    result.index_ += get_heap_memory_usage(presynaptic_offsets_) + get_heap_memory_usage(synapses_by_presynaptic_) +
+                     get_heap_memory_usage(postsynaptic_offsets_) + get_heap_memory_usage(synapses_by_postsynaptic_);
+
+    result.plasticity_ += get_shared_plasticity_memory_usage(shared_parameters_.synapses_parameters_);
+    if constexpr (has_stdp_populations<SharedSynapseParameters>::value)
+    {
+        const auto &stdp_populations = shared_parameters_.stdp_populations_;
+        result.plasticity_ +=
+            stdp_populations.bucket_count() * sizeof(void *) +
+            stdp_populations.size() *
+                (sizeof(typename std::decay_t<decltype(stdp_populations)>::value_type) + 2 * sizeof(void *));
+    }
+
+    result.tags_ = base_.tags_.get_memory_usage();
+    return result;
+}
+
+
+template <typename SynapseType>
+MemoryUsage knp::core::Projection<SynapseType>::estimate_memory_usage(size_t synapses_count)
+{
+    MemoryUsage result;
+    result.parameters_ = sizeof(Projection) + synapses_count * (sizeof(SynapseParameters) +
+                                                                 2 * sizeof(typename NeuronIndexContainer::value_type));
+    // Each hashed index has at least one bucket per element.
+    result.index_ = synapses_count * (index_node_size + 3 * sizeof(void *));
+    return result;
 }
 
 
@@ -269,16 +549,52 @@ void knp::core::Projection<SynapseType>::reindex() const
     index_.clear();
     for (size_t i = 0; i < parameters_.size(); ++i)
     {
-        auto &synapse = parameters_[i];
-        insert_to_index(
-            index_,
-            Connection{
-                std::get<knp::core::source_neuron_id>(synapse), std::get<knp::core::target_neuron_id>(synapse), i});
+        insert_to_index(index_, Connection{presynaptic_indexes_[i], postsynaptic_indexes_[i], i});
     }
     is_index_updated_ = true;
 }
 
 
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::update_presynaptic_synapses() const
+{
+    if (is_presynaptic_synapses_updated_)
+    {
+        return;
+    }
+    build_synapse_lists(presynaptic_indexes_, presynaptic_offsets_, synapses_by_presynaptic_);
+    is_presynaptic_synapses_updated_ = true;
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::update_postsynaptic_synapses() const
+{
+    if (is_postsynaptic_synapses_updated_)
+    {
+        return;
+    }
+    build_synapse_lists(postsynaptic_indexes_, postsynaptic_offsets_, synapses_by_postsynaptic_);
+    is_postsynaptic_synapses_updated_ = true;
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::push_back_synapse(Synapse &&synapse)
+{
+    auto &&[params, id_from, id_to] = synapse;
+    constexpr size_t max_neuron_index = std::numeric_limits<uint32_t>::max();
+    if (id_from > max_neuron_index || id_to > max_neuron_index)
+    {
+        throw std::out_of_range("Neuron index of a synapse does not fit into 32 bits.");
+    }
+
+    parameters_.emplace_back(std::move(params));
+    presynaptic_indexes_.push_back(static_cast<uint32_t>(id_from));
+    postsynaptic_indexes_.push_back(static_cast<uint32_t>(id_to));
+}
+
+
 #define INSTANCE_PROJECTIONS(n, template_for_instance, synapse_type) \
     template class knp::core::Projection<knp::synapse_traits::synapse_type>;
 
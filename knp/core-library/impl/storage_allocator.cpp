@@ -0,0 +1,263 @@
+/**
+ * @file storage_allocator.cpp
+ * @brief Storage allocation implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/storage_allocator.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+
+namespace knp::core
+{
+
+namespace
+{
+
+// Check if an array is mapped instead of being allocated by `operator new`.
+bool is_mapped_storage(size_t bytes, const StoragePolicy *policy)
+{
+#if defined(__linux__)
+    if (!policy || bytes == 0 || bytes < policy->min_mapped_bytes_) return false;
+    return policy->pages_ != StoragePages::standard || policy->numa_placement_ != StorageNumaPlacement::first_touch ||
+           !policy->backing_directory_.empty();
+#else
+    return false;
+#endif
+}
+
+
+#if defined(__linux__)
+
+// Size of huge pages used for anonymous mappings.
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+
+// Check if huge pages are requested for an anonymous mapping. File-backed mappings always use default pages.
+bool is_huge_page_storage(const StoragePolicy &policy)
+{
+    return policy.pages_ != StoragePages::standard && policy.backing_directory_.empty();
+}
+
+
+// Get the size of pages of mappings created with the policy.
+size_t get_page_size(const StoragePolicy *policy)
+{
+    static const auto default_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return policy && is_huge_page_storage(*policy) ? huge_page_size : default_page_size;
+}
+
+
+// Huge page mappings are rounded to the huge page size, so that they can be freed with the same size. Other mappings
+// are rounded to the default page size.
+size_t get_mapped_size(size_t bytes, const StoragePolicy &policy)
+{
+    const size_t page_size = get_page_size(&policy);
+    return (bytes + page_size - 1) / page_size * page_size;
+}
+
+
+// Open an unnamed temporary file of the given size.
+int open_backing_file(const std::filesystem::path &directory, size_t bytes)
+{
+    std::string file_name = (directory / "knp-storage-XXXXXX").string();
+    const int file = mkstemp(file_name.data());
+    if (file < 0) return -1;
+    // The file is removed when it is unmapped.
+    unlink(file_name.c_str());
+    if (ftruncate(file, static_cast<off_t>(bytes)) != 0)
+    {
+        close(file);
+        return -1;
+    }
+    return file;
+}
+
+
+// Maximum number of NUMA nodes in a node mask.
+constexpr unsigned long max_nodes = 64;
+
+
+// Read a mask of NUMA nodes that have memory. Returns `0` if the system does not report nodes.
+unsigned long read_memory_node_mask()
+{
+    std::ifstream file("/sys/devices/system/node/has_memory");
+    if (!file) file.open("/sys/devices/system/node/online");
+    std::string node_list;
+    std::getline(file, node_list);
+
+    // Node list format: `0-3,8`.
+    unsigned long result = 0;
+    std::istringstream stream(node_list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        unsigned long first = 0;
+        unsigned long last = 0;
+        char dash = 0;
+        std::istringstream range_stream(range);
+        if (!(range_stream >> first)) continue;
+        if (!(range_stream >> dash >> last)) last = first;
+        for (auto node = first; node <= last && node < max_nodes; ++node) result |= 1UL << node;
+    }
+    return result;
+}
+
+
+// Values from `linux/mempolicy.h`. The system call is used directly, so the library does not depend on libnuma.
+constexpr int mpol_preferred = 1;
+constexpr int mpol_interleave = 3;
+constexpr unsigned mpol_mf_move = 2;
+
+
+bool set_memory_policy(void *pointer, size_t bytes, int mode, unsigned long node_mask, unsigned flags)
+{
+    return syscall(SYS_mbind, pointer, bytes, mode, &node_mask, max_nodes + 1, flags) == 0;
+}
+
+
+void apply_numa_placement(void *pointer, size_t bytes, const StoragePolicy &policy)
+{
+
+    unsigned long node_mask = 0;
+    int mode = 0;
+    switch (policy.numa_placement_)
+    {
+        case StorageNumaPlacement::first_touch:
+            return;
+        case StorageNumaPlacement::interleave:
+        {
+            // Nodes do not change while the process runs.
+            static const unsigned long memory_node_mask = read_memory_node_mask();
+            if (memory_node_mask == 0) return;
+            mode = mpol_interleave;
+            node_mask = memory_node_mask;
+            break;
+        }
+        case StorageNumaPlacement::preferred_node:
+            if (policy.numa_node_ >= max_nodes) return;
+            mode = mpol_preferred;
+            node_mask = 1UL << policy.numa_node_;
+            break;
+    }
+    if (!set_memory_policy(pointer, bytes, mode, node_mask, 0))
+    {
+        SPDLOG_WARN("NUMA placement is not applied to storage of {} bytes.", bytes);
+    }
+}
+
+#endif
+
+}  // namespace
+
+
+void *allocate_storage(size_t bytes, const StoragePolicy *policy)
+{
+    if (!is_mapped_storage(bytes, policy)) return ::operator new(bytes);
+
+#if defined(__linux__)
+    const size_t mapped_bytes = get_mapped_size(bytes, *policy);
+    void *result = MAP_FAILED;
+    if (!policy->backing_directory_.empty())
+    {
+        const int file = open_backing_file(policy->backing_directory_, mapped_bytes);
+        if (file < 0) throw std::bad_alloc();
+        result = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        close(file);
+    }
+    else
+    {
+        if (policy->pages_ == StoragePages::explicit_huge)
+        {
+            result = mmap(
+                nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (result == MAP_FAILED)
+            {
+                SPDLOG_DEBUG("No free huge pages for storage of {} bytes, default pages are used.", bytes);
+            }
+        }
+        if (result == MAP_FAILED)
+        {
+            result = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (result != MAP_FAILED && policy->pages_ != StoragePages::standard)
+            {
+                // Transparent huge pages are only a hint: the storage is still valid if it is ignored.
+                madvise(result, mapped_bytes, MADV_HUGEPAGE);
+            }
+        }
+    }
+    if (result == MAP_FAILED) throw std::bad_alloc();
+    // Without read-ahead, a row access reads only the pages of the row.
+    if (!policy->read_ahead_) madvise(result, mapped_bytes, MADV_RANDOM);
+
+    // The policy is set before the pages are touched, so it applies to all of them.
+    apply_numa_placement(result, mapped_bytes, *policy);
+    return result;
+#else
+    return ::operator new(bytes);
+#endif
+}
+
+
+void deallocate_storage(void *pointer, size_t bytes, const StoragePolicy *policy) noexcept
+{
+    if (!is_mapped_storage(bytes, policy))
+    {
+        ::operator delete(pointer);
+        return;
+    }
+#if defined(__linux__)
+    munmap(pointer, get_mapped_size(bytes, *policy));
+#endif
+}
+
+
+void bind_storage_to_node(
+    [[maybe_unused]] const void *pointer, [[maybe_unused]] size_t bytes, [[maybe_unused]] unsigned node,
+    [[maybe_unused]] const StoragePolicy *policy) noexcept
+{
+#if defined(__linux__)
+    if (node >= max_nodes) return;
+    // Only pages that lie entirely inside the range are bound, so neighbouring data keeps its placement. A huge page
+    // cannot be split between nodes, so ranges of huge page storage are aligned to huge pages.
+    const auto page_size = static_cast<uintptr_t>(get_page_size(policy));
+    const auto begin = (reinterpret_cast<uintptr_t>(pointer) + page_size - 1) / page_size * page_size;
+    const auto end = (reinterpret_cast<uintptr_t>(pointer) + bytes) / page_size * page_size;
+    if (end <= begin) return;
+    // Pages that are already touched are moved to the node.
+    if (!set_memory_policy(reinterpret_cast<void *>(begin), end - begin, mpol_preferred, 1UL << node, mpol_mf_move))
+    {
+        SPDLOG_DEBUG("Storage range of {} bytes is not bound to NUMA node {}.", end - begin, node);
+    }
+#endif
+}
+
+}  // namespace knp::core
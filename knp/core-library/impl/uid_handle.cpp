@@ -0,0 +1,58 @@
+/**
+ * @file uid_handle.cpp
+ * @brief UID handle registry implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/uid_handle.h>
+
+#include <stdexcept>
+
+
+namespace knp::core
+{
+
+UIDHandle UIDHandleRegistry::register_uid(const UID &uid)
+{
+    auto iter = handles_.find(uid);
+    if (iter != handles_.end()) return iter->second;
+
+    if (uids_.size() >= invalid_uid_handle) throw std::overflow_error("Too many UIDs to assign handles.");
+
+    const auto handle = static_cast<UIDHandle>(uids_.size());
+    handles_.emplace(uid, handle);
+    uids_.push_back(uid);
+    return handle;
+}
+
+
+UIDHandle UIDHandleRegistry::get_handle(const UID &uid) const
+{
+    auto iter = handles_.find(uid);
+    if (iter == handles_.end()) return invalid_uid_handle;
+    return iter->second;
+}
+
+
+void UIDHandleRegistry::clear()
+{
+    handles_.clear();
+    uids_.clear();
+}
+
+}  // namespace knp::core
@@ -23,6 +23,7 @@
 
 #include <knp/core/core.h>
 #include <knp/core/device.h>
+#include <knp/core/memory_usage.h>
 #include <knp/core/message_bus.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
@@ -256,6 +257,13 @@ public:
      */
     virtual void start_learning() = 0;
 
+    /**
+     * @brief Apply weight changes that learning rules defer to synapses.
+     * @details The method is called when network execution stops. Call it to read up-to-date synapse weights while
+     * the network is executed.
+     */
+    virtual void flush_weight_changes() {}
+
 public:
     /**
      * @brief Get network execution status.
@@ -361,6 +369,14 @@ public:
      */
     [[nodiscard]] virtual DataRanges get_network_data() const = 0;
 
+    /**
+     * @brief Get memory used by the backend.
+     * @details Base implementation counts messages stored in the backend endpoint and backend tags. Backends add
+     * memory used by the loaded populations and projections and by their internal message queues.
+     * @return memory usage of backend components.
+     */
+    [[nodiscard]] virtual MemoryUsage get_memory_usage() const;
+
 protected:
     /**
      * @brief Backend default constructor.
@@ -0,0 +1,61 @@
+/**
+ * @file heap_memory_usage.h
+ * @brief Heap memory usage of standard containers.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief Get size of the vector buffer.
+ * @tparam T vector value type.
+ * @tparam Allocator vector allocator type.
+ * @param container vector.
+ * @return number of bytes allocated by the vector.
+ */
+template <class T, class Allocator>
+[[nodiscard]] size_t get_heap_memory_usage(const std::vector<T, Allocator> &container)
+{
+    return container.capacity() * sizeof(T);
+}
+
+
+/**
+ * @brief Get size of the string buffer.
+ * @param str string.
+ * @return number of bytes allocated by the string, `0` if the string uses the small string buffer.
+ */
+[[nodiscard]] inline size_t get_heap_memory_usage(const std::string &str)
+{
+    const auto *object_begin = reinterpret_cast<const char *>(&str);
+    const bool is_local = str.data() >= object_begin && str.data() < object_begin + sizeof(str);
+    return is_local ? 0 : str.capacity() + 1;
+}
+
+}  // namespace knp::core
@@ -0,0 +1,206 @@
+/**
+ * @file memory_usage.h
+ * @brief Memory usage accounting.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/heap_memory_usage.h>
+#include <knp/core/messaging/messaging.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief The MemoryUsage structure contains the number of bytes used by entity components.
+ * @details Values are estimates: they include sizes of objects and their heap buffers, but do not include the
+ * allocator overhead.
+ */
+struct MemoryUsage
+{
+    /**
+     * @brief Memory used by neuron and synapse parameters, including synapse connection indexes.
+     */
+    size_t parameters_ = 0;
+
+    /**
+     * @brief Memory used by the projection index that is used to search synapses.
+     */
+    size_t index_ = 0;
+
+    /**
+     * @brief Memory used by message queues.
+     */
+    size_t queues_ = 0;
+
+    /**
+     * @brief Memory used by the plasticity state, for example, by spike histories of STDP synapses.
+     */
+    size_t plasticity_ = 0;
+
+    /**
+     * @brief Memory used by entity tags.
+     */
+    size_t tags_ = 0;
+
+    /**
+     * @brief Get total memory usage.
+     * @return sum of memory usages of all components in bytes.
+     */
+    [[nodiscard]] size_t total() const { return parameters_ + index_ + queues_ + plasticity_ + tags_; }
+
+    /**
+     * @brief Add memory usage of another entity.
+     * @param other memory usage to add.
+     * @return reference to this memory usage.
+     */
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        parameters_ += other.parameters_;
+        index_ += other.index_;
+        queues_ += other.queues_;
+        plasticity_ += other.plasticity_;
+        tags_ += other.tags_;
+        return *this;
+    }
+
+    /**
+     * @brief Get sum of two memory usages.
+     * @param other memory usage to add.
+     * @return memory usage that contains sums of components.
+     */
+    [[nodiscard]] MemoryUsage operator+(const MemoryUsage &other) const
+    {
+        MemoryUsage result = *this;
+        result += other;
+        return result;
+    }
+};
+
+
+/**
+ * @brief Get heap memory used by a spike message.
+ * @param message spike message.
+ * @return number of bytes allocated by the message.
+ */
+[[nodiscard]] inline size_t get_heap_memory_usage(const messaging::SpikeMessage &message)
+{
+    return get_heap_memory_usage(message.neuron_indexes_);
+}
+
+
+/**
+ * @brief Get heap memory used by a synaptic impact message.
+ * @param message synaptic impact message.
+ * @return number of bytes allocated by the message.
+ */
+[[nodiscard]] inline size_t get_heap_memory_usage(const messaging::SynapticImpactMessage &message)
+{
+    return get_heap_memory_usage(message.impacts_);
+}
+
+
+/**
+ * @brief Get memory used by a vector of messages.
+ * @tparam MessageType message type.
+ * @param messages messages.
+ * @return number of bytes used by the vector and the messages.
+ */
+template <class MessageType>
+[[nodiscard]] size_t get_messages_memory_usage(const std::vector<MessageType> &messages)
+{
+    size_t result = get_heap_memory_usage(messages);
+    for (const auto &message : messages) result += get_heap_memory_usage(message);
+    return result;
+}
+
+
+/**
+ * @brief Get memory used by a message queue that maps steps to messages.
+ * @tparam KeyType queue key type.
+ * @tparam MessageType message type.
+ * @param queue message queue.
+ * @return number of bytes used by the queue and the messages.
+ */
+template <class KeyType, class MessageType>
+[[nodiscard]] size_t get_messages_memory_usage(const std::unordered_map<KeyType, MessageType> &queue)
+{
+    // Every element is stored in a separate node with a pointer to the next node.
+    size_t result = queue.bucket_count() * sizeof(void *) +
+                    queue.size() * (sizeof(typename std::unordered_map<KeyType, MessageType>::value_type) +
+                                    sizeof(void *) + sizeof(size_t));
+    for (const auto &[key, message] : queue) result += get_heap_memory_usage(message);
+    return result;
+}
+
+
+/**
+ * @brief Get memory used by entities stored in a vector.
+ * @details Entities are populations or projections. Entity objects are counted as a part of the vector buffer.
+ * @tparam Container type of the entity vector.
+ * @tparam GetVariant type of the function that returns an entity variant for a vector element.
+ * @param entities entities.
+ * @param get_variant function that returns an entity variant for a vector element.
+ * @return memory usage of the vector and the entities.
+ */
+template <class Container, class GetVariant>
+[[nodiscard]] MemoryUsage get_entities_memory_usage(const Container &entities, GetVariant get_variant)
+{
+    MemoryUsage result;
+    result.parameters_ = get_heap_memory_usage(entities);
+    for (const auto &element : entities)
+    {
+        const auto &entity_variant = get_variant(element);
+        auto usage = std::visit([](const auto &entity) { return entity.get_memory_usage(); }, entity_variant);
+        usage.parameters_ -= std::visit([](const auto &entity) { return sizeof(entity); }, entity_variant);
+        result += usage;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Estimate memory used by entities that will be stored in a vector.
+ * @details Entity estimates are usually returned by `Population::estimate_memory_usage()` and
+ * `Projection::estimate_memory_usage()`. They include entity object sizes, so the result can exceed the real memory
+ * usage by the size of an entity object per entity.
+ * @tparam ElementType type of vector elements.
+ * @param estimates estimated memory usage of every entity.
+ * @return estimated memory usage of the vector and the entities.
+ */
+template <class ElementType>
+[[nodiscard]] MemoryUsage estimate_entities_memory_usage(const std::vector<MemoryUsage> &estimates)
+{
+    MemoryUsage result;
+    result.parameters_ = estimates.size() * sizeof(ElementType);
+    for (const auto &estimate : estimates) result += estimate;
+    return result;
+}
+
+}  // namespace knp::core
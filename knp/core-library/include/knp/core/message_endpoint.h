@@ -25,6 +25,7 @@
 #include <knp/core/messaging/messaging.h>
 #include <knp/core/subscription.h>
 #include <knp/core/uid.h>
+#include <knp/core/uid_handle.h>
 
 #include <any>
 #include <chrono>
@@ -130,7 +131,8 @@ public:
     /**
      * @brief Add a subscription to messages of the specified type from senders with given UIDs.
      * @note If the subscription for the specified receiver and message type already exists, the method updates the list
-     * of senders in the subscription.
+     * of senders in the subscription. Senders can also be added to or removed from the returned subscription, the
+     * endpoint updates its routing on the next received message.
      * @tparam MessageType type of messages to which the receiver subscribes via the subscription.
      * @param receiver receiver UID.
      * @param senders vector of sender UIDs.
@@ -184,6 +186,26 @@ public:
     template <class MessageType>
     std::vector<MessageType> unload_messages(const knp::core::UID &receiver_uid);
 
+    /**
+     * @brief Read messages of the specified type received via subscription.
+     * @details Use this method in step loops to avoid a search of the subscription by the receiver UID.
+     * @note After reading the messages, the method clears them from the subscription.
+     * @tparam MessageType type of messages to read.
+     * @param receiver_handle receiver handle returned by `get_receiver_handle()`.
+     * @return vector of messages.
+     */
+    template <class MessageType>
+    std::vector<MessageType> unload_messages(UIDHandle receiver_handle);
+
+    /**
+     * @brief Get a handle of the receiver with the given UID.
+     * @details The handle remains valid during the lifetime of the endpoint, even if the receiver subscriptions are
+     * removed or added again.
+     * @param receiver receiver UID.
+     * @return receiver handle.
+     */
+    UIDHandle get_receiver_handle(const UID &receiver);
+
 public:
     /**
      * @brief Type of subscription container.
@@ -230,10 +252,49 @@ private:
     std::shared_ptr<std::unordered_set<knp::core::UID, knp::core::uid_hash>> senders_ =
         std::make_shared<std::unordered_set<knp::core::UID, knp::core::uid_hash>>();
 
+    /**
+     * @brief Handles of all senders that this endpoint receives messages from.
+     */
+    UIDHandleRegistry sender_handles_;
+
+    /**
+     * @brief Subscriptions of every sender, indexed by the sender handle.
+     */
+    std::vector<std::vector<SubscriptionVariant *>> routes_;
+
+    /**
+     * @brief Handles of receivers that were requested by `get_receiver_handle()` or have subscriptions.
+     */
+    UIDHandleRegistry receiver_handles_;
+
+    /**
+     * @brief Subscriptions of every receiver, indexed by the receiver handle.
+     */
+    std::vector<std::vector<SubscriptionVariant *>> receiver_routes_;
+
+    /**
+     * @brief `true` if the routing tables don't reflect the current subscriptions.
+     * @details The flag is shared with subscriptions, which set it when their senders change.
+     */
+    std::shared_ptr<bool> routes_outdated_ = std::make_shared<bool>(true);
+
     /**
      * @brief Update list of senders.
      */
     void update_senders();
+
+    /**
+     * @brief Rebuild sender handles and routing tables from the subscriptions.
+     */
+    void update_routes();
+
+    /**
+     * @brief Make the subscription notify the endpoint about changes of its senders.
+     * @tparam MessageType type of messages received via the subscription.
+     * @param subscription subscription to watch.
+     */
+    template <class MessageType>
+    void watch_senders(Subscription<MessageType> &subscription);
 };
 
 }  // namespace knp::core
@@ -22,11 +22,16 @@
 #pragma once
 
 #include <knp/core/core.h>
+#include <knp/core/memory_usage.h>
 #include <knp/core/messaging/synaptic_impact_message.h>
+#include <knp/core/storage_allocator.h>
 #include <knp/core/uid.h>
 #include <knp/neuron-traits/all_traits.h>
 
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -58,6 +63,11 @@ public:
      */
     using NeuronParameters = neuron_traits::neuron_parameters<NeuronType>;
 
+    /**
+     * @brief Parameters shared between all neurons of the population.
+     */
+    using SharedNeuronParameters = neuron_traits::shared_neuron_parameters<NeuronType>;
+
     /**
      * @brief Type of the neuron generator.
      * @param index current neuron index.
@@ -67,7 +77,7 @@ public:
     /**
      * @brief Real neurons container type.
      */
-    using NeuronsContainer = std::vector<NeuronParameters>;
+    using NeuronsContainer = std::vector<NeuronParameters, StorageAllocator<NeuronParameters>>;
 
     /**
      * @brief Iterator for neurons.
@@ -114,9 +124,15 @@ public:  // NOLINT
 public:  // NOLINT
     /**
      * @brief Get parameters of all neurons in the population.
+     * @details Neuron parameters are kept in storage allocated according to the storage policy of the population, so
+     * they are copied to a vector with the default allocator.
+     * @note Copy method. Use iterators or `operator[]` to access neuron parameters without copying.
      * @return vector of neuron parameters.
      */
-    [[nodiscard]] const std::vector<NeuronParameters> &get_neurons_parameters() const { return neurons_; }
+    [[nodiscard]] std::vector<NeuronParameters> get_neurons_parameters() const
+    {
+        return {neurons_.begin(), neurons_.end()};
+    }
 
     /**
      * @brief Get parameters of the specific neuron in the population.
@@ -137,14 +153,49 @@ public:  // NOLINT
      * @param parameters vector of neuron parameters.
      * @note Copy method.
      */
-    void set_neurons_parameters(const std::vector<NeuronParameters> &parameters) { neurons_ = parameters; }
+    void set_neurons_parameters(const std::vector<NeuronParameters> &parameters)
+    {
+        neurons_.assign(parameters.begin(), parameters.end());
+    }
+
+    /**
+     * @brief Set parameters for all neurons in the population.
+     * @param parameters vector of neuron parameters.
+     * @note Copy method. Neuron parameters keep the storage policy of the population.
+     */
+    void set_neurons_parameters(const NeuronsContainer &parameters)
+    {
+        neurons_.assign(parameters.begin(), parameters.end());
+    }
 
     /**
      * @brief Set parameters for all neurons in the population.
      * @param parameters vector of neuron parameters.
      * @note Move method.
      */
-    void set_neurons_parameters(std::vector<NeuronParameters> &&parameters) { neurons_ = std::move(parameters); }
+    void set_neurons_parameters(std::vector<NeuronParameters> &&parameters)
+    {
+        neurons_.assign(std::make_move_iterator(parameters.begin()), std::make_move_iterator(parameters.end()));
+    }
+
+    /**
+     * @brief Move neuron parameters to storage allocated according to a policy.
+     * @param policy storage policy. If `nullptr`, parameters are allocated by `operator new`.
+     */
+    void set_storage_policy(const std::shared_ptr<const StoragePolicy> &policy) { move_to_storage(neurons_, policy); }
+
+    /**
+     * @brief Get parameters shared between all neurons.
+     * @return shared parameters.
+     */
+    SharedNeuronParameters &get_shared_parameters() { return shared_parameters_; }
+
+    /**
+     * @brief Get parameters shared between all neurons.
+     * @note Constant method.
+     * @return shared parameters.
+     */
+    const SharedNeuronParameters &get_shared_parameters() const { return shared_parameters_; }
 
 public:  // NOLINT
     /**
@@ -182,15 +233,21 @@ public:  // NOLINT
 
     /**
      * @brief Remove neurons with given indexes from the population.
-     * @param neuron_indexes indexes of neurons to remove.
+     * @details Neurons and their tags are removed in a single pass, the order of the remaining neurons does not change.
+     * @param neuron_indexes indexes of neurons to remove. Indexes can be unsorted and repeated.
+     * @throw std::out_of_range if a neuron index is not less than the population size.
      */
     void remove_neurons(const std::vector<size_t> &neuron_indexes)
     {
-        size_t index_shift = 0;
-        for (const auto &index : neuron_indexes)
+        std::vector<bool> to_remove(neurons_.size(), false);
+        for (const auto index : neuron_indexes)
         {
-            remove_neuron(index - index_shift++);
+            if (index >= to_remove.size()) throw std::out_of_range("Neuron index is out of range.");
+            to_remove[index] = true;
         }
+
+        remove_marked(neurons_, to_remove);
+        if (auto *neuron_tags = find_neuron_tags(); neuron_tags) remove_marked(*neuron_tags, to_remove);
     }
 
     /**
@@ -202,6 +259,8 @@ public:  // NOLINT
         auto iter = neurons_.begin();
         std::advance(iter, neuron_index);
         neurons_.erase(iter);
+        if (auto *neuron_tags = find_neuron_tags(); neuron_tags && neuron_index < neuron_tags->size())
+            neuron_tags->erase(neuron_tags->begin() + static_cast<std::ptrdiff_t>(neuron_index));
     }
 
 public:  // NOLINT
@@ -247,9 +306,55 @@ public:  // NOLINT
      */
     [[nodiscard]] size_t size() const { return neurons_.size(); }
 
+    /**
+     * @brief Get memory used by the population.
+     * @return memory usage of population components.
+     */
+    [[nodiscard]] MemoryUsage get_memory_usage() const
+    {
+        MemoryUsage result;
+        result.parameters_ = sizeof(*this) + get_heap_memory_usage(neurons_);
+        result.tags_ = base_.tags_.get_memory_usage();
+        return result;
+    }
+
+    /**
+     * @brief Estimate memory used by a population before its construction.
+     * @param neurons_count number of neurons in the population.
+     * @return estimated memory usage of population components.
+     */
+    [[nodiscard]] static MemoryUsage estimate_memory_usage(size_t neurons_count)
+    {
+        MemoryUsage result;
+        result.parameters_ = sizeof(Population) + neurons_count * sizeof(NeuronParameters);
+        return result;
+    }
+
+private:
+    // Neuron tags are stored in the same order as neurons.
+    std::vector<TagMap> *find_neuron_tags()
+    {
+        return base_.tags_.template find_tag<std::vector<TagMap>>("neuron_tags");
+    }
+
+    // Stable removal of marked elements in a single pass.
+    template <class Container>
+    static void remove_marked(Container &container, const std::vector<bool> &to_remove)
+    {
+        size_t new_size = 0;
+        for (size_t i = 0; i < container.size(); ++i)
+        {
+            if (i < to_remove.size() && to_remove[i]) continue;
+            if (new_size != i) container[new_size] = std::move(container[i]);
+            ++new_size;
+        }
+        container.resize(new_size);
+    }
+
 private:
     BaseData base_;
     NeuronsContainer neurons_;
+    SharedNeuronParameters shared_parameters_;
 };
 
 
@@ -22,20 +22,26 @@
 #pragma once
 
 #include <knp/core/core.h>
+#include <knp/core/memory_usage.h>
+#include <knp/core/storage_allocator.h>
 #include <knp/core/uid.h>
 #include <knp/synapse-traits/all_traits.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
+#include <boost/range/iterator_range.hpp>
 
 
 /**
@@ -65,6 +71,9 @@ enum SynapseElementAccess
 
 /**
  * @brief The Projection class is a definition of similar connections between the neurons of two populations.
+ * @details Synapse parameters, presynaptic and postsynaptic neuron indexes are stored in three separate arrays.
+ * Synapse parameters are not split into weight, delay and output type arrays, because parameter structures differ
+ * between synapse types.
  * @todo This class should later be divided to interface and implementation classes.
  * @tparam SynapseType type of synapses the projection contains.
  * @see ALL_SYNAPSES.
@@ -91,20 +100,92 @@ public:
      */
     using Synapse = std::tuple<SynapseParameters, size_t, size_t>;
 
+    /**
+     * @brief Reference to a synapse stored in the projection.
+     * @details Synapse parameters and neuron indexes are stored in separate arrays, so a synapse is accessed via a
+     * tuple of references. Use `std::get` with `SynapseElementAccess` values to access synapse elements.
+     */
+    using SynapseReference = std::tuple<SynapseParameters &, uint32_t &, uint32_t &>;
+
+    /**
+     * @brief Constant reference to a synapse stored in the projection.
+     */
+    using SynapseConstReference = std::tuple<const SynapseParameters &, const uint32_t &, const uint32_t &>;
+
     /**
      * @brief Synapse generation function type.
      */
     using SynapseGenerator = std::function<std::optional<Synapse>(size_t)>;
 
     /**
-     * @brief Type of the container that contains synapses.
+     * @brief Type of the container that contains synapse parameters.
+     */
+    using SynapsesContainer = std::vector<SynapseParameters, StorageAllocator<SynapseParameters>>;
+
+    /**
+     * @brief Type of the container that contains neuron indexes of synapses.
      */
-    using SynapsesContainer = std::vector<Synapse>;
+    using NeuronIndexContainer = std::vector<uint32_t, StorageAllocator<uint32_t>>;
+
+    /**
+     * @brief Type of the container that contains synapse indexes.
+     */
+    using SynapseIndexContainer = std::vector<size_t, StorageAllocator<size_t>>;
+
+    /**
+     * @brief Range of synapse indexes stored in the projection.
+     */
+    using SynapseIndexRange = boost::iterator_range<SynapseIndexContainer::const_iterator>;
+
+    /**
+     * @brief Iterator over projection synapses.
+     * @tparam ProjectionT projection type, possibly constant.
+     * @tparam ReferenceT synapse reference type returned by the iterator.
+     */
+    template <typename ProjectionT, typename ReferenceT>
+    class SynapseIterator
+        : public boost::iterator_facade<
+              SynapseIterator<ProjectionT, ReferenceT>, Synapse, boost::random_access_traversal_tag, ReferenceT>
+    {
+    public:
+        /**
+         * @brief Default constructor.
+         */
+        SynapseIterator() = default;
+
+        /**
+         * @brief Create an iterator pointing to a synapse with the given index.
+         * @param projection projection to iterate.
+         * @param index synapse index.
+         */
+        SynapseIterator(ProjectionT *projection, size_t index) : projection_(projection), index_(index) {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        ReferenceT dereference() const { return (*projection_)[index_]; }
+        bool equal(const SynapseIterator &other) const { return index_ == other.index_; }
+        void increment() { ++index_; }
+        void decrement() { --index_; }
+        void advance(std::ptrdiff_t n) { index_ += n; }
+        std::ptrdiff_t distance_to(const SynapseIterator &other) const
+        {
+            return static_cast<std::ptrdiff_t>(other.index_) - static_cast<std::ptrdiff_t>(index_);
+        }
+
+        ProjectionT *projection_ = nullptr;
+        size_t index_ = 0;
+    };
 
     /**
      * @brief Iterator for synapses.
      */
-    using iterator = typename SynapsesContainer::iterator;
+    using iterator = SynapseIterator<Projection, SynapseReference>;
+
+    /**
+     * @brief Constant iterator for synapses.
+     */
+    using const_iterator = SynapseIterator<const Projection, SynapseConstReference>;
 
 public:
     /**
@@ -222,41 +303,93 @@ public:
     /**
      * @brief Get parameter values of a synapse with the given index.
      * @param index synapse index.
-     * @return synapse parameters and indexes.
+     * @return references to synapse parameters and indexes.
      */
-    [[nodiscard]] Synapse &operator[](size_t index) { return parameters_[index]; }
+    [[nodiscard]] SynapseReference operator[](size_t index)
+    {
+        return {parameters_[index], presynaptic_indexes_[index], postsynaptic_indexes_[index]};
+    }
 
     /**
      * @brief Get parameter values of a synapse with the given index.
      * @details Constant method.
      * @param index synapse index.
-     * @return synapse parameters and indexes.
+     * @return constant references to synapse parameters and indexes.
      */
-    [[nodiscard]] const Synapse &operator[](size_t index) const { return parameters_[index]; }
+    [[nodiscard]] SynapseConstReference operator[](size_t index) const
+    {
+        return {parameters_[index], presynaptic_indexes_[index], postsynaptic_indexes_[index]};
+    }
 
     /**
      * @brief Get an iterator pointing to the first element of the projection.
      * @return constant projection iterator.
      */
-    [[nodiscard]] auto begin() const { return parameters_.cbegin(); }
+    [[nodiscard]] const_iterator begin() const { return {this, 0}; }
 
     /**
      * @brief Get an iterator pointing to the first element of the projection.
      * @return projection iterator.
      */
-    [[nodiscard]] auto begin() { return parameters_.begin(); }
+    [[nodiscard]] iterator begin() { return {this, 0}; }
 
     /**
      * @brief Get an iterator pointing to the last element of the projection.
      * @return constant iterator.
      */
-    [[nodiscard]] auto end() const { return parameters_.cend(); }
+    [[nodiscard]] const_iterator end() const { return {this, size()}; }
 
     /**
      * @brief Get an iterator pointing to the last element of the projection.
      * @return iterator.
      */
-    [[nodiscard]] auto end() { return parameters_.end(); }
+    [[nodiscard]] iterator end() { return {this, size()}; }
+
+public:
+    /**
+     * @brief Get parameters of all synapses.
+     * @details Parameters of a synapse are stored at the synapse index.
+     * @return synapse parameters array.
+     */
+    [[nodiscard]] SynapsesContainer &get_synapses_parameters() { return parameters_; }
+
+    /**
+     * @brief Get parameters of all synapses.
+     * @details Constant method.
+     * @return synapse parameters array.
+     */
+    [[nodiscard]] const SynapsesContainer &get_synapses_parameters() const { return parameters_; }
+
+    /**
+     * @brief Get indexes of presynaptic neurons of all synapses.
+     * @details Use the method to scan synapses without touching their parameters.
+     * @return presynaptic neuron indexes array.
+     */
+    [[nodiscard]] const NeuronIndexContainer &get_presynaptic_indexes() const { return presynaptic_indexes_; }
+
+    /**
+     * @brief Get indexes of postsynaptic neurons of all synapses.
+     * @return postsynaptic neuron indexes array.
+     */
+    [[nodiscard]] const NeuronIndexContainer &get_postsynaptic_indexes() const { return postsynaptic_indexes_; }
+
+    /**
+     * @brief Move synapse parameters, neuron indexes and synapse lists to storage allocated according to a policy.
+     * @details If the policy requires ordered synapses, synapses are ordered by `order_synapses_by_delay`.
+     * @param policy storage policy. If `nullptr`, synapses are allocated by `operator new`.
+     */
+    void set_storage_policy(const std::shared_ptr<const StoragePolicy> &policy)
+    {
+        flush_weight_changes();
+        move_to_storage(parameters_, policy);
+        move_to_storage(presynaptic_indexes_, policy);
+        move_to_storage(postsynaptic_indexes_, policy);
+        move_to_storage(presynaptic_offsets_, policy);
+        move_to_storage(synapses_by_presynaptic_, policy);
+        move_to_storage(postsynaptic_offsets_, policy);
+        move_to_storage(synapses_by_postsynaptic_, policy);
+        if (policy && policy->order_synapses_) order_synapses_by_delay();
+    }
 
 public:
     /**
@@ -265,6 +398,21 @@ public:
      */
     [[nodiscard]] size_t size() const { return parameters_.size(); }
 
+    /**
+     * @brief Get memory used by the projection.
+     * @return memory usage of projection components.
+     */
+    [[nodiscard]] MemoryUsage get_memory_usage() const;
+
+    /**
+     * @brief Estimate memory used by a projection before its construction.
+     * @details The estimate includes the synapse index, which is built when synapses are searched or when a projection
+     * is created with a synapse generator. Plasticity state that grows during network execution is not included.
+     * @param synapses_count number of synapses in the projection.
+     * @return estimated memory usage of projection components.
+     */
+    [[nodiscard]] static MemoryUsage estimate_memory_usage(size_t synapses_count);
+
     /**
      * @brief Get UID of the associated population from which this projection receives spikes.
      * @return UID of the presynaptic population.
@@ -300,6 +448,33 @@ public:
      */
     [[nodiscard]] std::vector<size_t> find_synapses(size_t neuron_index, Search search_method) const;
 
+    /**
+     * @brief Get indexes of synapses that originate from a neuron with the given index.
+     * @details Synapse indexes of all presynaptic neurons are stored in compressed sparse row format, in the same way
+     * as in `get_postsynaptic_synapses`.
+     * @param neuron_index index of a presynaptic neuron.
+     * @return synapse indexes in ascending order.
+     */
+    [[nodiscard]] SynapseIndexRange get_presynaptic_synapses(size_t neuron_index) const;
+
+    /**
+     * @brief Get indexes of synapses that lead to a neuron with the given index.
+     * @details Synapse indexes of all postsynaptic neurons are stored in compressed sparse column format: synapse
+     * indexes ordered by postsynaptic neuron and offsets of neuron ranges. The arrays are built on the first call and
+     * rebuilt only after synapses are added or removed. Unlike `find_synapses`, the method does not allocate memory.
+     * @param neuron_index index of a postsynaptic neuron.
+     * @return synapse indexes in ascending order.
+     */
+    [[nodiscard]] SynapseIndexRange get_postsynaptic_synapses(size_t neuron_index) const;
+
+    /**
+     * @brief Reorder synapses by presynaptic neuron, then by delay, then by postsynaptic neuron.
+     * @details After reordering, synapses of a presynaptic neuron with the same delay have consecutive indexes, so
+     * impacts of a spike are added to a delay slot in blocks and synapse parameters are read sequentially. Synapse
+     * indexes change, the order of synapses with equal keys is kept.
+     */
+    void order_synapses_by_delay();
+
     /**
      * @brief Append connections to the existing projection.
      * @param generator synapse generation function.
@@ -308,6 +483,13 @@ public:
      */
     size_t add_synapses(SynapseGenerator generator, size_t num_iterations);
 
+    /**
+     * @brief Append connections to the existing projection.
+     * @param synapses synapses to add.
+     * @return number of synapses added to the projection.
+     */
+    size_t add_synapses(const std::vector<Synapse> &synapses);
+
     /**
      * @brief Remove all synapses from the projection.
      */
@@ -315,16 +497,31 @@ public:
 
     /**
      * @brief Remove a synapse with the given index from the projection.
+     * @details Synapse index and synapse lists are rebuilt on the next search. Use `remove_synapses()` to remove several
+     * synapses at once.
      * @param index index of the synapse to remove.
+     * @throw std::out_of_range if the index is not less than the projection size.
      */
     void remove_synapse(size_t index);
 
+    /**
+     * @brief Remove synapses with the given indexes from the projection.
+     * @details Synapses are removed in a single pass, the order of the remaining synapses does not change.
+     * @param indexes indexes of the synapses to remove. Indexes can be unsorted and repeated.
+     * @throw std::out_of_range if an index is not less than the projection size.
+     * @return number of deleted synapses.
+     */
+    size_t remove_synapses(const std::vector<size_t> &indexes);
+
     /**
      * @brief Remove synapses according to a given criterion.
+     * @note The predicate receives `SynapseConstReference` instead of `const Synapse &`, because synapses are stored
+     * in separate arrays. Predicates with a `const auto &` argument work unchanged, predicates with an explicit
+     * `const Synapse &` argument must be changed to `const SynapseConstReference &`.
      * @param predicate functor that receives a synapse and returns `true` if the synapse must be deleted.
      * @return number of deleted synapses.
      */
-    size_t remove_synapse_if(std::function<bool(const Synapse &)> predicate);
+    size_t remove_synapse_if(std::function<bool(const SynapseConstReference &)> predicate);
 
     /**
      * @brief Remove all synapses that lead to a neuron with the given index.
@@ -341,10 +538,22 @@ public:
     size_t remove_presynaptic_neuron_synapses(size_t neuron_index);
 
 public:
+    /**
+     * @brief Apply deferred weight changes accumulated by a learning rule to synapse weights.
+     * @details Rules that defer weight changes keep them indexed by synapse, so the projection applies them before
+     * synapses are added, removed or reordered. Does nothing for synapses without deferred weight changes.
+     */
+    void flush_weight_changes();
+
     /**
      * @brief Lock the possibility to change synapses weights.
+     * @details Deferred weight changes are applied before the weights are locked.
      */
-    void lock_weights() { is_locked_ = true; }
+    void lock_weights()
+    {
+        flush_weight_changes();
+        is_locked_ = true;
+    }
 
     /**
      * @brief Unlock the possibility to change synapses weights.
@@ -373,6 +582,26 @@ public:
 private:
     void reindex() const;
 
+    void update_presynaptic_synapses() const;
+
+    void update_postsynaptic_synapses() const;
+
+    /**
+     * @brief Remove marked synapses in a single pass, keeping the order of the remaining synapses.
+     * @details If the synapse index is up to date, it is updated instead of being rebuilt.
+     * @param to_remove flags of synapses to remove, the size must be equal to the projection size.
+     * @return number of deleted synapses.
+     */
+    size_t remove_marked_synapses(const std::vector<bool> &to_remove);
+
+    /**
+     * @brief Remove all synapses associated with a neuron.
+     * @param neuron_index neuron index.
+     * @param search_method search by presynaptic or postsynaptic neuron.
+     * @return number of deleted synapses.
+     */
+    size_t remove_neuron_synapses(size_t neuron_index, Search search_method);
+
     BaseData base_;
 
     /**
@@ -390,10 +619,27 @@ private:
      */
     bool is_locked_ = true;
 
+    /**
+     * @brief Add a synapse to the end of the synapse arrays.
+     * @param synapse synapse to add.
+     * @throw std::out_of_range if a neuron index does not fit into 32 bits.
+     */
+    void push_back_synapse(Synapse &&synapse);
+
     /**
      * @brief Container of synapse parameters.
      */
     SynapsesContainer parameters_;
+
+    /**
+     * @brief Presynaptic neuron indexes of synapses.
+     */
+    NeuronIndexContainer presynaptic_indexes_;
+
+    /**
+     * @brief Postsynaptic neuron indexes of synapses.
+     */
+    NeuronIndexContainer postsynaptic_indexes_;
     // So far the index is mutable so we can reindex a const object that has a non-updated index.
     struct Connection
     {
@@ -423,6 +669,23 @@ private:
     mutable Index index_;
     mutable bool is_index_updated_ = false;
 
+    // Offsets of presynaptic neuron ranges in `synapses_by_presynaptic_`.
+    mutable SynapseIndexContainer presynaptic_offsets_;
+    // Synapse indexes ordered by presynaptic neuron.
+    mutable SynapseIndexContainer synapses_by_presynaptic_;
+    mutable bool is_presynaptic_synapses_updated_ = false;
+
+    // Offsets of postsynaptic neuron ranges in `synapses_by_postsynaptic_`.
+    mutable SynapseIndexContainer postsynaptic_offsets_;
+    // Synapse indexes ordered by postsynaptic neuron.
+    mutable SynapseIndexContainer synapses_by_postsynaptic_;
+    mutable bool is_postsynaptic_synapses_updated_ = false;
+
+    /**
+     * @brief Size of an index element: connection and a pair of pointers for each of the three hashed indexes.
+     */
+    constexpr static size_t index_node_size = sizeof(Connection) + 3 * 2 * sizeof(void *);
+
     SharedSynapseParameters shared_parameters_;
 };
 
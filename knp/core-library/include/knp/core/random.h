@@ -0,0 +1,150 @@
+/**
+ * @file random.h
+ * @brief Counter-based random number generator.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/uid.h>
+
+#include <array>
+#include <cstdint>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief Counter of Philox4x32 generator.
+ */
+using PhiloxCounter = std::array<uint32_t, 4>;
+
+
+/**
+ * @brief Key of Philox4x32 generator.
+ */
+using PhiloxKey = std::array<uint32_t, 2>;
+
+
+/**
+ * @brief Calculate Philox4x32-10 function.
+ * @details Philox is a counter-based generator: a random value is a bijection of a counter and a key, so it does not
+ * depend on values generated before. See Salmon J. K. et al., "Parallel random numbers: as easy as 1, 2, 3", 2011.
+ * @param counter counter.
+ * @param key key.
+ * @return four random 32-bit values.
+ */
+constexpr PhiloxCounter philox4x32(PhiloxCounter counter, PhiloxKey key)
+{
+    constexpr uint64_t multiplier0 = 0xD2511F53;
+    constexpr uint64_t multiplier1 = 0xCD9E8D57;
+    constexpr uint32_t key_increment0 = 0x9E3779B9;
+    constexpr uint32_t key_increment1 = 0xBB67AE85;
+    constexpr int rounds = 10;
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        const uint64_t product0 = multiplier0 * counter[0];
+        const uint64_t product1 = multiplier1 * counter[2];
+        counter = {
+            static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+        key[0] += key_increment0;
+        key[1] += key_increment1;
+    }
+    return counter;
+}
+
+
+/**
+ * @brief The CounterBasedRandom class is a definition of a random number generator that returns a value for an entity
+ * element and a counter.
+ * @details A value depends only on the generator seed, the entity UID, the element index and the counter, but not on
+ * the order of calls. Thus results do not depend on the way the elements are distributed between threads.
+ */
+class CounterBasedRandom
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param seed random generator seed.
+     * @param uid UID of the entity, elements of which get random values.
+     */
+    explicit CounterBasedRandom(uint64_t seed, const UID &uid = UID{false})
+    {
+        // UID bytes are folded into the key, so entities with the same seed get different streams.
+        const ::boost::uuids::uuid &tag = uid;
+        uint64_t uid_hash = 0;
+        for (const auto byte : tag) uid_hash = uid_hash * 0x100000001B3ULL ^ byte;
+        const auto key = philox4x32(
+            {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32), static_cast<uint32_t>(uid_hash),
+             static_cast<uint32_t>(uid_hash >> 32)},
+            {0, 0});
+        key_ = {key[0], key[1]};
+    }
+
+    /**
+     * @brief Get a random 64-bit value.
+     * @param index element index, for example neuron or synapse index.
+     * @param counter counter, for example step number.
+     * @return random value.
+     */
+    [[nodiscard]] uint64_t operator()(uint64_t index, uint64_t counter = 0) const
+    {
+        const auto result = philox4x32(
+            {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), static_cast<uint32_t>(counter),
+             static_cast<uint32_t>(counter >> 32)},
+            key_);
+        return static_cast<uint64_t>(result[0]) << 32 | result[1];
+    }
+
+    /**
+     * @brief Get a random value uniformly distributed in the [0, 1) interval.
+     * @param index element index.
+     * @param counter counter.
+     * @return random value.
+     */
+    [[nodiscard]] double uniform(uint64_t index, uint64_t counter = 0) const
+    {
+        // 53 bits fill the mantissa of `double`.
+        constexpr double scale = 1.0 / static_cast<double>(1ULL << 53);
+        return static_cast<double>((*this)(index, counter) >> 11) * scale;
+    }
+
+    /**
+     * @brief Get a random integer uniformly distributed in the [0, bound) interval.
+     * @param index element index.
+     * @param counter counter.
+     * @param bound upper bound of the interval.
+     * @return random integer.
+     */
+    [[nodiscard]] uint64_t uniform_int(uint64_t index, uint64_t counter, uint64_t bound) const
+    {
+        // Bias of the modulo is negligible for bounds that are small compared to 2^64.
+        return bound ? (*this)(index, counter) % bound : 0;
+    }
+
+private:
+    PhiloxKey key_;
+};
+
+}  // namespace knp::core
@@ -0,0 +1,308 @@
+/**
+ * @file storage_allocator.h
+ * @brief Allocator for large neuron and synapse arrays.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief Size of pages used for storage.
+ */
+enum class StoragePages
+{
+    /**
+     * @brief Pages of the default size.
+     */
+    standard,
+    /**
+     * @brief Transparent huge pages requested by `madvise`.
+     */
+    transparent_huge,
+    /**
+     * @brief Huge pages reserved by the system and mapped with `MAP_HUGETLB`.
+     * @details If there are no free reserved huge pages, pages of the default size are used.
+     */
+    explicit_huge
+};
+
+
+/**
+ * @brief Placement of storage pages on NUMA nodes.
+ */
+enum class StorageNumaPlacement
+{
+    /**
+     * @brief A page is placed on the node of the thread that touches it first.
+     */
+    first_touch,
+    /**
+     * @brief Pages are interleaved between all nodes.
+     */
+    interleave,
+    /**
+     * @brief Pages are placed on the given node if it has free memory.
+     */
+    preferred_node
+};
+
+
+/**
+ * @brief The StoragePolicy structure defines how large arrays of neuron and synapse parameters are allocated.
+ * @details Arrays smaller than `min_mapped_bytes_` are always allocated by `operator new`. Larger arrays are mapped
+ * directly, so that page size, NUMA placement and file backing can be applied to them.
+ * @note Page and NUMA settings are supported on Linux only. On other systems all arrays are allocated by `operator
+ * new`.
+ */
+struct StoragePolicy
+{
+    /**
+     * @brief Size of pages.
+     */
+    StoragePages pages_ = StoragePages::standard;
+
+    /**
+     * @brief Placement of pages on NUMA nodes.
+     */
+    StorageNumaPlacement numa_placement_ = StorageNumaPlacement::first_touch;
+
+    /**
+     * @brief Node index used with the `preferred_node` placement.
+     */
+    unsigned numa_node_ = 0;
+
+    /**
+     * @brief Directory for files that back the arrays.
+     * @details If the directory is not empty, arrays are mapped from unnamed temporary files created in it, so the
+     * system can write unused pages to disk instead of swap. Huge pages are not used for file-backed arrays. Every
+     * mapped array has its own file, so `min_mapped_bytes_` must keep small arrays in memory allocated by
+     * `operator new`. The files are scratch storage: they are removed when the arrays are freed and cannot be
+     * reopened, so they are not a network file format.
+     */
+    std::filesystem::path backing_directory_;
+
+    /**
+     * @brief Minimum size of a mapped array in bytes.
+     * @details Mappings are rounded up to the huge page size if huge pages are used, and to the default page size
+     * otherwise.
+     */
+    size_t min_mapped_bytes_ = 2 * 1024 * 1024;
+
+    /**
+     * @brief Read pages that follow an accessed page in advance.
+     * @details Disable read-ahead for file-backed arrays that are accessed by rows and are paged out during execution,
+     * so only pages of accessed rows are read from disk.
+     */
+    bool read_ahead_ = true;
+
+    /**
+     * @brief Order synapses of a projection by presynaptic neuron when the policy is applied to it.
+     * @details Synapses of a presynaptic neuron are then stored in consecutive pages, and a spike touches only the
+     * pages of its row. Synapse indexes change.
+     * @see Projection::order_synapses_by_delay().
+     */
+    bool order_synapses_ = false;
+
+    /**
+     * @brief Compare storage policies.
+     * @param other policy to compare with.
+     * @return `true` if policies are equal.
+     */
+    bool operator==(const StoragePolicy &other) const
+    {
+        return pages_ == other.pages_ && numa_placement_ == other.numa_placement_ && numa_node_ == other.numa_node_ &&
+               backing_directory_ == other.backing_directory_ && min_mapped_bytes_ == other.min_mapped_bytes_ &&
+               read_ahead_ == other.read_ahead_ && order_synapses_ == other.order_synapses_;
+    }
+};
+
+
+/**
+ * @brief Allocate storage according to a policy.
+ * @param bytes number of bytes to allocate.
+ * @param policy storage policy. If `nullptr`, memory is allocated by `operator new`.
+ * @return pointer to allocated memory.
+ * @throw std::bad_alloc if memory cannot be allocated.
+ */
+void *allocate_storage(size_t bytes, const StoragePolicy *policy);
+
+
+/**
+ * @brief Free storage allocated by `allocate_storage`.
+ * @param pointer pointer to allocated memory.
+ * @param bytes number of allocated bytes.
+ * @param policy storage policy used for allocation.
+ */
+void deallocate_storage(void *pointer, size_t bytes, const StoragePolicy *policy) noexcept;
+
+
+/**
+ * @brief Place pages of a part of an array on a NUMA node.
+ * @details Pages that lie entirely inside the range are bound to the node, pages that are already used are moved to
+ * it. Pages of huge page storage are huge pages, so a range shorter than a huge page may bind no pages. The function
+ * does nothing if the system does not support NUMA placement.
+ * @param pointer pointer to the first byte of the range.
+ * @param bytes number of bytes in the range.
+ * @param node index of the NUMA node in the system.
+ * @param policy storage policy used to allocate the array or `nullptr` if the array is allocated by `operator new`.
+ */
+void bind_storage_to_node(const void *pointer, size_t bytes, unsigned node, const StoragePolicy *policy) noexcept;
+
+
+/**
+ * @brief The StorageAllocator class is a definition of an allocator that allocates memory according to a storage
+ * policy.
+ * @details A default-constructed allocator uses `operator new`. The allocator is propagated when a container is
+ * assigned or swapped, so a container keeps the policy of the container it was moved from.
+ * @tparam T type of allocated values.
+ */
+template <class T>
+class StorageAllocator
+{
+public:
+    /**
+     * @brief Type of allocated values.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Allocator is copied when a container is copied.
+     */
+    using propagate_on_container_copy_assignment = std::true_type;
+
+    /**
+     * @brief Allocator is moved when a container is moved.
+     */
+    using propagate_on_container_move_assignment = std::true_type;
+
+    /**
+     * @brief Allocator is swapped when containers are swapped.
+     */
+    using propagate_on_container_swap = std::true_type;
+
+public:
+    /**
+     * @brief Construct an allocator that uses `operator new`.
+     */
+    StorageAllocator() noexcept = default;
+
+    /**
+     * @brief Construct an allocator that uses a storage policy.
+     * @param policy storage policy.
+     */
+    explicit StorageAllocator(std::shared_ptr<const StoragePolicy> policy) noexcept : policy_(std::move(policy)) {}
+
+    /**
+     * @brief Construct an allocator from an allocator of another type.
+     * @tparam U type of values allocated by another allocator.
+     * @param other another allocator.
+     */
+    template <class U>
+    StorageAllocator(const StorageAllocator<U> &other) noexcept : policy_(other.get_policy())  // NOLINT
+    {
+    }
+
+public:
+    /**
+     * @brief Allocate memory for values.
+     * @param count number of values.
+     * @return pointer to allocated memory.
+     */
+    [[nodiscard]] T *allocate(size_t count)
+    {
+        return static_cast<T *>(allocate_storage(count * sizeof(T), policy_.get()));
+    }
+
+    /**
+     * @brief Free memory.
+     * @param pointer pointer to allocated memory.
+     * @param count number of values.
+     */
+    void deallocate(T *pointer, size_t count) noexcept
+    {
+        deallocate_storage(pointer, count * sizeof(T), policy_.get());
+    }
+
+    /**
+     * @brief Get storage policy.
+     * @return storage policy or `nullptr` if the allocator uses `operator new`.
+     */
+    [[nodiscard]] const std::shared_ptr<const StoragePolicy> &get_policy() const noexcept { return policy_; }
+
+    /**
+     * @brief Compare allocators.
+     * @details Allocators are equal if memory allocated by one of them can be freed by another.
+     * @tparam U type of values allocated by another allocator.
+     * @param other another allocator.
+     * @return `true` if allocators are equal.
+     */
+    template <class U>
+    bool operator==(const StorageAllocator<U> &other) const noexcept
+    {
+        const auto &other_policy = other.get_policy();
+        if (policy_ == other_policy) return true;
+        return policy_ && other_policy && *policy_ == *other_policy;
+    }
+
+    /**
+     * @brief Compare allocators.
+     * @tparam U type of values allocated by another allocator.
+     * @param other another allocator.
+     * @return `true` if allocators are not equal.
+     */
+    template <class U>
+    bool operator!=(const StorageAllocator<U> &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<const StoragePolicy> policy_;
+};
+
+
+/**
+ * @brief Move container values to storage allocated according to a policy.
+ * @tparam Container container type that uses `StorageAllocator`.
+ * @param container container to move.
+ * @param policy storage policy.
+ */
+template <class Container>
+void move_to_storage(Container &container, const std::shared_ptr<const StoragePolicy> &policy)
+{
+    using Allocator = typename Container::allocator_type;
+    const Allocator allocator{policy};
+    if (container.get_allocator() == allocator) return;
+    Container moved(std::make_move_iterator(container.begin()), std::make_move_iterator(container.end()), allocator);
+    container = std::move(moved);
+}
+
+}  // namespace knp::core
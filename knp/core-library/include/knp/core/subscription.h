@@ -23,6 +23,7 @@
 #include <knp/core/uid.h>
 
 #include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -54,6 +55,13 @@ public:
      * @brief Internal container for UIDs.
      */
     using UidSet = std::unordered_set<knp::core::UID, knp::core::uid_hash>;
+
+    /**
+     * @brief Type of the function called when the set of senders changes.
+     * @details The function receives the UID of the sender and `true` if the sender was added or `false` if it was
+     * removed.
+     */
+    using SendersHandler = std::function<void(const UID &, bool)>;
     // Subscription(const Subscription &) = delete;
 
 public:
@@ -82,7 +90,12 @@ public:
      * @param uid sender UID.
      * @return number of senders deleted from subscription.
      */
-    size_t remove_sender(const UID &uid) { return senders_.erase(uid); }
+    size_t remove_sender(const UID &uid)
+    {
+        const size_t removed = senders_.erase(uid);
+        if (removed && senders_handler_) senders_handler_(uid, false);
+        return removed;
+    }
 
     /**
      * @brief Add a sender with the given UID to the subscription.
@@ -90,7 +103,12 @@ public:
      * @param uid UID of the new sender.
      * @return number of senders added.
      */
-    size_t add_sender(const UID &uid) { return senders_.insert(uid).second; }
+    size_t add_sender(const UID &uid)
+    {
+        const bool added = senders_.insert(uid).second;
+        if (added && senders_handler_) senders_handler_(uid, true);
+        return added;
+    }
 
     /**
      * @brief Add several senders to the subscription.
@@ -100,7 +118,7 @@ public:
     size_t add_senders(const std::vector<UID> &senders)
     {
         size_t size_before = senders_.size();
-        std::copy(senders.begin(), senders.end(), std::inserter(senders_, senders_.end()));
+        for (const auto &uid : senders) add_sender(uid);
         return senders_.size() - size_before;
     }
 
@@ -111,6 +129,13 @@ public:
      */
     [[nodiscard]] bool has_sender(const UID &uid) const { return senders_.find(uid) != senders_.end(); }
 
+    /**
+     * @brief Set a function that is called every time a sender is added to or removed from the subscription.
+     * @details Message endpoints use the function to update their routing of messages to subscriptions.
+     * @param handler function to call.
+     */
+    void set_senders_handler(SendersHandler handler) { senders_handler_ = std::move(handler); }
+
 public:
     /**
      * @brief Add a message to the subscription.
@@ -155,6 +180,10 @@ private:
      * @brief Message storage.
      */
     MessageContainerType messages_;
+    /**
+     * @brief Function called when the set of senders changes.
+     */
+    SendersHandler senders_handler_;
 };
 
 }  // namespace knp::core
@@ -21,11 +21,14 @@
 
 #pragma once
 
+#include <knp/core/heap_memory_usage.h>
+
 #include <any>
 #include <functional>
 #include <map>
 #include <string>
 #include <variant>
+#include <vector>
 
 
 /**
@@ -59,6 +62,33 @@ public:
         return std::any_cast<std::decay_t<T> &>(tags_[name]);
     }
 
+    /**
+     * @brief Find tag value by tag name and value type.
+     * @tparam T tag value type.
+     * @param name tag name.
+     * @return pointer to the tag value or `nullptr` if there is no tag of the given type with the given name.
+     */
+    template <typename T>
+    [[nodiscard]] std::decay_t<T> *find_tag(const std::string &name)
+    {
+        auto iter = tags_.find(name);
+        return iter == tags_.end() ? nullptr : std::any_cast<std::decay_t<T>>(&iter->second);
+    }
+
+    /**
+     * @brief Find tag value by tag name and value type.
+     * @note Constant method.
+     * @tparam T tag value type.
+     * @param name tag name.
+     * @return pointer to the tag value or `nullptr` if there is no tag of the given type with the given name.
+     */
+    template <typename T>
+    [[nodiscard]] const std::decay_t<T> *find_tag(const std::string &name) const
+    {
+        auto iter = tags_.find(name);
+        return iter == tags_.end() ? nullptr : std::any_cast<std::decay_t<T>>(&iter->second);
+    }
+
     /**
      * @brief Return tag value.
      * @param name tag name.
@@ -72,7 +102,35 @@ public:
      */
     [[nodiscard]] bool empty() const noexcept { return tags_.empty(); }
 
+    /**
+     * @brief Get memory used by tags.
+     * @details Values of string tags and of the `neuron_tags` vector of tag maps are included. Memory used by values of
+     * other types is not included, because `std::any` does not provide their sizes.
+     * @return estimated number of bytes used by tags.
+     */
+    [[nodiscard]] size_t get_memory_usage() const
+    {
+        // Tree node contains three pointers and a color.
+        constexpr size_t node_size = sizeof(decltype(tags_)::value_type) + 4 * sizeof(void *);
+        size_t result = tags_.size() * node_size;
+        for (const auto &tag : tags_) result += get_heap_memory_usage(tag.first) + get_value_memory_usage(tag.second);
+        return result;
+    }
+
 private:
+    // Values larger than a pointer are allocated by `std::any` on the heap.
+    static size_t get_value_memory_usage(const std::any &value)
+    {
+        if (const auto *tag_maps = std::any_cast<std::vector<TagMap>>(&value))
+        {
+            size_t result = sizeof(*tag_maps) + get_heap_memory_usage(*tag_maps);
+            for (const auto &tag_map : *tag_maps) result += tag_map.get_memory_usage();
+            return result;
+        }
+        if (const auto *str = std::any_cast<std::string>(&value)) return sizeof(*str) + get_heap_memory_usage(*str);
+        return 0;
+    }
+
     std::map<std::string, std::any> tags_{};
 };
 
@@ -0,0 +1,96 @@
+/**
+ * @file uid_handle.h
+ * @brief Dense integer handles for UIDs.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/uid.h>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace knp::core
+{
+
+/**
+ * @brief Dense internal handle of an entity UID.
+ * @details Handles are assigned sequentially starting from zero, so they can be used as indexes in vectors instead
+ * of hashing UIDs.
+ */
+using UIDHandle = uint32_t;
+
+
+/**
+ * @brief Value that denotes a UID without a handle.
+ */
+constexpr UIDHandle invalid_uid_handle = std::numeric_limits<UIDHandle>::max();
+
+
+/**
+ * @brief The UIDHandleRegistry class assigns dense handles to UIDs.
+ * @details UIDs remain the public identity of entities. The registry is used to translate a UID to a handle once,
+ * at an API boundary, so that internal containers can be indexed by the handle.
+ */
+class UIDHandleRegistry
+{
+public:
+    /**
+     * @brief Get a handle of the specified UID, assigning a new handle if the UID is not registered.
+     * @param uid UID to register.
+     * @return UID handle.
+     * @throw std::overflow_error if all handle values are used.
+     */
+    UIDHandle register_uid(const UID &uid);
+
+    /**
+     * @brief Get a handle of the specified UID.
+     * @param uid UID to find.
+     * @return UID handle or `invalid_uid_handle` if the UID is not registered.
+     */
+    [[nodiscard]] UIDHandle get_handle(const UID &uid) const;
+
+    /**
+     * @brief Get a UID by its handle.
+     * @param handle UID handle.
+     * @return UID.
+     * @throw std::out_of_range if the handle was not assigned by the registry.
+     */
+    [[nodiscard]] const UID &get_uid(UIDHandle handle) const { return uids_.at(handle); }
+
+    /**
+     * @brief Get number of registered UIDs.
+     * @return number of handles assigned by the registry.
+     */
+    [[nodiscard]] size_t size() const { return uids_.size(); }
+
+    /**
+     * @brief Remove all registered UIDs.
+     */
+    void clear();
+
+private:
+    std::unordered_map<UID, UIDHandle, uid_hash> handles_;
+    std::vector<UID> uids_;
+};
+
+}  // namespace knp::core
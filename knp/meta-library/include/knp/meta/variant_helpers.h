@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <string>
 #include <variant>
 #include <vector>
@@ -40,11 +42,14 @@ namespace knp::meta
  * @tparam SupportedTypes subset of variants.
  * @tparam AllVariants all supported variants.
  * @tparam ToContainer target container.
+ * @tparam Function type of a function that is called for loaded elements.
  * @param from_container source container.
  * @param to_container target container.
+ * @param on_load function that is called for every element of the target container right after it is loaded.
  */
-template <typename SupportedTypes, typename AllVariants, typename ToContainer>
-void load_from_container(const std::vector<AllVariants> &from_container, ToContainer &to_container)
+template <typename SupportedTypes, typename AllVariants, typename ToContainer, typename Function>
+void load_from_container(
+    const std::vector<AllVariants> &from_container, ToContainer &to_container, Function on_load)
 {
     to_container.clear();
     to_container.reserve(from_container.size());
@@ -52,12 +57,13 @@ void load_from_container(const std::vector<AllVariants> &from_container, ToConta
     for (const auto &p : from_container)
     {
         std::visit(
-            [&to_container](auto &arg)
+            [&to_container, &on_load](auto &arg)
             {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (boost::mp11::mp_find<SupportedTypes, T>{} != boost::mp11::mp_size<SupportedTypes>{})
                 {
                     to_container.push_back(typename ToContainer::value_type{arg});
+                    on_load(to_container.back());
                 }
             },
             p);
@@ -65,6 +71,143 @@ void load_from_container(const std::vector<AllVariants> &from_container, ToConta
 }
 
 
+/**
+ * @brief Load elements from one container of all variants to another container that contains a subset of all
+ * variants.
+ * @tparam SupportedTypes subset of variants.
+ * @tparam AllVariants all supported variants.
+ * @tparam ToContainer target container.
+ * @param from_container source container.
+ * @param to_container target container.
+ */
+template <typename SupportedTypes, typename AllVariants, typename ToContainer>
+void load_from_container(const std::vector<AllVariants> &from_container, ToContainer &to_container)
+{
+    load_from_container<SupportedTypes>(from_container, to_container, [](const auto &) {});
+}
+
+
+/**
+ * @brief The VariantPartition class splits a container of variants into runs of consecutive elements of the same type.
+ * @details A function that is called for every element gets an element of a concrete type. The type is dispatched
+ * once per run instead of once per element as with `std::visit`, and elements are processed in the container order.
+ * A container that is filled type by type has one run per type.
+ * @note The partition must be rebuilt after elements are added to or removed from the container.
+ * @tparam Variant variant type.
+ */
+template <class Variant>
+class VariantPartition
+{
+public:
+    /**
+     * @brief Number of variant alternatives.
+     */
+    static constexpr size_t types_count = std::variant_size_v<Variant>;
+
+    /**
+     * @brief Run of consecutive container elements that hold values of the same type.
+     */
+    struct Run
+    {
+        /**
+         * @brief Index of the variant alternative.
+         */
+        size_t type_index_;
+
+        /**
+         * @brief Index of the first element of the run.
+         */
+        size_t begin_;
+
+        /**
+         * @brief Index of the element following the last element of the run.
+         */
+        size_t end_;
+    };
+
+public:
+    /**
+     * @brief Split container elements into runs of the same type.
+     * @tparam Container container type.
+     * @tparam Getter type of a function that returns a variant for a container element.
+     * @param container container of elements.
+     * @param get_variant function that returns a variant for a container element.
+     */
+    template <class Container, class Getter>
+    void build(const Container &container, Getter get_variant)
+    {
+        runs_.clear();
+        for (size_t index = 0; index < container.size(); ++index)
+        {
+            const size_t type_index = get_variant(container[index]).index();
+            if (!runs_.empty() && runs_.back().type_index_ == type_index)
+                runs_.back().end_ = index + 1;
+            else
+                runs_.push_back({type_index, index, index + 1});
+        }
+    }
+
+    /**
+     * @brief Split elements of a container of variants into runs of the same type.
+     * @tparam Container container type.
+     * @param container container of variants.
+     */
+    template <class Container>
+    void build(const Container &container)
+    {
+        build(container, [](const Variant &element) -> const Variant & { return element; });
+    }
+
+    /**
+     * @brief Call a function for every container element in the container order.
+     * @tparam Container container type.
+     * @tparam Getter type of a function that returns a variant for a container element.
+     * @tparam Function type of a function that is called for elements.
+     * @param container container used to build the partition.
+     * @param get_variant function that returns a variant for a container element.
+     * @param func function that gets a value held by a variant and an index of the container element.
+     */
+    template <class Container, class Getter, class Function>
+    void for_each(Container &container, Getter get_variant, Function func) const
+    {
+        for (const auto &run : runs_)
+        {
+            boost::mp11::mp_with_index<types_count>(
+                run.type_index_,
+                [&container, &get_variant, &func, &run](auto type_index)
+                {
+                    for (size_t index = run.begin_; index < run.end_; ++index)
+                    {
+                        func(*std::get_if<decltype(type_index)::value>(&get_variant(container[index])), index);
+                    }
+                });
+        }
+    }
+
+    /**
+     * @brief Call a function for every element of a container of variants in the container order.
+     * @tparam Container container type.
+     * @tparam Function type of a function that is called for elements.
+     * @param container container used to build the partition.
+     * @param func function that gets a value held by a variant and an index of the container element.
+     */
+    template <class Container, class Function>
+    void for_each(Container &container, Function func) const
+    {
+        for_each(container, [](auto &element) -> auto & { return element; }, func);
+    }
+
+    /**
+     * @brief Get runs of container elements that hold values of the same type.
+     * @return runs in the container order.
+     */
+    [[nodiscard]] const std::vector<Run> &get_runs() const { return runs_; }
+
+private:
+    std::vector<Run> runs_;
+};
+
+
 /**
  * @brief Convert from one set of arguments to another.
  * @note This is is a helper structure. Use `variant_cast` instead.
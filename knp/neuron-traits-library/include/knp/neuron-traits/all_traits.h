@@ -27,6 +27,7 @@
 
 #include "altai_lif.h"
 #include "blifat.h"
+#include "homogeneous_blifat.h"
 #include "stdp_synaptic_resource_rule.h"
 #include "stdp_type_traits.h"
 
@@ -38,7 +39,9 @@ namespace knp::neuron_traits
 /**
  * @brief Comma-separated list of neuron tags.
  */
-#define ALL_NEURONS BLIFATNeuron, SynapticResourceSTDPBLIFATNeuron, AltAILIF
+#define ALL_NEURONS                                                                                         \
+    BLIFATNeuron, SynapticResourceSTDPBLIFATNeuron, AltAILIF, HomogeneousBLIFATNeuron, Float32BLIFATNeuron, \
+        Float32SynapticResourceSTDPBLIFATNeuron
 
 
 /**
@@ -0,0 +1,178 @@
+/**
+ * @file homogeneous_blifat.h
+ * @brief Type traits of BLIFAT neuron with parameters shared between population neurons.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "blifat.h"
+#include "type_traits.h"
+
+/**
+ * @brief Namespace for neuron traits.
+ */
+namespace knp::neuron_traits
+{
+
+/**
+ * @brief BLIFAT neuron whose static parameters are shared between all population neurons.
+ * @details Neuron parameters store only the neuron state. Static parameters are stored once per population, see
+ * `knp::core::Population::get_shared_parameters()`. Use as a template parameter only.
+ */
+struct HomogeneousBLIFATNeuron;
+
+
+/**
+ * @brief Structure for default values of homogeneous BLIFAT neuron.
+ * @details Default values are the same as for a BLIFAT neuron.
+ */
+template <>
+struct default_values<HomogeneousBLIFATNeuron> : default_values<BLIFATNeuron>
+{
+};
+
+
+/**
+ * @brief Structure for the state of homogeneous BLIFAT neuron.
+ * @details See `neuron_parameters<BLIFATNeuron>` for parameter descriptions.
+ */
+template <>
+struct neuron_parameters<HomogeneousBLIFATNeuron>
+{
+    /**
+     * @brief The parameter defines a number of network steps since the last spike.
+     */
+    std::size_t n_time_steps_since_last_firing_ =
+        default_values<HomogeneousBLIFATNeuron>::n_time_steps_since_last_firing_;
+    /**
+     * @brief The parameter defines an additional part of the threshold for membrane potential.
+     */
+    double additional_threshold_ = default_values<HomogeneousBLIFATNeuron>::additional_threshold_;
+    /**
+     * @brief The parameter defines a dynamic part of the threshold for membrane potential.
+     */
+    double dynamic_threshold_ = default_values<HomogeneousBLIFATNeuron>::dynamic_threshold_;
+    /**
+     * @brief The parameter defines a postsynaptic trace value.
+     */
+    double postsynaptic_trace_ = default_values<HomogeneousBLIFATNeuron>::postsynaptic_trace_;
+    /**
+     * @brief The parameter defines speed with which a potential tends to the `reversal_inhibitory_potential` value.
+     */
+    double inhibitory_conductance_ = default_values<HomogeneousBLIFATNeuron>::inhibitory_conductance_;
+    /**
+     * @brief The parameter defines the current membrane potential.
+     */
+    double potential_ = default_values<HomogeneousBLIFATNeuron>::potential_;
+    /**
+     * @brief This parameter is used if there was a blocking signal.
+     */
+    double pre_impact_potential_ = default_values<HomogeneousBLIFATNeuron>::pre_impact_potential_;
+    /**
+     * @brief The parameter defines the number of network execution steps, during which the neuron activity is totally
+     * blocked.
+     */
+    int64_t total_blocking_period_ = default_values<HomogeneousBLIFATNeuron>::total_blocking_period_;
+    /**
+     * @brief The parameter defines a dopamine value used to sum up all incoming dopamine synapse impacts.
+     */
+    double dopamine_value_ = default_values<HomogeneousBLIFATNeuron>::dopamine_value_;
+    /**
+     * @brief The parameter defines a counter for the `bursting_period_` value.
+     */
+    unsigned bursting_phase_ = default_values<HomogeneousBLIFATNeuron>::bursting_phase_;
+    /**
+     * @brief The random number generator is used for stochastic stimulation.
+     */
+    unsigned random_number_generator_state_ = default_values<HomogeneousBLIFATNeuron>::random_number_generator_state_;
+};
+
+
+/**
+ * @brief Structure for static parameters shared between homogeneous BLIFAT neurons of a population.
+ * @details See `neuron_parameters<BLIFATNeuron>` for parameter descriptions.
+ */
+template <>
+struct shared_neuron_parameters<HomogeneousBLIFATNeuron>
+{
+    /**
+     * @brief The parameter defines a constant part of the threshold for membrane potential.
+     */
+    double activation_threshold_ = default_values<HomogeneousBLIFATNeuron>::activation_threshold_;
+    /**
+     * @brief The parameter defines a time constant during which the `dynamic_threshold_` parameter tends to its base
+     * value if nothing happens.
+     */
+    double threshold_decay_ = default_values<HomogeneousBLIFATNeuron>::threshold_decay_;
+    /**
+     * @brief The parameter defines a value that increases the `dynamic_threshold_` value if a neuron generates a spike.
+     */
+    double threshold_increment_ = default_values<HomogeneousBLIFATNeuron>::threshold_increment_;
+    /**
+     * @brief The parameter defines a time constant during which the `postsynaptic_trace_` parameter tends to zero if
+     * nothing happens.
+     */
+    double postsynaptic_trace_decay_ = default_values<HomogeneousBLIFATNeuron>::postsynaptic_trace_decay_;
+    /**
+     * @brief The parameter defines a value that increases the `postsynaptic_trace_` value if a neuron generates a
+     * spike.
+     */
+    double postsynaptic_trace_increment_ = default_values<HomogeneousBLIFATNeuron>::postsynaptic_trace_increment_;
+    /**
+     * @brief The parameter defines a time constant during which the `inhibitory_conductance_` value decreases.
+     */
+    double inhibitory_conductance_decay_ = default_values<HomogeneousBLIFATNeuron>::inhibitory_conductance_decay_;
+    /**
+     * @brief The parameter defines a time constant during which the `potential_` value tends to zero.
+     */
+    double potential_decay_ = default_values<HomogeneousBLIFATNeuron>::potential_decay_;
+    /**
+     * @brief The parameter defines a value that increases the membrane potential after a neuron generates a spike.
+     */
+    double reflexive_weight_ = default_values<HomogeneousBLIFATNeuron>::reflexive_weight_;
+    /**
+     * @brief The parameter defines a value to which membrane potential tends (for conductance-based inhibitory
+     * synapses).
+     */
+    double reversal_inhibitory_potential_ = default_values<HomogeneousBLIFATNeuron>::reversal_inhibitory_potential_;
+    /**
+     * @brief The parameter defines a potential value after a neuron generates a spike.
+     */
+    double potential_reset_value_ = default_values<HomogeneousBLIFATNeuron>::potential_reset_value_;
+    /**
+     * @brief The parameter defines a minimum value of membrane potential.
+     */
+    double min_potential_ = default_values<HomogeneousBLIFATNeuron>::min_potential_;
+    /**
+     * @brief The parameter defines stochastic stimulation - random number added to the potential every tick.
+     */
+    double stochastic_stimulation_ = default_values<HomogeneousBLIFATNeuron>::stochastic_stimulation_;
+    /**
+     * @brief The parameter defines a number of network steps after reaching which a neuron generates a spike.
+     */
+    unsigned bursting_period_ = default_values<HomogeneousBLIFATNeuron>::bursting_period_;
+    /**
+     * @brief The parameter defines a minimum number of network steps before a neuron can generate the next spike.
+     */
+    unsigned absolute_refractory_period_ = default_values<HomogeneousBLIFATNeuron>::absolute_refractory_period_;
+};
+
+}  // namespace knp::neuron_traits
@@ -31,4 +31,10 @@ namespace knp::neuron_traits
  */
 using SynapticResourceSTDPBLIFATNeuron = SynapticResourceSTDPNeuron<BLIFATNeuron>;
 
+
+/**
+ * @brief BLIFAT neuron with single-precision parameters and additional resource-based STDP parameters.
+ */
+using Float32SynapticResourceSTDPBLIFATNeuron = SynapticResourceSTDPNeuron<Float32BLIFATNeuron>;
+
 }  // namespace knp::neuron_traits
@@ -43,4 +43,14 @@ template <typename NeuronType>
 struct default_values;
 
 
+/**
+ * @brief Structure for parameters shared between neurons of a population.
+ * @tparam NeuronType type of neurons.
+ */
+template <typename NeuronType>
+struct shared_neuron_parameters
+{
+};
+
+
 }  // namespace knp::neuron_traits
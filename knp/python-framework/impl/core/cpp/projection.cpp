@@ -77,6 +77,27 @@ py::class_<core::Synapse>(
         py::class_<typename core::Projection<st::synapse_type>::Synapse>(                                              \
             BOOST_PP_STRINGIZE(BOOST_PP_CAT(synapse_type, Parameters)));                                               \
                                                                                                                        \
+        py::class_<ProjectionSynapseProxy<st::synapse_type>>(                                                          \
+            BOOST_PP_STRINGIZE(BOOST_PP_CAT(synapse_type, ProjectionSynapse)),                                         \
+            "View of a synapse stored in the projection.", py::no_init)                                                \
+            .add_property(                                                                                             \
+                "params",                                                                                              \
+                py::make_function(                                                                                     \
+                    &ProjectionSynapseProxy<st::synapse_type>::get_params, py::return_internal_reference<>()),         \
+                &ProjectionSynapseProxy<st::synapse_type>::set_params, "Synapse parameters.")                          \
+            .add_property(                                                                                             \
+                "source_neuron_id", &ProjectionSynapseProxy<st::synapse_type>::get_source_neuron_id,                   \
+                "Index of the presynaptic neuron.")                                                                    \
+            .add_property(                                                                                             \
+                "target_neuron_id", &ProjectionSynapseProxy<st::synapse_type>::get_target_neuron_id,                   \
+                "Index of the postsynaptic neuron.");                                                                  \
+                                                                                                                       \
+        py::class_<ProjectionSynapseIterator<st::synapse_type>>(                                                       \
+            BOOST_PP_STRINGIZE(BOOST_PP_CAT(synapse_type, ProjectionIterator)),                                        \
+            "Iterator over synapses of the projection.", py::no_init)                                                  \
+            .def("__iter__", make_handler([](const py::object &self) { return self; }))                               \
+            .def("__next__", &ProjectionSynapseIterator<st::synapse_type>::next);                                      \
+                                                                                                                       \
         py::class_<core::Projection<st::synapse_type>>(                                                                \
             BOOST_PP_STRINGIZE(                                             \
                 BOOST_PP_CAT(synapse_type, Projection)),                                                               \
@@ -103,18 +124,14 @@ py::class_<core::Synapse>(
                     "uid", make_handler([](core::Projection<st::synapse_type> &proj) { return proj.get_uid(); }),      \
                     "Get projection UID.")                                                                             \
                 .def(                                                                                                  \
-                    "__iter__", py::iterator<core::Projection<st::synapse_type>>(),                                    \
+                    "__iter__", &projection_iter_wrapper<st::synapse_type>,                                            \
                     "Get an iterator of the projection.")                                                              \
                 .def(                                                                                                  \
                     "__len__", &core::Projection<st::synapse_type>::size,                                              \
                     "Count number of synapses in the projection.")                                                     \
                 .def(                                                                                                  \
-                    "__getitem__",                                                                                     \
-                    static_cast<core::Projection<st::synapse_type>::Synapse &(                                         \
-                        core::Projection<st::synapse_type>::*)(size_t)>(                                               \
-                        &core::Projection<st::synapse_type>::operator[]),                                              \
-                    py::return_internal_reference<>(),                                                                 \
-                    "Get parameter values of a synapse with the given index.");  // NOLINT
+                    "__getitem__", &projection_get_synapse_wrapper<st::synapse_type>,                                  \
+                    "Get a view of the synapse with the given index.");  // NOLINT
 
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_PY_PROJECTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_SYNAPSES))  //!OCLINT(Parameters used)
 
@@ -27,6 +27,7 @@
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <utility>
 
 #include <boost/python/tuple.hpp>
 
@@ -85,3 +86,90 @@ void projection_synapses_add_wrapper(
 {
     projection.add_synapses(ProjectionGeneratorProxy<ElemType>(gen_func), num_iterations);
 };
+
+
+/**
+ * @brief Python view of a synapse stored in a projection.
+ * @details Synapse parameters and neuron indexes are stored in separate arrays, so the view keeps the projection and
+ * the synapse index instead of a copy of the synapse. Changes made via the view are applied to the projection.
+ */
+template <typename ElemType>
+class ProjectionSynapseProxy
+{
+public:
+    ProjectionSynapseProxy(py::object projection, size_t index) : projection_(std::move(projection)), index_(index) {}
+
+    typename core::Projection<ElemType>::SynapseParameters &get_params()
+    {
+        return std::get<core::synapse_data>(get_projection()[index_]);
+    }
+
+    void set_params(const typename core::Projection<ElemType>::SynapseParameters &params)
+    {
+        std::get<core::synapse_data>(get_projection()[index_]) = params;
+    }
+
+    size_t get_source_neuron_id() { return std::get<core::source_neuron_id>(get_projection()[index_]); }
+
+    size_t get_target_neuron_id() { return std::get<core::target_neuron_id>(get_projection()[index_]); }
+
+private:
+    core::Projection<ElemType> &get_projection()
+    {
+        auto &projection = py::extract<core::Projection<ElemType> &>(projection_)();
+        if (index_ >= projection.size())
+        {
+            PyErr_SetString(PyExc_IndexError, "Synapse was removed from the projection.");
+            py::throw_error_already_set();
+        }
+        return projection;
+    }
+
+    // The projection object is kept alive while the view exists.
+    py::object projection_;
+    size_t index_;
+};
+
+
+/**
+ * @brief Python iterator over projection synapses that creates synapse views on demand.
+ */
+template <typename ElemType>
+class ProjectionSynapseIterator
+{
+public:
+    explicit ProjectionSynapseIterator(py::object projection) : projection_(std::move(projection)) {}
+
+    ProjectionSynapseProxy<ElemType> next()
+    {
+        if (index_ >= py::extract<const core::Projection<ElemType> &>(projection_)().size())
+        {
+            PyErr_SetString(PyExc_StopIteration, "No more synapses.");
+            py::throw_error_already_set();
+        }
+        return ProjectionSynapseProxy<ElemType>(projection_, index_++);
+    }
+
+private:
+    py::object projection_;
+    size_t index_ = 0;
+};
+
+
+template <typename ElemType>
+ProjectionSynapseProxy<ElemType> projection_get_synapse_wrapper(const py::object &projection, size_t index)
+{
+    if (index >= py::extract<const core::Projection<ElemType> &>(projection)().size())
+    {
+        PyErr_SetString(PyExc_IndexError, "Synapse index is out of range.");
+        py::throw_error_already_set();
+    }
+    return ProjectionSynapseProxy<ElemType>(projection, index);
+};
+
+
+template <typename ElemType>
+ProjectionSynapseIterator<ElemType> projection_iter_wrapper(const py::object &projection)
+{
+    return ProjectionSynapseIterator<ElemType>(projection);
+};
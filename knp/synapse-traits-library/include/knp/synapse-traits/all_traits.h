@@ -25,6 +25,7 @@
 
 #include <boost/mp11.hpp>
 
+#include "compressed_delta.h"
 #include "delta.h"
 #include "stdp_type_traits.h"
 
@@ -37,7 +38,9 @@ namespace knp::synapse_traits
 /**
  * @brief Comma-separated list of synapse tags.
  */
-#define ALL_SYNAPSES DeltaSynapse, AdditiveSTDPDeltaSynapse, SynapticResourceSTDPDeltaSynapse
+#define ALL_SYNAPSES                                                                               \
+    DeltaSynapse, AdditiveSTDPDeltaSynapse, SynapticResourceSTDPDeltaSynapse, Float16DeltaSynapse, \
+        BFloat16DeltaSynapse, Int8DeltaSynapse
 
 
 /**
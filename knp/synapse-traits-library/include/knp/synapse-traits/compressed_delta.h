@@ -0,0 +1,387 @@
+/**
+ * @file compressed_delta.h
+ * @brief Type traits of delta synapse with reduced-precision weight.
+ * @kaspersky_support Andrey V.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "delta.h"
+#include "output_types.h"
+#include "type_traits.h"
+
+/**
+ * @brief Namespace for synapse traits.
+ */
+namespace knp::synapse_traits
+{
+
+/**
+ * @brief IEEE 754 half-precision weight encoding.
+ */
+struct Float16WeightEncoding
+{
+    /**
+     * @brief Type of encoded weight.
+     */
+    using StorageType = uint16_t;
+
+    /**
+     * @brief Get scale that allows encoding weights with the given maximum absolute value.
+     * @param max_abs_weight maximum absolute weight value.
+     * @return scale factor.
+     */
+    static float get_scale(float max_abs_weight)
+    {
+        (void)max_abs_weight;
+        return 1.0F;
+    }
+
+    /**
+     * @brief Encode weight.
+     * @details The value is rounded to the nearest representable value, ties to even.
+     * @param weight weight value.
+     * @param scale scale factor.
+     * @return encoded weight.
+     */
+    static StorageType encode(float weight, float scale)
+    {
+        const float value = weight / scale;
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+        const uint32_t abs_bits = bits & 0x7fffffffU;
+
+        // Infinity and NaN.
+        if (abs_bits >= 0x7f800000U) return sign | 0x7c00U | (abs_bits > 0x7f800000U ? 0x200U : 0U);
+        // Values greater or equal to 65520 are rounded to infinity.
+        if (abs_bits >= 0x477ff000U) return sign | 0x7c00U;
+
+        uint32_t shift = 13;
+        uint32_t mantissa = abs_bits - 0x38000000U;
+        if (abs_bits < 0x38800000U)
+        {
+            // Subnormal half-precision values.
+            if (abs_bits < 0x33000000U) return sign;
+            shift = 126 - (abs_bits >> 23);
+            mantissa = (abs_bits & 0x7fffffU) | 0x800000U;
+        }
+
+        uint32_t result = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1U << shift) - 1);
+        const uint32_t halfway = 1U << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1U))) ++result;
+        return static_cast<StorageType>(sign | result);
+    }
+
+    /**
+     * @brief Decode weight.
+     * @param code encoded weight.
+     * @param scale scale factor.
+     * @return weight value.
+     */
+    static float decode(StorageType code, float scale)
+    {
+        const uint32_t sign = static_cast<uint32_t>(code & 0x8000U) << 16;
+        const uint32_t exponent = (code >> 10) & 0x1fU;
+        const uint32_t mantissa = code & 0x3ffU;
+
+        float value = 0;
+        if (0 == exponent)
+        {
+            value = std::ldexp(static_cast<float>(mantissa), -24);
+            if (sign) value = -value;
+        }
+        else
+        {
+            const uint32_t bits = sign | ((0x1fU == exponent ? 0xffU : exponent + 112) << 23) | (mantissa << 13);
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+        return value * scale;
+    }
+};
+
+
+/**
+ * @brief Brain floating-point (bfloat16) weight encoding.
+ */
+struct BFloat16WeightEncoding
+{
+    /**
+     * @brief Type of encoded weight.
+     */
+    using StorageType = uint16_t;
+
+    /**
+     * @brief Get scale that allows encoding weights with the given maximum absolute value.
+     * @param max_abs_weight maximum absolute weight value.
+     * @return scale factor.
+     */
+    static float get_scale(float max_abs_weight)
+    {
+        (void)max_abs_weight;
+        return 1.0F;
+    }
+
+    /**
+     * @brief Encode weight.
+     * @details The value is rounded to the nearest representable value, ties to even.
+     * @param weight weight value.
+     * @param scale scale factor.
+     * @return encoded weight.
+     */
+    static StorageType encode(float weight, float scale)
+    {
+        const float value = weight / scale;
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // Keep NaN a NaN after truncation.
+        if ((bits & 0x7fffffffU) > 0x7f800000U) return static_cast<StorageType>((bits >> 16) | 0x40U);
+        bits += 0x7fffU + ((bits >> 16) & 1U);
+        return static_cast<StorageType>(bits >> 16);
+    }
+
+    /**
+     * @brief Decode weight.
+     * @param code encoded weight.
+     * @param scale scale factor.
+     * @return weight value.
+     */
+    static float decode(StorageType code, float scale)
+    {
+        const uint32_t bits = static_cast<uint32_t>(code) << 16;
+        float value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value * scale;
+    }
+};
+
+
+/**
+ * @brief Symmetric 8-bit integer weight encoding.
+ * @details Weight value equals the encoded integer multiplied by the scale factor.
+ */
+struct Int8WeightEncoding
+{
+    /**
+     * @brief Type of encoded weight.
+     */
+    using StorageType = int8_t;
+
+    /**
+     * @brief Maximum absolute value of the encoded weight.
+     */
+    constexpr static int max_code = 127;
+
+    /**
+     * @brief Get scale that allows encoding weights with the given maximum absolute value.
+     * @param max_abs_weight maximum absolute weight value.
+     * @return scale factor.
+     */
+    static float get_scale(float max_abs_weight)
+    {
+        return max_abs_weight > 0 ? max_abs_weight / static_cast<float>(max_code) : 1.0F;
+    }
+
+    /**
+     * @brief Encode weight.
+     * @details Values out of the range are saturated.
+     * @param weight weight value.
+     * @param scale scale factor.
+     * @return encoded weight.
+     */
+    static StorageType encode(float weight, float scale)
+    {
+        const float code = std::nearbyint(weight / scale);
+        return static_cast<StorageType>(
+            std::clamp(code, -static_cast<float>(max_code), static_cast<float>(max_code)));
+    }
+
+    /**
+     * @brief Decode weight.
+     * @param code encoded weight.
+     * @param scale scale factor.
+     * @return weight value.
+     */
+    static float decode(StorageType code, float scale) { return static_cast<float>(code) * scale; }
+};
+
+
+/**
+ * @brief Delta synapse with reduced-precision weight.
+ * @details Synapse stores an encoded weight. Scale factors for weights are shared between projection synapses.
+ * @tparam WeightEncoding weight encoding type.
+ * @note Use as a template parameter only.
+ */
+template <class WeightEncoding>
+struct CompressedDeltaSynapse;
+
+
+/**
+ * @brief Delta synapse with half-precision weight.
+ */
+using Float16DeltaSynapse = CompressedDeltaSynapse<Float16WeightEncoding>;
+
+
+/**
+ * @brief Delta synapse with bfloat16 weight.
+ */
+using BFloat16DeltaSynapse = CompressedDeltaSynapse<BFloat16WeightEncoding>;
+
+
+/**
+ * @brief Delta synapse with 8-bit integer weight.
+ */
+using Int8DeltaSynapse = CompressedDeltaSynapse<Int8WeightEncoding>;
+
+
+/**
+ * @brief Default values for compressed delta synapse parameters.
+ * @tparam WeightEncoding weight encoding type.
+ */
+template <class WeightEncoding>
+struct default_values<CompressedDeltaSynapse<WeightEncoding>>
+{
+    /**
+     * @brief Synaptic weight default value.
+     */
+    constexpr static float weight_ = default_values<DeltaSynapse>::weight_;
+
+    /**
+     * @brief Synaptic delay default value.
+     */
+    constexpr static uint16_t delay_ = default_values<DeltaSynapse>::delay_;
+
+    /**
+     * @brief Synapse type default value.
+     */
+    constexpr static OutputType output_type_ = default_values<DeltaSynapse>::output_type_;
+};
+
+
+/**
+ * @brief Structure for compressed delta synapse parameters.
+ * @tparam WeightEncoding weight encoding type.
+ */
+template <class WeightEncoding>
+struct synapse_parameters<CompressedDeltaSynapse<WeightEncoding>>
+{
+    /**
+     * @brief Type of encoded weight.
+     */
+    using WeightCodeType = typename WeightEncoding::StorageType;
+
+    /**
+     * @brief Default constructor.
+     */
+    synapse_parameters()
+        : weight_code_(WeightEncoding::encode(default_values<CompressedDeltaSynapse<WeightEncoding>>::weight_, 1.0F)),
+          output_type_(default_values<CompressedDeltaSynapse<WeightEncoding>>::output_type_),
+          delay_(default_values<CompressedDeltaSynapse<WeightEncoding>>::delay_)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param weight_code encoded synaptic weight.
+     * @param delay synaptic delay (number of steps).
+     * @param type impact type.
+     */
+    synapse_parameters(WeightCodeType weight_code, uint16_t delay, OutputType type)
+        : weight_code_(weight_code), output_type_(type), delay_(delay)
+    {
+    }
+
+    /**
+     * @brief Encoded synaptic weight.
+     * @details Use shared projection parameters to decode the weight.
+     */
+    WeightCodeType weight_code_;
+
+    /**
+     * @brief Synapse type.
+     */
+    OutputType output_type_;
+
+    /**
+     * @brief Synaptic delay.
+     */
+    uint16_t delay_;
+};
+
+
+/**
+ * @brief Weight scale factors shared between synapses of a compressed delta projection.
+ * @tparam WeightEncoding weight encoding type.
+ */
+template <class WeightEncoding>
+struct shared_synapse_parameters<CompressedDeltaSynapse<WeightEncoding>>
+{
+    /**
+     * @brief Get scale factor for synapses of the given presynaptic neuron.
+     * @param presynaptic_index presynaptic neuron index.
+     * @return scale factor.
+     */
+    [[nodiscard]] float get_scale(size_t presynaptic_index) const
+    {
+        return presynaptic_scales_.empty() ? scale_ : presynaptic_scales_[presynaptic_index];
+    }
+
+    /**
+     * @brief Decode synaptic weight.
+     * @param params synapse parameters.
+     * @param presynaptic_index presynaptic neuron index of the synapse.
+     * @return weight value.
+     */
+    [[nodiscard]] float decode_weight(
+        const synapse_parameters<CompressedDeltaSynapse<WeightEncoding>> &params, size_t presynaptic_index) const
+    {
+        return WeightEncoding::decode(params.weight_code_, get_scale(presynaptic_index));
+    }
+
+    /**
+     * @brief Encode synaptic weight.
+     * @param weight weight value.
+     * @param presynaptic_index presynaptic neuron index of the synapse.
+     * @return encoded weight.
+     */
+    [[nodiscard]] typename WeightEncoding::StorageType encode_weight(float weight, size_t presynaptic_index) const
+    {
+        return WeightEncoding::encode(weight, get_scale(presynaptic_index));
+    }
+
+    /**
+     * @brief Scale factor for all projection synapses.
+     */
+    float scale_ = 1.0F;
+
+    /**
+     * @brief Scale factors for synapses of each presynaptic neuron.
+     * @details If the vector is not empty, it is used instead of `scale_`.
+     */
+    std::vector<float> presynaptic_scales_;
+};
+
+}  // namespace knp::synapse_traits
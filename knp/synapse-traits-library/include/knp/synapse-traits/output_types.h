@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cinttypes>
+
 /**
  * @brief Namespace for synapse traits.
  */
@@ -32,7 +34,7 @@ namespace knp::synapse_traits
  * @todo Improve descriptions.
  * Maybe split this enum.
  */
-enum class OutputType
+enum class OutputType : uint8_t
 {
     /**
      * @brief Excitatory synapse type.
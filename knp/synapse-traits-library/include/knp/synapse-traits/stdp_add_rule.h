@@ -34,7 +34,9 @@ namespace knp::synapse_traits
 {
 /**
  * @brief STDP additive rule parameters.
- * @note Parameters for the `W(x)` function by Zhang et al. 1998.
+ * @details Additive STDP keeps no spike history in synapses. Spike times are represented by exponential traces of
+ * presynaptic and postsynaptic neurons that are stored in the shared projection parameters.
+ * @note Parameters of the `W(x)` function by Zhang et al. 1998 are shared between all projection synapses.
  */
 template <typename SynapseType>
 struct STDPAdditiveRule
@@ -43,26 +45,115 @@ struct STDPAdditiveRule
      * @brief Type of the synapse linked with rule.
      */
     using LinkedSynapseType = SynapseType;
+};
+
+
+/**
+ * @brief Pairing of presynaptic and postsynaptic spikes in additive STDP.
+ */
+enum class STDPPairing
+{
+    /**
+     * @brief A spike is paired with all earlier spikes of the other neuron.
+     */
+    all_to_all,
+    /**
+     * @brief A spike is paired with the nearest earlier spike of the other neuron.
+     */
+    nearest_neighbour
+};
+
 
+/**
+ * @brief Exponential trace of neuron spikes.
+ */
+struct STDPSpikeTrace
+{
+    /**
+     * @brief Trace value at the step `step_`.
+     */
+    float value_ = 0;
+
+    /**
+     * @brief Step of the last trace update.
+     */
+    uint64_t step_ = 0;
+};
+
+
+/**
+ * @brief Parameters and spike traces shared between synapses of an additive STDP projection.
+ * @details A presynaptic spike at step `t_f` and a postsynaptic spike at step `t_n` change the synapse weight by
+ * `a_plus_ * exp(-(t_n - t_f) / tau_plus_)` if `t_n > t_f`, and by `a_minus_ * exp((t_n - t_f) / tau_minus_)`
+ * otherwise. The weight changes when the later spike of a pair is registered.
+ * @tparam SynapseType base synapse type.
+ */
+template <typename SynapseType>
+struct shared_synapse_parameters<STDP<STDPAdditiveRule, SynapseType>>
+{
     /**
-     * @brief Time constant in milliseconds intended to increase the weight.
+     * @brief Time constant in steps of the weight change when a postsynaptic spike follows a presynaptic spike.
      */
     float tau_plus_ = 10;
 
     /**
-     * @brief Time constant in milliseconds intended to decrease the weight.
+     * @brief Time constant in steps of the weight change when a presynaptic spike follows a postsynaptic spike.
      */
     float tau_minus_ = 10;
 
     /**
-     * @brief Indexes of network execution steps on which spikes on the synapse were generated.
+     * @brief Maximum weight change when a postsynaptic spike follows a presynaptic spike.
+     */
+    float a_plus_ = 1;
+
+    /**
+     * @brief Maximum weight change when a presynaptic spike follows or coincides with a postsynaptic spike.
+     * @note Use a negative value to depress synapses.
+     */
+    float a_minus_ = 1;
+
+    /**
+     * @brief Pairing of presynaptic and postsynaptic spikes.
+     */
+    STDPPairing pairing_ = STDPPairing::all_to_all;
+
+    /**
+     * @brief Traces of presynaptic neurons that decay with the `tau_plus_` time constant.
+     */
+    std::vector<STDPSpikeTrace> presynaptic_traces_;
+
+    /**
+     * @brief Traces of postsynaptic neurons that decay with the `tau_minus_` time constant.
+     */
+    std::vector<STDPSpikeTrace> postsynaptic_traces_;
+
+    /**
+     * @brief Number of steps between applications of weight changes.
+     * @details Weight changes are summed in `pending_weight_changes_` and applied to synapses in one pass on steps
+     * `n` such that `(n + 1) % weight_update_interval_ == 0`. Value of `1` applies changes on every step.
+     */
+    uint32_t weight_update_interval_ = 1;
+
+    /**
+     * @brief Apply weight changes at the end of a step instead of before synaptic impacts are calculated.
+     * @details If `false`, changes are applied when spikes are registered, so impacts of step `n` use updated
+     * weights. If `true`, changes are applied after impacts of step `n` are calculated, at the `gad_step()` boundary.
+     */
+    bool update_weights_at_step_end_ = false;
+
+    /**
+     * @brief Sums of weight changes that are not applied yet, indexed by synapse.
+     * @details The array grows to the projection size when a change is recorded. Projections apply pending changes
+     * before synapses are added, removed or reordered, and when weights are locked.
+     * @see knp::core::Projection::flush_weight_changes().
      */
-    std::vector<uint64_t> presynaptic_spike_times_;
+    std::vector<float> pending_weight_changes_;
 
     /**
-     * @brief Indexes of network execution steps on which spikes on the axon were generated.
+     * @brief Indexes of synapses that have pending weight changes.
+     * @details An index can be repeated if the sum of changes of a synapse returned to zero.
      */
-    std::vector<uint64_t> postsynaptic_spike_times_;
+    std::vector<size_t> pending_synapses_;
 };
 
 }  // namespace knp::synapse_traits
@@ -19,17 +19,22 @@
  * limitations under the License.
  */
 
+#include <knp/backends/cpu-library/impl/step_arena_impl.h>
 #include <knp/backends/cpu-multi-threaded/backend.h>
+#include <knp/backends/thread_pool/thread_pool.h>
 #include <knp/backends/thread_pool/thread_pool_context.h>
 #include <knp/backends/thread_pool/thread_pool_executor.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
 
 #include <generators.h>
+#include <smallest_network.h>
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <algorithm>
 #include <functional>
+#include <thread>
 #include <vector>
 
 
@@ -44,6 +49,10 @@ class MTestingBack : public knp::backends::multi_threaded_cpu::MultiThreadedCPUB
 {
 public:
     MTestingBack() = default;
+    MTestingBack(size_t thread_count, size_t population_part_size)
+        : knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend(thread_count, population_part_size)
+    {
+    }
     void _init() override { knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend::_init(); }
 };
 
@@ -117,6 +126,123 @@ TEST(MultiThreadCpuSuite, SmallestNetwork)
 }
 
 
+TEST(MultiThreadCpuSuite, StepArenaNetwork)
+{
+    // Temporary data of a step is allocated from thread arenas, results are the same as in the smallest network.
+    namespace kt = knp::testing;
+    kt::MTestingBack backend;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    Projection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    Projection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+    knp::core::UID input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    backend._init();
+    ASSERT_EQ(backend.get_step_arena_high_water_mark(), 0);
+
+    ASSERT_EQ(
+        knp::testing::run_smallest_network(backend, input_uid, population.get_uid()),
+        knp::testing::smallest_network_results);
+    ASSERT_GT(backend.get_step_arena_high_water_mark(), 0);
+}
+
+
+TEST(MultiThreadCpuSuite, StepArenasThreadCache)
+{
+    // A thread gets the same arena of the same arenas, and different arenas of different arenas and threads.
+    knp::backends::cpu::StepArenas first_arenas;
+    knp::backends::cpu::StepArenas second_arenas;
+    auto &first_arena = first_arenas.get_local();
+    auto &second_arena = second_arenas.get_local();
+    ASSERT_NE(&first_arena, &second_arena);
+    ASSERT_EQ(&first_arenas.get_local(), &first_arena);
+    ASSERT_EQ(&second_arenas.get_local(), &second_arena);
+
+    knp::backends::cpu::StepArena *other_thread_arena = nullptr;
+    std::thread([&first_arenas, &other_thread_arena]() { other_thread_arena = &first_arenas.get_local(); }).join();
+    ASSERT_NE(other_thread_arena, &first_arena);
+    ASSERT_EQ(&first_arenas.get_local(), &first_arena);
+}
+
+
+TEST(MultiThreadCpuSuite, ShardedImpactProcessing)
+{
+    // Impacts on a population larger than a part are processed by several threads, each thread updates its own part.
+    constexpr size_t neurons_count = 10;
+    knp::testing::MTestingBack backend(4, 3);
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, neurons_count};
+    const knp::core::UID in_uid;
+    backend.subscribe<knp::core::messaging::SynapticImpactMessage>(population.get_uid(), {in_uid});
+    backend.load_populations({population});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    knp::core::messaging::SynapticImpactMessage message{{in_uid, 0}, knp::core::UID{false}, population.get_uid()};
+    for (uint32_t index = 0; index < neurons_count; ++index)
+    {
+        message.impacts_.push_back(
+            {index, 0.0625F * static_cast<float>(index), knp::synapse_traits::OutputType::EXCITATORY, 0, index});
+        message.impacts_.push_back(
+            {index, 0.03125F, knp::synapse_traits::OutputType::EXCITATORY, 0,
+             static_cast<uint32_t>(neurons_count - 1 - index)});
+    }
+    endpoint.send_message(message);
+    // The backend receives messages after populations are calculated, so impacts are processed on the second step.
+    backend._step();
+    backend._step();
+
+    const auto &neurons = std::get<knp::testing::BLIFATPopulation>(*backend.begin_populations());
+    for (size_t index = 0; index < neurons_count; ++index)
+    {
+        ASSERT_DOUBLE_EQ(neurons[index].potential_, 0.0625 * static_cast<double>(index) + 0.03125);
+    }
+}
+
+
+TEST(MultiThreadCpuSuite, NumaAwareImpactProcessing)
+{
+    // Parts of a population are scheduled on their home nodes, results do not depend on the mode.
+    constexpr size_t neurons_count = 10;
+    knp::testing::MTestingBack backend(4, 3);
+    backend.set_numa_aware(true);
+    if (!backend.is_numa_aware()) GTEST_SKIP() << "NUMA topology is unknown.";
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, neurons_count};
+    const knp::core::UID in_uid;
+    backend.subscribe<knp::core::messaging::SynapticImpactMessage>(population.get_uid(), {in_uid});
+    backend.load_populations({population});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    knp::core::messaging::SynapticImpactMessage message{{in_uid, 0}, knp::core::UID{false}, population.get_uid()};
+    for (uint32_t index = 0; index < neurons_count; ++index)
+    {
+        message.impacts_.push_back(
+            {index, 0.0625F * static_cast<float>(index), knp::synapse_traits::OutputType::EXCITATORY, 0, index});
+    }
+    endpoint.send_message(message);
+    backend._step();
+    // Switching the mode recreates the pool between steps.
+    backend.set_numa_aware(false);
+    ASSERT_FALSE(backend.is_numa_aware());
+    // Arenas of the old workers are freed with the pool.
+    ASSERT_EQ(backend.get_step_arena_high_water_mark(), 0);
+    backend._step();
+
+    const auto &neurons = std::get<knp::testing::BLIFATPopulation>(*backend.begin_populations());
+    for (size_t index = 0; index < neurons_count; ++index)
+    {
+        ASSERT_DOUBLE_EQ(neurons[index].potential_, 0.0625 * static_cast<double>(index));
+    }
+}
+
+
 TEST(MultiThreadCpuSuite, SmallestResourceNetwork)
 {
     // Create a single-neuron neural network: input -> input_projection -> population <=> loop_projection.
@@ -160,6 +286,91 @@ TEST(MultiThreadCpuSuite, SmallestResourceNetwork)
 }
 
 
+std::vector<float> run_resource_stdp_chain(knp::testing::MTestingBack &backend)
+{
+    // Create a chain of neurons, each neuron also gets inputs: input -> input_projection -> population, neuron i ->
+    // loop_projection -> neuron i + 1.
+    namespace kt = knp::testing;
+    constexpr size_t neurons_count = 10;
+
+    kt::ResourceBlifatPopulation population{
+        [](size_t index)
+        {
+            auto neuron = kt::neuron_res_generator(index);
+            neuron.synaptic_resource_threshold_ = 1;
+            neuron.free_synaptic_resource_ = 0.5F * static_cast<float>(index);
+            neuron.isi_max_ = 0;
+            return neuron;
+        },
+        neurons_count};
+    auto input_projection = kt::ResourceDeltaProjection{
+        knp::core::UID{false}, population.get_uid(),
+        [](size_t index)
+        {
+            auto synapse = kt::input_res_projection_gen(index);
+            std::get<knp::core::source_neuron_id>(*synapse) = index;
+            std::get<knp::core::target_neuron_id>(*synapse) = index;
+            return synapse;
+        },
+        neurons_count};
+    auto loop_projection = kt::ResourceDeltaProjection{
+        population.get_uid(), population.get_uid(),
+        [](size_t index)
+        {
+            auto synapse = kt::loop_res_projection_gen(index);
+            std::get<knp::core::source_neuron_id>(*synapse) = index;
+            std::get<knp::core::target_neuron_id>(*synapse) = index + 1;
+            return synapse;
+        },
+        neurons_count - 1};
+    const knp::core::UID input_uid = input_projection.get_uid();
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+
+    backend._init();
+    backend.start_learning();
+
+    for (knp::core::Step step = 0; step < 30; ++step)
+    {
+        // Even neurons get inputs on steps 0, 5, 10...
+        if (step % 5 == 0)
+        {
+            endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0, 2, 4, 6, 8}});
+        }
+        backend._step();
+    }
+
+    std::vector<float> weights;
+    for (auto proj = backend.begin_projections(); proj != backend.end_projections(); ++proj)
+    {
+        const auto &projection = std::get<kt::ResourceDeltaProjection>(proj->arg_);
+        std::transform(
+            projection.begin(), projection.end(), std::back_inserter(weights),
+            [](const auto &synapse) { return std::get<knp::core::synapse_data>(synapse).weight_; });
+    }
+    return weights;
+}
+
+
+TEST(MultiThreadCpuSuite, PartitionedResourcePlasticity)
+{
+    // Plasticity of a population larger than a part is calculated by several threads. The weights must be the same
+    // as the weights calculated for the whole population at once.
+    knp::testing::MTestingBack partitioned_backend(4, 3);
+    knp::testing::MTestingBack whole_backend(1, 100);
+
+    const auto partitioned_weights = run_resource_stdp_chain(partitioned_backend);
+    const auto whole_weights = run_resource_stdp_chain(whole_backend);
+
+    ASSERT_EQ(partitioned_weights, whole_weights);
+    ASSERT_NE(whole_weights, std::vector<float>(whole_weights.size(), 1.5F));
+}
+
+
 TEST(MultiThreadCpuSuite, NeuronsGettingTest)
 {
     const knp::testing::MTestingBack backend;
@@ -182,6 +393,28 @@ TEST(MultiThreadCpuSuite, SynapsesGettingTest)
 }
 
 
+TEST(MultiThreadCpuSuite, TopologyDefaults)
+{
+    // The thread count that is not set is calculated from the CPU topology, part sizes that are not set are defaults.
+    namespace mt = knp::backends::multi_threaded_cpu;
+    const knp::testing::MTestingBack default_backend;
+    ASSERT_GT(default_backend.get_thread_count(), 0);
+    ASSERT_EQ(default_backend.get_population_part_size(), mt::default_population_part_size);
+    ASSERT_EQ(default_backend.get_projection_part_size(), mt::default_projection_part_size);
+    ASSERT_LE(default_backend.get_thread_count(), std::max<size_t>(std::thread::hardware_concurrency(), 1));
+
+    const knp::testing::MTestingBack backend(3, 5);
+    ASSERT_EQ(backend.get_thread_count(), 3);
+    ASSERT_EQ(backend.get_population_part_size(), 5);
+
+    // Cache-sized parts are used only if they are passed explicitly.
+    const auto cache_part_size = mt::MultiThreadedCPUBackend::get_cache_population_part_size();
+    ASSERT_GT(cache_part_size, 0);
+    ASSERT_GT(mt::MultiThreadedCPUBackend::get_cache_projection_part_size(), 0);
+    ASSERT_EQ(knp::testing::MTestingBack(3, cache_part_size).get_population_part_size(), cache_part_size);
+}
+
+
 void fibonacci(const uint64_t begin, uint64_t iterations, uint64_t *result)
 {
     // This function calculates last 3 digits of "begin * Fibonacci(iterations)".
@@ -227,3 +460,20 @@ TEST(MultiThreadCpuSuite, ThreadPoolTest)
     ASSERT_EQ(result[1], 445);
     ASSERT_EQ(result[0], result[7]);  // Delayed tasks should give the same results as the first ones.
 }
+
+
+TEST(MultiThreadCpuSuite, NumaThreadPoolTest)
+{
+    // Tasks posted to any node are executed, workers of other nodes take them if the node is busy.
+    const std::vector<knp::backends::cpu_executors::NumaNode> nodes{{0, {0}}, {1, {0}}};
+    knp::backends::cpu_executors::ThreadPool pool(3, nodes);
+    ASSERT_EQ(pool.get_nodes_count(), 2);
+
+    std::vector<uint64_t> result(8);
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        pool.post_on_node(i, fibonacci, 7, 10, &result[i]);
+    }
+    pool.join();
+    ASSERT_TRUE(std::all_of(result.begin(), result.end(), [](uint64_t value) { return value == 623; }));
+}
@@ -19,17 +19,27 @@
  * limitations under the License.
  */
 
+#include <knp/backends/cpu-library/impl/additive_stdp_impl.h>
 #include <knp/backends/cpu-single-threaded/backend.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/core/storage_allocator.h>
 #include <knp/framework/network.h>
+#include <knp/framework/projection/creators.h>
+#include <knp/neuron-traits/altai_lif.h>
 #include <knp/neuron-traits/blifat.h>
+#include <knp/neuron-traits/homogeneous_blifat.h>
+#include <knp/synapse-traits/compressed_delta.h>
 #include <knp/synapse-traits/delta.h>
 
 #include <generators.h>
+#include <smallest_network.h>
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <vector>
 
 
@@ -99,18 +109,332 @@ TEST(SingleThreadCpuSuite, SmallestNetwork)
 }
 
 
+template <typename NeuronType>
+std::vector<knp::core::Step> run_blifat_like_smallest_network()
+{
+    knp::testing::STestingBack backend;
+
+    knp::core::Population<NeuronType> population{
+        [](size_t) { return knp::neuron_traits::neuron_parameters<NeuronType>{}; }, 1};
+    Projection loop_projection =
+        knp::testing::DeltaProjection{population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+    backend._init();
+
+    return knp::testing::run_smallest_network(backend, input_uid, population.get_uid());
+}
+
+
+TEST(SingleThreadCpuSuite, SmallestNetworkHomogeneousPopulation)
+{
+    // The same network as in the SmallestNetwork test, but neurons share static parameters.
+    ASSERT_EQ(
+        run_blifat_like_smallest_network<knp::neuron_traits::HomogeneousBLIFATNeuron>(),
+        knp::testing::smallest_network_results);
+}
+
+
+TEST(SingleThreadCpuSuite, SmallestNetworkFloat32Population)
+{
+    // Single-precision neurons must spike on the same steps as double-precision neurons.
+    const auto float_results = run_blifat_like_smallest_network<knp::neuron_traits::Float32BLIFATNeuron>();
+    ASSERT_EQ(float_results, run_blifat_like_smallest_network<knp::neuron_traits::BLIFATNeuron>());
+    ASSERT_EQ(float_results, knp::testing::smallest_network_results);
+}
+
+
+struct ChainNetworkResult
+{
+    std::vector<std::pair<knp::core::Step, knp::core::messaging::SpikeData>> spikes_;
+    std::vector<double> potentials_;
+    std::vector<double> dynamic_thresholds_;
+};
+
+
+ChainNetworkResult run_chain_network(
+    bool lazy_decay, size_t neurons_count = 50, bool use_features = false,
+    const knp::core::StoragePolicy *storage_policy = nullptr, bool use_blocking = false)
+{
+    // A chain of neurons with decaying potentials: only a few neurons receive input on each step.
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{
+        [neurons_count, use_features, use_blocking](size_t index)
+        {
+            knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron> neuron;
+            neuron.potential_decay_ = 0.9;
+            neuron.threshold_decay_ = 0.8;
+            neuron.threshold_increment_ = 0.5;
+            neuron.postsynaptic_trace_decay_ = 0.7;
+            neuron.postsynaptic_trace_increment_ = 1;
+            neuron.potential_ = 0.01 * static_cast<double>(index % 7);
+            if (use_blocking)
+            {
+                // Neurons blocked for 30 steps, blocked forever and unblocked for 3 steps.
+                constexpr int64_t blocking_periods[] = {-30, 0, 3};
+                if (index % 4 < 3) neuron.total_blocking_period_ = blocking_periods[index % 4];
+            }
+            if (!use_features) return neuron;
+            // Quarters of the population use different combinations of bursting and stochastic stimulation.
+            const size_t quarter = 4 * index / neurons_count;
+            if (quarter & 1)
+            {
+                neuron.bursting_period_ = 2;
+                neuron.reflexive_weight_ = 0.3;
+            }
+            if (quarter & 2) neuron.stochastic_stimulation_ = 0.2;
+            neuron.random_number_generator_state_ = index;
+            return neuron;
+        },
+        neurons_count};
+    Projection chain_projection = knp::testing::DeltaProjection{
+        population.get_uid(), population.get_uid(),
+        [neurons_count](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.1, static_cast<uint32_t>(1 + index % 3), knp::synapse_traits::OutputType::EXCITATORY}, index,
+                (index + 1) % neurons_count};
+        },
+        neurons_count};
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population.get_uid(),
+        [](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.2, 1, knp::synapse_traits::OutputType::EXCITATORY}, index, index * 10};
+        },
+        neurons_count / 10};
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, chain_projection});
+    backend.set_lazy_decay(lazy_decay);
+    if (storage_policy) backend.set_storage_policy(*storage_policy);
+
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+
+    ChainNetworkResult result;
+
+    for (knp::core::Step step = 0; step < 100; ++step)
+    {
+        if (step % 7 == 0)
+        {
+            knp::core::messaging::SpikeMessage message{
+                {in_channel_uid, step}, {static_cast<uint32_t>(step % 5), static_cast<uint32_t>((step + 2) % 5)}};
+            endpoint.send_message(message);
+        }
+        backend._step();
+        endpoint.receive_all_messages();
+        for (const auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+        {
+            result.spikes_.emplace_back(step, message.neuron_indexes_);
+        }
+    }
+
+    // Non-constant population access applies skipped steps to quiescent neurons.
+    const auto &calculated_population = std::get<knp::testing::BLIFATPopulation>(*backend.begin_populations());
+    for (const auto &neuron : calculated_population)
+    {
+        result.potentials_.push_back(neuron.potential_);
+        result.dynamic_thresholds_.push_back(neuron.dynamic_threshold_);
+    }
+    return result;
+}
+
+
+TEST(SingleThreadCpuSuite, PopulationsLoadOrder)
+{
+    // Populations of different types are calculated in the load order, so spike messages are sent in that order.
+    using AltAIPopulation = knp::core::Population<knp::neuron_traits::AltAILIF>;
+    const auto blifat_generator = [](size_t)
+    {
+        knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron> neuron;
+        neuron.potential_ = 10;
+        neuron.potential_decay_ = 1;
+        neuron.n_time_steps_since_last_firing_ = 0;
+        return neuron;
+    };
+    const auto altai_generator = [](size_t)
+    {
+        knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF> neuron;
+        neuron.potential_ = 10;
+        return neuron;
+    };
+    knp::testing::BLIFATPopulation first_population{blifat_generator, 1};
+    AltAIPopulation second_population{altai_generator, 1};
+    knp::testing::BLIFATPopulation third_population{blifat_generator, 1};
+
+    knp::testing::STestingBack backend;
+    backend.load_populations({first_population, second_population, third_population});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID out_channel_uid;
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(
+        out_channel_uid, {first_population.get_uid(), second_population.get_uid(), third_population.get_uid()});
+
+    backend._step();
+    endpoint.receive_all_messages();
+    std::vector<knp::core::UID> senders;
+    for (const auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+    {
+        senders.push_back(message.header_.sender_uid_);
+    }
+    ASSERT_EQ(
+        senders,
+        std::vector<knp::core::UID>({first_population.get_uid(), second_population.get_uid(),
+                                     third_population.get_uid()}));
+}
+
+
+TEST(SingleThreadCpuSuite, LazyDecayNetwork)
+{
+    // Lazy decay of quiescent neurons must not change the network behavior.
+    const auto eager_result = run_chain_network(false);
+    const auto lazy_result = run_chain_network(true);
+
+    ASSERT_FALSE(eager_result.spikes_.empty());
+    ASSERT_EQ(eager_result.spikes_, lazy_result.spikes_);
+    ASSERT_EQ(eager_result.potentials_.size(), lazy_result.potentials_.size());
+    for (size_t i = 0; i < eager_result.potentials_.size(); ++i)
+    {
+        ASSERT_NEAR(eager_result.potentials_[i], lazy_result.potentials_[i], 1e-9);
+        ASSERT_NEAR(eager_result.dynamic_thresholds_[i], lazy_result.dynamic_thresholds_[i], 1e-9);
+    }
+}
+
+
+TEST(SingleThreadCpuSuite, LazyDecayBlockedNeurons)
+{
+    // Blocked neurons are never quiescent, neurons that become blocked while quiescent must be calculated correctly.
+    const auto eager_result = run_chain_network(false, 50, false, nullptr, true);
+    const auto lazy_result = run_chain_network(true, 50, false, nullptr, true);
+
+    ASSERT_FALSE(eager_result.spikes_.empty());
+    ASSERT_NE(eager_result.spikes_, run_chain_network(false).spikes_);
+    ASSERT_EQ(eager_result.spikes_, lazy_result.spikes_);
+    for (size_t i = 0; i < eager_result.potentials_.size(); ++i)
+    {
+        ASSERT_NEAR(eager_result.potentials_[i], lazy_result.potentials_[i], 1e-9);
+        ASSERT_NEAR(eager_result.dynamic_thresholds_[i], lazy_result.dynamic_thresholds_[i], 1e-9);
+    }
+}
+
+
+TEST(SingleThreadCpuSuite, TiledPopulationUpdate)
+{
+    // A population that spans several tiles is calculated in one pass, the separate-pass lazy calculation must agree.
+    constexpr size_t neurons_count = 5000;
+    const auto tiled_result = run_chain_network(false, neurons_count);
+    const auto lazy_result = run_chain_network(true, neurons_count);
+
+    ASSERT_FALSE(tiled_result.spikes_.empty());
+    ASSERT_EQ(tiled_result.spikes_, lazy_result.spikes_);
+    ASSERT_EQ(tiled_result.potentials_.size(), neurons_count);
+    for (size_t i = 0; i < neurons_count; ++i)
+    {
+        ASSERT_NEAR(tiled_result.potentials_[i], lazy_result.potentials_[i], 1e-9);
+    }
+}
+
+
+TEST(SingleThreadCpuSuite, MappedStorageNetwork)
+{
+    // Mapped storage of neuron and synapse parameters must not change the network behavior.
+    constexpr size_t neurons_count = 5000;
+    const auto default_result = run_chain_network(false, neurons_count);
+
+    knp::core::StoragePolicy huge_pages_policy;
+    huge_pages_policy.pages_ = knp::core::StoragePages::transparent_huge;
+    huge_pages_policy.numa_placement_ = knp::core::StorageNumaPlacement::interleave;
+    huge_pages_policy.min_mapped_bytes_ = 1;
+    const auto huge_pages_result = run_chain_network(false, neurons_count, false, &huge_pages_policy);
+
+    knp::core::StoragePolicy file_policy;
+    file_policy.backing_directory_ = std::filesystem::temp_directory_path();
+    file_policy.min_mapped_bytes_ = 1;
+    const auto file_result = run_chain_network(false, neurons_count, false, &file_policy);
+
+    ASSERT_FALSE(default_result.spikes_.empty());
+    ASSERT_EQ(default_result.spikes_, huge_pages_result.spikes_);
+    ASSERT_EQ(default_result.potentials_, huge_pages_result.potentials_);
+    ASSERT_EQ(default_result.spikes_, file_result.spikes_);
+    ASSERT_EQ(default_result.potentials_, file_result.potentials_);
+}
+
+
+TEST(SingleThreadCpuSuite, FeatureSpecializedKernels)
+{
+    // Parts of a population without bursting or stochastic stimulation are calculated by specialized kernels, while
+    // lazy calculation uses the generic kernel for active neurons.
+    constexpr size_t neurons_count = 5000;
+    const auto specialized_result = run_chain_network(false, neurons_count, true);
+    const auto lazy_result = run_chain_network(true, neurons_count, true);
+
+    ASSERT_FALSE(specialized_result.spikes_.empty());
+    ASSERT_EQ(specialized_result.spikes_, lazy_result.spikes_);
+    ASSERT_NE(specialized_result.spikes_, run_chain_network(false, neurons_count).spikes_);
+    for (size_t i = 0; i < neurons_count; ++i)
+    {
+        ASSERT_NEAR(specialized_result.potentials_[i], lazy_result.potentials_[i], 1e-9);
+    }
+}
+
+
+template <typename WeightEncoding>
+std::vector<knp::core::Step> run_compressed_smallest_network()
+{
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    Projection loop_projection = knp::framework::projection::creators::compress_projection<WeightEncoding>(
+        knp::testing::DeltaProjection{population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1});
+    Projection input_projection = knp::framework::projection::creators::compress_projection<WeightEncoding>(
+        knp::testing::DeltaProjection{
+            knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1});
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    backend._init();
+
+    return knp::testing::run_smallest_network(backend, input_uid, population.get_uid());
+}
+
+
+TEST(SingleThreadCpuSuite, SmallestNetworkCompressedWeights)
+{
+    // Reduced weight precision must not change the behavior of the network from the SmallestNetwork test.
+    const auto &expected_results = knp::testing::smallest_network_results;
+    ASSERT_EQ(run_compressed_smallest_network<knp::synapse_traits::Float16WeightEncoding>(), expected_results);
+    ASSERT_EQ(run_compressed_smallest_network<knp::synapse_traits::BFloat16WeightEncoding>(), expected_results);
+    ASSERT_EQ(run_compressed_smallest_network<knp::synapse_traits::Int8WeightEncoding>(), expected_results);
+}
+
+
 TEST(SingleThreadCpuSuite, AdditiveSTDPNetwork)
 {
     using STDPDeltaProjection = knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse>;
 
     // Create an STDP input projection.
     auto stdp_input_projection_gen = [](size_t /*index*/) -> std::optional<STDPDeltaProjection::Synapse> {
-        return STDPDeltaProjection::Synapse{{{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, {2, 2}}, 0, 0};
+        return STDPDeltaProjection::Synapse{{{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, {}}, 0, 0};
     };
 
     // Create an STDP loop projection.
     auto stdp_synapse_generator = [](size_t /*index*/) -> std::optional<STDPDeltaProjection::Synapse> {
-        return STDPDeltaProjection::Synapse{{{1.0, 6, knp::synapse_traits::OutputType::EXCITATORY}, {1, 1}}, 0, 0};
+        return STDPDeltaProjection::Synapse{{{1.0, 6, knp::synapse_traits::OutputType::EXCITATORY}, {}}, 0, 0};
     };
 
     auto stdp_neurons_generator = [](size_t /*index*/)  // NOLINT
@@ -129,6 +453,8 @@ TEST(SingleThreadCpuSuite, AdditiveSTDPNetwork)
 
     loop_projection.get_shared_parameters().stdp_populations_[population.get_uid()] =
         STDPDeltaProjection::SharedSynapseParameters::ProcessingType::STDPAndSpike;
+    loop_projection.get_shared_parameters().synapses_parameters_.tau_plus_ = 1;
+    loop_projection.get_shared_parameters().synapses_parameters_.tau_minus_ = 1;
 
     backend.load_populations({population});
     backend.load_projections({input_projection, loop_projection});
@@ -188,6 +514,144 @@ TEST(SingleThreadCpuSuite, AdditiveSTDPNetwork)
 }
 
 
+float run_additive_stdp_synapse(
+    const std::vector<knp::core::Step> &presynaptic_spikes, const std::vector<knp::core::Step> &postsynaptic_spikes,
+    knp::synapse_traits::STDPPairing pairing, uint32_t weight_update_interval = 1, bool update_at_step_end = false,
+    bool lock_weights = false, bool export_network = false)
+{
+    using STDPDeltaProjection = knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse>;
+
+    // A single synapse gets presynaptic spikes from one channel and postsynaptic spikes from another.
+    knp::testing::STestingBack backend;
+    const knp::core::UID pre_channel_uid, post_channel_uid;
+    STDPDeltaProjection projection{knp::core::UID{false}, knp::core::UID{}};
+    projection.add_synapses(
+        {STDPDeltaProjection::Synapse{{{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, {}}, 0, 0}});
+    auto &shared_parameters = projection.get_shared_parameters();
+    shared_parameters.stdp_populations_[post_channel_uid] =
+        STDPDeltaProjection::SharedSynapseParameters::ProcessingType::STDPOnly;
+    shared_parameters.synapses_parameters_ = {3, 5, 0.5F, -0.25F, pairing};
+    shared_parameters.synapses_parameters_.weight_update_interval_ = weight_update_interval;
+    shared_parameters.synapses_parameters_.update_weights_at_step_end_ = update_at_step_end;
+
+    backend.load_projections({projection});
+    backend.subscribe<knp::core::messaging::SpikeMessage>(projection.get_uid(), {pre_channel_uid});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    for (knp::core::Step step = 0; step < 15; ++step)
+    {
+        // Spike times are taken from message headers.
+        const auto send_spike = [&endpoint, step](const auto &spikes, const knp::core::UID &channel_uid)
+        {
+            if (std::find(spikes.begin(), spikes.end(), step) == spikes.end()) return;
+            endpoint.send_message(knp::core::messaging::SpikeMessage{{channel_uid, step}, {0}});
+        };
+        send_spike(presynaptic_spikes, pre_channel_uid);
+        send_spike(postsynaptic_spikes, post_channel_uid);
+        backend._step();
+    }
+    if (lock_weights) backend.stop_learning();
+
+    if (export_network)
+    {
+        const auto ranges = backend.get_network_data();
+        const auto exported = std::get<STDPDeltaProjection>(**ranges.projection_range.first);
+        return std::get<knp::core::synapse_data>(exported[0]).weight_;
+    }
+    const auto &result = std::get<STDPDeltaProjection>(backend.begin_projections()->arg_);
+    return std::get<knp::core::synapse_data>(result[0]).weight_;
+}
+
+
+TEST(SingleThreadCpuSuite, AdditiveSTDPTraces)
+{
+    // Weight changes calculated with spike traces are equal to the sums of pair contributions.
+    const std::vector<knp::core::Step> presynaptic_spikes = {1, 4, 6, 10};
+    const std::vector<knp::core::Step> postsynaptic_spikes = {2, 4, 9, 12};
+    // Closed form of the rule with the projection parameters.
+    const knp::backends::cpu::STDPFormula stdp_formula(3, 5, 0.5F, -0.25F);
+    const double all_to_all = 1 + stdp_formula(presynaptic_spikes, postsynaptic_spikes);
+    const auto stdp_w = [&stdp_formula](double diff) { return stdp_formula.stdp_w(static_cast<float>(diff)); };
+
+    // A postsynaptic spike is paired with the last earlier presynaptic spike, a presynaptic spike is paired with the
+    // last earlier or simultaneous postsynaptic spike.
+    double nearest = 1;
+    for (const auto t_n : postsynaptic_spikes)
+    {
+        const auto iter = std::lower_bound(presynaptic_spikes.begin(), presynaptic_spikes.end(), t_n);
+        if (iter != presynaptic_spikes.begin()) nearest += stdp_w(static_cast<double>(t_n) - *std::prev(iter));
+    }
+    for (const auto t_f : presynaptic_spikes)
+    {
+        const auto iter = std::upper_bound(postsynaptic_spikes.begin(), postsynaptic_spikes.end(), t_f);
+        if (iter != postsynaptic_spikes.begin()) nearest += stdp_w(static_cast<double>(*std::prev(iter)) - t_f);
+    }
+
+    ASSERT_NEAR(
+        run_additive_stdp_synapse(
+            presynaptic_spikes, postsynaptic_spikes, knp::synapse_traits::STDPPairing::all_to_all),
+        all_to_all, 1e-5);
+    ASSERT_NEAR(
+        run_additive_stdp_synapse(
+            presynaptic_spikes, postsynaptic_spikes, knp::synapse_traits::STDPPairing::nearest_neighbour),
+        nearest, 1e-5);
+}
+
+
+TEST(SingleThreadCpuSuite, AdditiveSTDPDeferredWeights)
+{
+    const std::vector<knp::core::Step> presynaptic_spikes = {1, 4, 6, 10};
+    const std::vector<knp::core::Step> postsynaptic_spikes = {2, 4, 9, 12};
+    constexpr auto pairing = knp::synapse_traits::STDPPairing::all_to_all;
+    const float immediate_weight = run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing);
+
+    // Changes applied on the last step in a batch give the same weight as changes applied on every step, up to the
+    // order of summation.
+    ASSERT_FLOAT_EQ(run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing, 5), immediate_weight);
+    ASSERT_FLOAT_EQ(
+        run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing, 5, true), immediate_weight);
+    // Changes are not applied before the end of an interval.
+    ASSERT_EQ(run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing, 100), 1.0F);
+    // Pending changes are applied when weights are locked.
+    ASSERT_FLOAT_EQ(
+        run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing, 100, false, true),
+        immediate_weight);
+    // Exported projections include pending changes.
+    ASSERT_FLOAT_EQ(
+        run_additive_stdp_synapse(presynaptic_spikes, postsynaptic_spikes, pairing, 100, false, false, true),
+        immediate_weight);
+}
+
+
+TEST(SingleThreadCpuSuite, AdditiveSTDPPendingWeightsFlush)
+{
+    using STDPDeltaProjection = knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse>;
+    STDPDeltaProjection projection{knp::core::UID{}, knp::core::UID{}};
+    projection.add_synapses(
+        {STDPDeltaProjection::Synapse{{{1.0, 2, knp::synapse_traits::OutputType::EXCITATORY}, {}}, 0, 0},
+         STDPDeltaProjection::Synapse{{{2.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, {}}, 0, 1}});
+    auto &params = projection.get_shared_parameters().synapses_parameters_;
+
+    // Changes of a synapse are summed.
+    knp::backends::cpu::add_pending_weight_change(params, projection.size(), 1, 0.5F);
+    knp::backends::cpu::add_pending_weight_change(params, projection.size(), 1, 0.25F);
+    ASSERT_EQ(params.pending_synapses_.size(), 1);
+    ASSERT_FLOAT_EQ(params.pending_weight_changes_[1], 0.75F);
+
+    // Changes are applied before synapses are reordered, so they do not move to other synapses.
+    projection.order_synapses_by_delay();
+    ASSERT_TRUE(params.pending_synapses_.empty());
+    ASSERT_FLOAT_EQ(std::get<knp::core::synapse_data>(projection[0]).weight_, 2.75F);
+    ASSERT_FLOAT_EQ(std::get<knp::core::synapse_data>(projection[1]).weight_, 1.0F);
+
+    // Changes are applied before synapses are removed.
+    knp::backends::cpu::add_pending_weight_change(params, projection.size(), 1, -0.5F);
+    projection.remove_synapse(0);
+    ASSERT_FLOAT_EQ(std::get<knp::core::synapse_data>(projection[0]).weight_, 0.5F);
+}
+
+
 TEST(SingleThreadCpuSuite, ResourceSTDPNetwork)
 {
     using STDPDeltaProjection = knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse>;
@@ -283,6 +747,96 @@ TEST(SingleThreadCpuSuite, ResourceSTDPNetwork)
 }
 
 
+TEST(SingleThreadCpuSuite, Float32ResourceSTDPNetwork)
+{
+    using STDPDeltaProjection = knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse>;
+    using BlifatStdpPopulation = knp::core::Population<knp::neuron_traits::Float32SynapticResourceSTDPBLIFATNeuron>;
+
+    // The same network as in the ResourceSTDPNetwork test, but with single-precision neurons.
+    auto stdp_input_projection_gen = [](size_t /*index*/) -> std::optional<STDPDeltaProjection::Synapse>
+    {
+        return STDPDeltaProjection::Synapse{
+            {{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, {0, 1, 2, 0.1F}}, 0, 0};
+    };
+    auto stdp_synapse_generator = [](size_t /*index*/) -> std::optional<STDPDeltaProjection::Synapse> {
+        return STDPDeltaProjection::Synapse{{{1.0, 6, knp::synapse_traits::OutputType::EXCITATORY}, {0, 1, 2}}, 0, 0};
+    };
+
+    knp::testing::STestingBack backend;
+
+    BlifatStdpPopulation population{
+        knp::core::UID(),
+        [](uint64_t) -> std::optional<BlifatStdpPopulation::NeuronParameters>
+        {
+            BlifatStdpPopulation::NeuronParameters neuron{{}};
+            neuron.synaptic_resource_threshold_ = 1;
+            neuron.free_synaptic_resource_ = 2;
+            neuron.isi_max_ = 0;
+            return neuron;
+        },
+        1};
+    auto loop_projection = STDPDeltaProjection{population.get_uid(), population.get_uid(), stdp_synapse_generator, 1};
+    Projection input_projection =
+        STDPDeltaProjection{knp::core::UID{false}, population.get_uid(), stdp_input_projection_gen, 1};
+    const knp::core::UID input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    backend._init();
+    backend.start_learning();
+    const auto results = knp::testing::run_smallest_network(backend, input_uid, population.get_uid());
+
+    float new_weight = 0;
+    for (auto proj = backend.begin_projections(); proj != backend.end_projections(); ++proj)
+    {
+        const auto &prj = std::get<STDPDeltaProjection>(proj->arg_);
+        if (prj.get_uid() == loop_projection.get_uid()) new_weight = std::get<knp::core::synapse_data>(prj[0]).weight_;
+    }
+
+    ASSERT_EQ(results, knp::testing::smallest_network_results);
+    ASSERT_NE(std::get<knp::core::synapse_data>(loop_projection[0]).weight_, new_weight);
+}
+
+
+TEST(SingleThreadCpuSuite, ImpactAccumulation)
+{
+    // Impacts of different types from several messages are summed before they are applied to neurons.
+    using OutputType = knp::synapse_traits::OutputType;
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 3};
+    const knp::core::UID in_uid;
+    backend.subscribe<knp::core::messaging::SynapticImpactMessage>(population.get_uid(), {in_uid});
+    backend.load_populations({population});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::messaging::MessageHeader header{in_uid, 0};
+    endpoint.send_message(knp::core::messaging::SynapticImpactMessage{
+        header,
+        knp::core::UID{false},
+        population.get_uid(),
+        false,
+        {{0, 0.25F, OutputType::EXCITATORY, 0, 1},
+         {1, 0.5F, OutputType::EXCITATORY, 0, 2},
+         {2, 0.125F, OutputType::INHIBITORY_CURRENT, 0, 1}}});
+    endpoint.send_message(knp::core::messaging::SynapticImpactMessage{
+        header,
+        knp::core::UID{false},
+        population.get_uid(),
+        false,
+        {{3, 0.5F, OutputType::EXCITATORY, 0, 1}, {4, 0.25F, OutputType::DOPAMINE, 0, 2}}});
+    backend._step();
+
+    const auto &neurons = std::get<knp::testing::BLIFATPopulation>(*backend.begin_populations());
+    ASSERT_DOUBLE_EQ(neurons[0].potential_, 0);
+    ASSERT_DOUBLE_EQ(neurons[1].potential_, 0.625);
+    ASSERT_DOUBLE_EQ(neurons[2].potential_, 0.5);
+    ASSERT_DOUBLE_EQ(neurons[2].dopamine_value_, 0.25);
+}
+
+
 TEST(SingleThreadCpuSuite, NeuronsGettingTest)
 {
     const knp::testing::STestingBack backend;
@@ -0,0 +1,75 @@
+/**
+ * @file smallest_network.h
+ * @brief Common execution loop of the smallest network used in backend tests.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/uid.h>
+
+#include <vector>
+
+
+/**
+ * @brief Test namespace.
+ */
+namespace knp::testing
+{
+
+// Spikes on steps "5n + 1" (input) and on "previous_spike_n + 6" (positive feedback loop).
+inline const std::vector<knp::core::Step> smallest_network_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+
+
+// Run the smallest network: input -> input_projection -> population <=> loop_projection.
+// The network must be loaded into the initialized backend. Inputs are sent on steps 0, 5, 10, 15.
+// Return the steps on which the population spikes.
+template <class Backend>
+std::vector<knp::core::Step> run_smallest_network(
+    Backend &backend, const knp::core::UID &input_projection_uid, const knp::core::UID &population_uid)
+{
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+
+    // Create input and output.
+    backend.template subscribe<knp::core::messaging::SpikeMessage>(input_projection_uid, {in_channel_uid});
+    endpoint.template subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population_uid});
+
+    std::vector<knp::core::Step> results;
+
+    for (knp::core::Step step = 0; step < 20; ++step)
+    {
+        if (step % 5 == 0)
+        {
+            knp::core::messaging::SpikeMessage message{{in_channel_uid, step}, {0}};
+            endpoint.send_message(message);
+        }
+        backend._step();
+        endpoint.receive_all_messages();
+        if (!endpoint.template unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty())
+        {
+            results.push_back(step);
+        }
+    }
+
+    return results;
+}
+
+}  // namespace knp::testing
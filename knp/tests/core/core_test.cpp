@@ -20,9 +20,14 @@
  */
 
 #include <knp/core/core.h>
+#include <knp/meta/variant_helpers.h>
 
 #include <tests_common.h>
 
+#include <string>
+#include <variant>
+#include <vector>
+
 
 TEST(CoreSuite, TagMapTest)
 {
@@ -38,3 +43,39 @@ TEST(CoreSuite, TagMapTest)
 
     ASSERT_TRUE(!tag_map.empty());
 }
+
+
+TEST(CoreSuite, VariantPartitionTest)
+{
+    using Element = std::variant<int, std::string, double>;
+    std::vector<Element> elements{std::string("a"), 1, 2.5, 2, std::string("b")};
+
+    knp::meta::VariantPartition<Element> partition;
+    partition.build(elements);
+    // Consecutive elements of the same type form a run.
+    std::vector<std::vector<size_t>> runs;
+    for (const auto &run : partition.get_runs()) runs.push_back({run.type_index_, run.begin_, run.end_});
+    ASSERT_EQ(runs, std::vector<std::vector<size_t>>({{1, 0, 1}, {0, 1, 2}, {2, 2, 3}, {0, 3, 4}, {1, 4, 5}}));
+
+    // Elements are visited in the container order.
+    std::string visited;
+    partition.for_each(
+        elements,
+        [&visited](auto &value, size_t index)
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string>)
+                value += "!";
+            else
+                value *= 2;
+            visited += std::to_string(index);
+        });
+    ASSERT_EQ(visited, "01234");
+    ASSERT_EQ(std::get<int>(elements[3]), 4);
+    ASSERT_EQ(std::get<std::string>(elements[4]), "b!");
+    ASSERT_DOUBLE_EQ(std::get<double>(elements[2]), 5.0);
+
+    // Elements loaded type by type form one run per type.
+    partition.build(std::vector<Element>{1, 2, 2.5, 3.5, std::string("c")});
+    ASSERT_EQ(partition.get_runs().size(), 3);
+}
@@ -27,10 +27,16 @@ extern "C"
 #endif
 
 #include <knp/backends/cpu-single-threaded/backend.h>
+#include <knp/core/uid.h>
 #include <knp/devices/cpu.h>
 
 #include <tests_common.h>
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
 TEST(DeviceTestSuite, CPUTest)
 {
     GTEST_SKIP() << "This test doesn't work under Github builders";
@@ -81,3 +87,57 @@ TEST(DeviceTestSuite, BackendDevicesTest)
 
     // std::cout << device.get_name() << std::endl;
 }
+
+
+TEST(DeviceTestSuite, CPUTopologyTest)
+{
+    // Two sockets, each has one core with two SMT threads and its own NUMA node.
+    // Concurrent test runs use different directories.
+    std::ostringstream directory_name;
+    directory_name << "knp-cpu-topology-test-" << knp::core::UID{};
+    const auto system_path = std::filesystem::temp_directory_path() / directory_name.str();
+    auto write_file = [&system_path](const std::string &path, const std::string &content)
+    {
+        std::filesystem::create_directories((system_path / path).parent_path());
+        std::ofstream(system_path / path) << content << "\n";
+    };
+    write_file("cpu/online", "0-3");
+    for (unsigned cpu = 0; cpu < 4; ++cpu)
+    {
+        const std::string cpu_path = "cpu/cpu" + std::to_string(cpu) + "/";
+        write_file(cpu_path + "topology/physical_package_id", std::to_string(cpu % 2));
+        write_file(cpu_path + "topology/core_id", "0");
+        write_file(cpu_path + "cache/index0/level", "1");
+        write_file(cpu_path + "cache/index0/type", "Instruction");
+        write_file(cpu_path + "cache/index0/size", "32K");
+        write_file(cpu_path + "cache/index1/level", "2");
+        write_file(cpu_path + "cache/index1/type", "Unified");
+        write_file(cpu_path + "cache/index1/size", "1024K");
+        write_file(cpu_path + "cache/index2/level", "3");
+        write_file(cpu_path + "cache/index2/type", "Unified");
+        write_file(cpu_path + "cache/index2/size", "32M");
+    }
+    write_file("node/online", "0-1");
+    write_file("node/node0/cpulist", "0,2");
+    write_file("node/node0/meminfo", "Node 0 MemTotal:       1024 kB");
+    write_file("node/node1/cpulist", "1,3");
+    write_file("node/node1/meminfo", "Node 1 MemTotal:       2048 kB");
+
+    const auto topology = knp::devices::cpu::get_cpu_topology(system_path);
+    std::filesystem::remove_all(system_path);
+
+    ASSERT_EQ(topology.sockets_, std::vector<unsigned>({0, 1}));
+    ASSERT_EQ(topology.cores_.size(), 2);
+    ASSERT_EQ(topology.cores_[1].threads_, std::vector<unsigned>({1, 3}));
+    ASSERT_EQ(topology.get_threads_count(), 4);
+    ASSERT_EQ(topology.l2_cache_bytes_, 1024 * 1024);
+    ASSERT_EQ(topology.l3_cache_bytes_, 32 * 1024 * 1024);
+    ASSERT_EQ(topology.nodes_.size(), 2);
+    ASSERT_EQ(topology.nodes_[1].cpus_, std::vector<unsigned>({1, 3}));
+    ASSERT_EQ(topology.nodes_[1].memory_bytes_, 2048 * 1024);
+
+    const auto socket_topology = knp::devices::cpu::get_socket_topology(topology, 1);
+    ASSERT_EQ(socket_topology.get_threads_count(), 2);
+    ASSERT_EQ(socket_topology.nodes_.size(), 1);
+    ASSERT_EQ(socket_topology.nodes_[0].id_, 1);
+}
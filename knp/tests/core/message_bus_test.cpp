@@ -174,3 +174,77 @@ TEST(MessageBusSuite, SynapticImpactMessageSendCPU)
     ASSERT_EQ(msgs[0].is_forcing_, msg.is_forcing_);
     ASSERT_EQ(msgs[0].impacts_, msg.impacts_);
 }
+
+
+TEST(MessageBusSuite, RouteToSeveralSubscriptionsCPU)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    std::shared_ptr<knp::core::MessageBus> bus = knp::core::MessageBus::construct_cpu_bus();
+
+    auto ep1{bus->create_endpoint()};
+    auto ep2{bus->create_endpoint()};
+
+    const knp::core::UID sender1, sender2, receiver1, receiver2;
+
+    ep2.subscribe<SpikeMessage>(receiver1, {sender1});
+    ep2.subscribe<SpikeMessage>(receiver2, {sender1, sender2});
+
+    ep1.send_message(SpikeMessage{{sender1}, {1}});
+    ep1.send_message(SpikeMessage{{sender2}, {2}});
+    bus->route_messages();
+    ep2.receive_all_messages();
+
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver1).size(), 1);
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver2).size(), 2);
+
+    // After unsubscribing, messages from the sender must not reach the receiver.
+    EXPECT_TRUE(ep2.unsubscribe<SpikeMessage>(receiver2));
+    ep1.send_message(SpikeMessage{{sender1}, {3}});
+    ep1.send_message(SpikeMessage{{sender2}, {4}});
+    bus->route_messages();
+    ep2.receive_all_messages();
+
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver1).size(), 1);
+    EXPECT_TRUE(ep2.unload_messages<SpikeMessage>(receiver2).empty());
+}
+
+
+TEST(MessageBusSuite, ChangeSubscriptionSendersCPU)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    std::shared_ptr<knp::core::MessageBus> bus = knp::core::MessageBus::construct_cpu_bus();
+
+    auto ep1{bus->create_endpoint()};
+    auto ep2{bus->create_endpoint()};
+
+    const knp::core::UID sender1, sender2, receiver;
+
+    auto &subscription = ep2.subscribe<SpikeMessage>(receiver, {sender1});
+    const auto receiver_handle = ep2.get_receiver_handle(receiver);
+
+    ep1.send_message(SpikeMessage{{sender1}, {1}});
+    bus->route_messages();
+    ep2.receive_all_messages();
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver_handle).size(), 1);
+
+    // Senders changed via the subscription must be taken into account by the endpoint.
+    subscription.add_sender(sender2);
+    subscription.remove_sender(sender1);
+    ep1.send_message(SpikeMessage{{sender1}, {2}});
+    ep1.send_message(SpikeMessage{{sender2}, {3}});
+    bus->route_messages();
+    ep2.receive_all_messages();
+
+    const auto messages = ep2.unload_messages<SpikeMessage>(receiver_handle);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].header_.sender_uid_, sender2);
+
+    // Handle stays valid after the receiver is removed and subscribed again.
+    ep2.remove_receiver(receiver);
+    ep2.subscribe<SpikeMessage>(receiver, {sender1});
+    ep1.send_message(SpikeMessage{{sender1}, {4}});
+    bus->route_messages();
+    ep2.receive_all_messages();
+    EXPECT_EQ(ep2.get_receiver_handle(receiver), receiver_handle);
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver_handle).size(), 1);
+}
@@ -21,9 +21,12 @@
 
 #include <knp/core/population.h>
 #include <knp/neuron-traits/blifat.h>
+#include <knp/neuron-traits/homogeneous_blifat.h>
 
 #include <tests_common.h>
 
+#include <utility>
+
 
 using BLIFATParams = knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>;
 
@@ -69,6 +72,64 @@ TEST(PopulationSuite, RemoveNeurons)
 }
 
 
+TEST(PopulationSuite, RemoveUnsortedNeurons)
+{
+    knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(neuron_generator, neurons_count);
+
+    population.remove_neurons({7, 2, 7, 0});
+
+    ASSERT_EQ(population.size(), neurons_count - 3);
+    const std::vector<double> expected_potentials{1, 3, 4, 5, 6, 8, 9};
+    for (size_t i = 0; i < population.size(); ++i)
+    {
+        ASSERT_EQ(population[i].potential_, expected_potentials[i]);
+    }
+    ASSERT_THROW(population.remove_neurons({neurons_count}), std::out_of_range);
+}
+
+
+TEST(PopulationSuite, RemoveNeuronsWithTags)
+{
+    knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(neuron_generator, neurons_count);
+    population.get_tags()["neuron_tags"] = std::vector<knp::core::TagMap>(neurons_count);
+    for (size_t i = 0; i < neurons_count; ++i) population.get_neuron_tags(i)["index"] = i;
+
+    population.remove_neurons({7, 2, 0});
+    population.remove_neuron(1);
+
+    const std::vector<size_t> expected_indexes{1, 4, 5, 6, 8, 9};
+    ASSERT_EQ(population.size(), expected_indexes.size());
+    for (size_t i = 0; i < population.size(); ++i)
+    {
+        ASSERT_EQ(population.get_neuron_tags(i).get_tag<size_t>("index"), expected_indexes[i]);
+        ASSERT_EQ(population[i].potential_, static_cast<double>(expected_indexes[i]));
+    }
+    ASSERT_EQ(population.get_tags().get_tag<std::vector<knp::core::TagMap>>("neuron_tags").size(), population.size());
+}
+
+
+TEST(PopulationSuite, MemoryUsage)
+{
+    knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(neuron_generator, neurons_count);
+
+    const auto estimate = decltype(population)::estimate_memory_usage(neurons_count);
+    auto usage = population.get_memory_usage();
+    ASSERT_EQ(usage.parameters_, estimate.parameters_);
+    ASSERT_EQ(usage.tags_, 0);
+    ASSERT_EQ(usage.total(), usage.parameters_);
+
+    population.get_tags()["very_long_tag_name_that_does_not_fit_into_the_string_object"] = 1;
+    usage = population.get_memory_usage();
+    ASSERT_GT(usage.tags_, 0);
+    ASSERT_EQ(usage.total(), usage.parameters_ + usage.tags_);
+
+    // Tag values are counted too.
+    const auto tags_usage = usage.tags_;
+    population.get_tags()["neuron_tags"] = std::vector<knp::core::TagMap>(neurons_count);
+    ASSERT_GE(population.get_memory_usage().tags_, tags_usage + neurons_count * sizeof(knp::core::TagMap));
+}
+
+
 TEST(PopulationSuite, SetNeuronParameter)
 {
     knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(neuron_generator, neurons_count);
@@ -81,3 +142,27 @@ TEST(PopulationSuite, SetNeuronParameter)
 
     ASSERT_EQ(150, population[p_index].potential_);
 }
+
+
+TEST(PopulationSuite, SharedParameters)
+{
+    using HomogeneousPopulation = knp::core::Population<knp::neuron_traits::HomogeneousBLIFATNeuron>;
+
+    HomogeneousPopulation population(
+        [](size_t index)
+        {
+            HomogeneousPopulation::NeuronParameters params;
+            params.potential_ = static_cast<double>(index);
+            return params;
+        },
+        neurons_count);
+
+    ASSERT_EQ(neurons_count, population.size());
+    ASSERT_EQ(population[3].potential_, 3);
+
+    population.get_shared_parameters().potential_decay_ = 0.5;
+    ASSERT_EQ(std::as_const(population).get_shared_parameters().potential_decay_, 0.5);
+
+    // Neurons store only their state.
+    ASSERT_LT(sizeof(HomogeneousPopulation::NeuronParameters) * 2, sizeof(BLIFATParams));
+}
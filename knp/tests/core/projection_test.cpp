@@ -21,11 +21,19 @@
 
 #include <knp/core/projection.h>
 #include <knp/synapse-traits/delta.h>
+#include <knp/synapse-traits/stdp_type_traits.h>
 
 #include <tests_common.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <set>
+#include <stdexcept>
+#include <tuple>
 
 
 namespace knc = knp::core;
@@ -218,6 +226,83 @@ TEST(ProjectionSuite, SynapseRemoval)
 }
 
 
+TEST(ProjectionSuite, BatchSynapseRemoval)
+{
+    const uint32_t presynaptic_size = 13;
+    const uint32_t postsynaptic_size = 17;
+    auto generator = make_dense_generator(
+        {presynaptic_size, postsynaptic_size}, {0.0F, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, presynaptic_size * postsynaptic_size};
+
+    // Remove every third synapse, indexes are unsorted and repeated.
+    std::vector<size_t> indexes_to_remove;
+    for (size_t i = 0; i < projection.size(); i += 3) indexes_to_remove.push_back(projection.size() - 1 - i);
+    indexes_to_remove.push_back(projection.size() - 1);
+    const auto starting_size = projection.size();
+    const size_t count = projection.remove_synapses(indexes_to_remove);
+    ASSERT_EQ(count, (starting_size + 2) / 3);
+    ASSERT_EQ(projection.size(), starting_size - count);
+    ASSERT_THROW(projection.remove_synapses({projection.size()}), std::out_of_range);
+
+    // Order of the remaining synapses does not change.
+    for (size_t i = 1; i < projection.size(); ++i)
+    {
+        const auto prev_index = std::get<knp::core::source_neuron_id>(projection[i - 1]) * postsynaptic_size +
+                                std::get<knp::core::target_neuron_id>(projection[i - 1]);
+        const auto index = std::get<knp::core::source_neuron_id>(projection[i]) * postsynaptic_size +
+                           std::get<knp::core::target_neuron_id>(projection[i]);
+        ASSERT_LT(prev_index, index);
+    }
+
+    // The synapse index stays correct after removal and addition.
+    projection.remove_presynaptic_neuron_synapses(3);
+    projection.add_synapses({Synapse{{}, 3, 5}, Synapse{{}, 4, 5}});
+    projection.remove_postsynaptic_neuron_synapses(6);
+    for (size_t neuron = 0; neuron < postsynaptic_size; ++neuron)
+    {
+        for (const auto index : projection.find_synapses(neuron, DeltaProjection::Search::by_postsynaptic))
+        {
+            ASSERT_EQ(std::get<knp::core::target_neuron_id>(projection[index]), neuron);
+        }
+        const auto synapses_count = std::count_if(
+            projection.begin(), projection.end(),
+            [neuron](const Synapse &synapse) { return std::get<knp::core::target_neuron_id>(synapse) == neuron; });
+        ASSERT_EQ(projection.find_synapses(neuron, DeltaProjection::Search::by_postsynaptic).size(), synapses_count);
+    }
+    const auto synapses_from_3 = projection.find_synapses(3, DeltaProjection::Search::by_presynaptic);
+    ASSERT_EQ(synapses_from_3.size(), 1);
+    ASSERT_EQ(synapses_from_3[0], projection.size() - 2);
+    ASSERT_EQ(std::get<knp::core::target_neuron_id>(projection[synapses_from_3[0]]), 5);
+}
+
+
+TEST(ProjectionSuite, MemoryUsage)
+{
+    const uint32_t presynaptic_size = 100;
+    const uint32_t postsynaptic_size = 50;
+    const size_t synapses_count = presynaptic_size * postsynaptic_size;
+    auto generator = make_dense_generator(
+        {presynaptic_size, postsynaptic_size}, {0.0F, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, synapses_count};
+
+    const auto estimate = DeltaProjection::estimate_memory_usage(synapses_count);
+    const auto usage = projection.get_memory_usage();
+    ASSERT_GE(usage.parameters_, estimate.parameters_);
+    ASSERT_LE(usage.parameters_, 2 * estimate.parameters_);
+    ASSERT_GT(usage.index_, synapses_count * sizeof(size_t));
+    ASSERT_LE(usage.index_, 2 * estimate.index_);
+    ASSERT_EQ(usage.plasticity_, 0);
+    ASSERT_EQ(usage.queues_, 0);
+
+    // Spike traces of STDP projections are a plasticity state.
+    using STDPProjection = knc::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse>;
+    STDPProjection stdp_projection{knc::UID{}, knc::UID{}};
+    stdp_projection.add_synapses({STDPProjection::Synapse{{}, 0, 0}});
+    stdp_projection.get_shared_parameters().synapses_parameters_.presynaptic_traces_.resize(10);
+    ASSERT_GE(stdp_projection.get_memory_usage().plasticity_, 10 * sizeof(knp::synapse_traits::STDPSpikeTrace));
+}
+
+
 TEST(ProjectionSuite, LockTest)
 {
     DeltaProjection projection(knc::UID{}, knc::UID{});
@@ -257,6 +342,226 @@ TEST(ProjectionSuite, DisconnectNeurons)
 }
 
 
+TEST(ProjectionSuite, ColumnarAccess)
+{
+    const uint32_t presynaptic_size = 7;
+    const uint32_t postsynaptic_size = 5;
+    auto generator = make_dense_generator(
+        {presynaptic_size, postsynaptic_size}, {0.5F, 2, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, presynaptic_size * postsynaptic_size};
+
+    const auto &presynaptic_indexes = projection.get_presynaptic_indexes();
+    const auto &postsynaptic_indexes = projection.get_postsynaptic_indexes();
+    ASSERT_EQ(presynaptic_indexes.size(), projection.size());
+    ASSERT_EQ(postsynaptic_indexes.size(), projection.size());
+    ASSERT_EQ(projection.get_synapses_parameters().size(), projection.size());
+
+    // Changes made via the synapse reference are visible in the arrays.
+    auto synapse = projection[12];
+    std::get<knp::core::synapse_data>(synapse).weight_ = 1.5F;
+    std::get<knp::core::target_neuron_id>(synapse) = 4;
+    ASSERT_EQ(projection.get_synapses_parameters()[12].weight_, 1.5F);
+    ASSERT_EQ(postsynaptic_indexes[12], 4);
+    ASSERT_EQ(presynaptic_indexes[12], 12 / postsynaptic_size);
+
+    // Iterators return the same synapses as indexes.
+    size_t index = 0;
+    for (const auto &syn : projection)
+    {
+        ASSERT_EQ(std::get<knp::core::source_neuron_id>(syn), presynaptic_indexes[index]);
+        ASSERT_EQ(std::get<knp::core::target_neuron_id>(syn), postsynaptic_indexes[index]);
+        ++index;
+    }
+    ASSERT_EQ(index, projection.size());
+    ASSERT_EQ(std::distance(projection.begin(), projection.end()), projection.size());
+
+    // Neuron indexes are stored as 32-bit values.
+    const size_t large_index = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1;
+    ASSERT_THROW(
+        projection.add_synapses(
+            [large_index](size_t) -> std::optional<Synapse> { return Synapse{{}, 0, large_index}; }, 1),
+        std::out_of_range);
+}
+
+
+TEST(ProjectionSuite, PostsynapticSynapseLists)
+{
+    const uint32_t size_from = 9;
+    const uint32_t size_to = 11;
+    const size_t synapses_per_neuron = 3;
+    auto generator =
+        make_cyclic_generator({size_from, size_to}, {0.0F, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, size_from * synapses_per_neuron};
+
+    // Cached lists contain the same synapses as the search results, in ascending order.
+    const auto check_lists = [&projection]()
+    {
+        for (size_t neuron_index = 0; neuron_index < size_to + 1; ++neuron_index)
+        {
+            auto expected = projection.find_synapses(neuron_index, DeltaProjection::Search::by_postsynaptic);
+            std::sort(expected.begin(), expected.end());
+            const auto synapses = projection.get_postsynaptic_synapses(neuron_index);
+            ASSERT_EQ(std::vector<size_t>(synapses.begin(), synapses.end()), expected);
+        }
+    };
+    check_lists();
+
+    // Lists are rebuilt after topology changes.
+    projection.remove_postsynaptic_neuron_synapses(3);
+    ASSERT_TRUE(projection.get_postsynaptic_synapses(3).empty());
+    check_lists();
+    projection.add_synapses({Synapse{{}, 0, size_to}, Synapse{{}, 1, 3}});
+    ASSERT_EQ(projection.get_postsynaptic_synapses(3).size(), 1);
+    check_lists();
+    projection.clear();
+    ASSERT_TRUE(projection.get_postsynaptic_synapses(0).empty());
+}
+
+
+TEST(ProjectionSuite, SynapseRemovalUpdatesCaches)
+{
+    const uint32_t size_from = 7;
+    const uint32_t size_to = 5;
+    auto generator = make_dense_generator({size_from, size_to}, {0.0F, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, size_from * size_to};
+
+    // Synapses found by a scan of the neuron index arrays.
+    const auto scan = [&projection](size_t neuron_index, bool presynaptic)
+    {
+        const auto &neuron_indexes =
+            presynaptic ? projection.get_presynaptic_indexes() : projection.get_postsynaptic_indexes();
+        std::vector<size_t> result;
+        for (size_t i = 0; i < neuron_indexes.size(); ++i)
+        {
+            if (neuron_indexes[i] == neuron_index) result.push_back(i);
+        }
+        return result;
+    };
+    const size_t neurons_count = std::max(size_from, size_to);
+    const auto check_caches = [&projection, &scan, neurons_count]()
+    {
+        for (size_t neuron_index = 0; neuron_index < neurons_count; ++neuron_index)
+        {
+            auto found = projection.find_synapses(neuron_index, DeltaProjection::Search::by_presynaptic);
+            std::sort(found.begin(), found.end());
+            ASSERT_EQ(found, scan(neuron_index, true));
+            const auto presynaptic = projection.get_presynaptic_synapses(neuron_index);
+            ASSERT_EQ(std::vector<size_t>(presynaptic.begin(), presynaptic.end()), scan(neuron_index, true));
+            const auto postsynaptic = projection.get_postsynaptic_synapses(neuron_index);
+            ASSERT_EQ(std::vector<size_t>(postsynaptic.begin(), postsynaptic.end()), scan(neuron_index, false));
+        }
+    };
+    check_caches();
+
+    // Caches are rebuilt after every removal, including removal of the last synapse of a neuron.
+    for (const size_t index : {0, 12, 5, 27, 0})
+    {
+        projection.remove_synapse(index);
+        check_caches();
+    }
+    for (size_t i = 0; i < size_to - 2; ++i) projection.remove_synapse(projection.size() - 1);
+    check_caches();
+    ASSERT_THROW(projection.remove_synapse(projection.size()), std::out_of_range);
+}
+
+
+TEST(ProjectionSuite, OrderSynapsesByDelay)
+{
+    const uint32_t size_from = 5;
+    const uint32_t size_to = 7;
+    DeltaProjection projection{
+        knc::UID{}, knc::UID{},
+        [](size_t index) -> std::optional<Synapse>
+        {
+            // Delays and targets of a presynaptic neuron are shuffled.
+            const auto delay = static_cast<uint32_t>(1 + (index * 7) % 3);
+            return Synapse{
+                {static_cast<float>(index), delay, knp::synapse_traits::OutputType::EXCITATORY}, index % size_from,
+                (index * 3) % size_to};
+        },
+        size_from * size_to};
+
+    std::multiset<std::tuple<size_t, uint32_t, size_t, float>> synapses_before;
+    for (const auto &[params, from, to] : projection) synapses_before.emplace(from, params.delay_, to, params.weight_);
+
+    projection.order_synapses_by_delay();
+
+    // Synapses are the same, each presynaptic row is ordered by delay, then by target.
+    std::multiset<std::tuple<size_t, uint32_t, size_t, float>> synapses_after;
+    for (const auto &[params, from, to] : projection) synapses_after.emplace(from, params.delay_, to, params.weight_);
+    ASSERT_EQ(synapses_before, synapses_after);
+    for (size_t neuron_index = 0; neuron_index < size_from; ++neuron_index)
+    {
+        const auto row = projection.get_presynaptic_synapses(neuron_index);
+        ASSERT_FALSE(row.empty());
+        for (auto iter = row.begin(); iter != row.end(); ++iter)
+        {
+            ASSERT_EQ(std::get<knc::source_neuron_id>(projection[*iter]), neuron_index);
+            if (iter == row.begin()) continue;
+            const auto &previous = projection.get_synapses_parameters()[*(iter - 1)];
+            const auto &current = projection.get_synapses_parameters()[*iter];
+            ASSERT_TRUE(
+                previous.delay_ < current.delay_ ||
+                (previous.delay_ == current.delay_ &&
+                 projection.get_postsynaptic_indexes()[*(iter - 1)] <= projection.get_postsynaptic_indexes()[*iter]));
+        }
+        // The row is a contiguous range of synapse indexes.
+        ASSERT_EQ(*(row.end() - 1) - *row.begin() + 1, row.size());
+    }
+    // The search index is rebuilt after reordering.
+    for (const auto index : projection.find_synapses(2, DeltaProjection::Search::by_postsynaptic))
+    {
+        ASSERT_EQ(std::get<knc::target_neuron_id>(projection[index]), 2);
+    }
+    // Ordered synapses are not copied again.
+    const auto *ordered_parameters = projection.get_synapses_parameters().data();
+    projection.order_synapses_by_delay();
+    ASSERT_EQ(projection.get_synapses_parameters().data(), ordered_parameters);
+}
+
+
+TEST(ProjectionSuite, FileBackedStorage)
+{
+    const uint32_t size_from = 50;
+    const uint32_t size_to = 70;
+    DeltaProjection projection{
+        knc::UID{}, knc::UID{},
+        [](size_t index) -> std::optional<Synapse>
+        {
+            return Synapse{
+                {static_cast<float>(index), 1 + static_cast<uint32_t>(index % 3),
+                 knp::synapse_traits::OutputType::EXCITATORY},
+                index % size_from, (index * 3) % size_to};
+        },
+        size_from * size_to};
+
+    std::multiset<std::tuple<size_t, uint32_t, size_t, float>> synapses_before;
+    for (const auto &[params, from, to] : projection) synapses_before.emplace(from, params.delay_, to, params.weight_);
+
+    auto policy = std::make_shared<knc::StoragePolicy>();
+    policy->backing_directory_ = std::filesystem::temp_directory_path();
+    policy->min_mapped_bytes_ = 1;
+    policy->read_ahead_ = false;
+    policy->order_synapses_ = true;
+    projection.set_storage_policy(policy);
+
+    // Synapses are moved to the mapped storage and ordered by presynaptic neuron.
+    ASSERT_EQ(projection.get_synapses_parameters().get_allocator().get_policy(), policy);
+    std::multiset<std::tuple<size_t, uint32_t, size_t, float>> synapses_after;
+    for (const auto &[params, from, to] : projection) synapses_after.emplace(from, params.delay_, to, params.weight_);
+    ASSERT_EQ(synapses_before, synapses_after);
+    const auto &presynaptic_indexes = projection.get_presynaptic_indexes();
+    ASSERT_TRUE(std::is_sorted(presynaptic_indexes.begin(), presynaptic_indexes.end()));
+
+    // Rows of presynaptic neurons are contiguous, and synapses added later use the same storage.
+    projection.add_synapses({Synapse{{0.5F, 1, knp::synapse_traits::OutputType::EXCITATORY}, 0, 0}});
+    ASSERT_EQ(projection.size(), size_t{size_from} * size_to + 1);
+    const auto row = projection.get_presynaptic_synapses(1);
+    ASSERT_EQ(row.size(), size_to);
+    ASSERT_EQ(*(row.end() - 1) - *row.begin() + 1, row.size());
+}
+
+
 TEST(ProjectionSuite, GetUIDTest)
 {
     const knc::UID uid_from(true);
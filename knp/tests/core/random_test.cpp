@@ -0,0 +1,75 @@
+/**
+ * @file random_test.cpp
+ * @brief Counter-based random generator tests.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/random.h>
+
+#include <tests_common.h>
+
+#include <vector>
+
+
+TEST(RandomSuite, PhiloxKnownAnswers)
+{
+    // Known answer tests of Philox4x32-10 from the reference implementation.
+    const knp::core::PhiloxCounter zero_result{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    ASSERT_EQ(knp::core::philox4x32({0, 0, 0, 0}, {0, 0}), zero_result);
+
+    const knp::core::PhiloxCounter max_result{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    ASSERT_EQ(
+        knp::core::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+        max_result);
+
+    const knp::core::PhiloxCounter pi_result{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    ASSERT_EQ(
+        knp::core::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+        pi_result);
+}
+
+
+TEST(RandomSuite, CounterBasedStreams)
+{
+    constexpr uint64_t seed = 42;
+    constexpr size_t values_count = 1000;
+    const knp::core::UID uid;
+    const knp::core::CounterBasedRandom random{seed, uid};
+
+    // Values do not depend on the order of calls.
+    std::vector<double> forward(values_count), backward(values_count);
+    for (size_t i = 0; i < values_count; ++i) forward[i] = random.uniform(i, 7);
+    for (size_t i = values_count; i-- > 0;) backward[i] = random.uniform(i, 7);
+    ASSERT_EQ(forward, backward);
+
+    double sum = 0;
+    for (const auto value : forward)
+    {
+        ASSERT_GE(value, 0);
+        ASSERT_LT(value, 1);
+        sum += value;
+    }
+    ASSERT_NEAR(sum / values_count, 0.5, 0.05);
+
+    // Different counters, entities and seeds give different streams.
+    ASSERT_NE(random(0, 0), random(0, 1));
+    ASSERT_NE(random(0, 0), random(1, 0));
+    ASSERT_NE(random(0, 0), knp::core::CounterBasedRandom(seed, knp::core::UID{})(0, 0));
+    ASSERT_NE(random(0, 0), knp::core::CounterBasedRandom(seed + 1, uid)(0, 0));
+    ASSERT_EQ(random(5, 3), knp::core::CounterBasedRandom(seed, uid)(5, 3));
+}
@@ -20,6 +20,7 @@
  */
 
 #include <knp/core/uid.h>
+#include <knp/core/uid_handle.h>
 
 #include <tests_common.h>
 
@@ -87,3 +88,24 @@ TEST(UidSuite, UidHash)
     uid_container[uid1] = uid1;
     ASSERT_EQ(uid_container[uid1], uid1);
 }
+
+
+TEST(UidSuite, UidHandleRegistry)
+{
+    ::knp::core::UID uid1{::boost::uuids::uuid{{1, 2, 3}}};
+    ::knp::core::UID uid2{::boost::uuids::uuid{{3, 2, 1}}};
+    ::knp::core::UIDHandleRegistry registry;
+
+    ASSERT_EQ(registry.get_handle(uid1), ::knp::core::invalid_uid_handle);
+    ASSERT_EQ(registry.register_uid(uid1), 0);
+    ASSERT_EQ(registry.register_uid(uid2), 1);
+    // Registering the same UID again returns the same handle.
+    ASSERT_EQ(registry.register_uid(uid1), 0);
+    ASSERT_EQ(registry.size(), 2);
+    ASSERT_EQ(registry.get_handle(uid2), 1);
+    ASSERT_EQ(registry.get_uid(1), uid2);
+
+    registry.clear();
+    ASSERT_EQ(registry.size(), 0);
+    ASSERT_EQ(registry.get_handle(uid1), ::knp::core::invalid_uid_handle);
+}
@@ -30,6 +30,8 @@
 #include <tests_common.h>
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 
 using Synapse = knp::synapse_traits::DeltaSynapse;
@@ -194,3 +196,87 @@ TEST(AltAiSuite, SingleNeuronImpactTest)
     ASSERT_EQ(result.potential_, expected_potential);
     ASSERT_EQ(result.spikes_, expected_spikes);
 }
+
+
+// Reference model follows the description of AltAI neuron flags. Returns `true` if the neuron spiked.
+bool calculate_reference_altai_neuron(knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF> &neuron)
+{
+    neuron.potential_ +=
+        (neuron.leak_rev_ && neuron.potential_ < 0) ? -neuron.potential_leak_ : neuron.potential_leak_;
+    bool spiked = false;
+    bool was_reset = false;
+    if (neuron.potential_ >= neuron.activation_threshold_)
+    {
+        spiked = true;
+        if (neuron.is_diff_) neuron.potential_ -= neuron.activation_threshold_;
+        if (neuron.is_reset_)
+        {
+            neuron.potential_ = neuron.potential_reset_value_;
+            was_reset = true;
+        }
+    }
+    if (!was_reset && neuron.potential_ <= -static_cast<float>(neuron.negative_activation_threshold_))
+    {
+        if (neuron.saturate_)
+            neuron.potential_ = -static_cast<float>(neuron.negative_activation_threshold_);
+        else if (neuron.is_reset_)
+            neuron.potential_ = -static_cast<float>(neuron.potential_reset_value_);
+        else if (neuron.is_diff_)
+            neuron.potential_ += neuron.negative_activation_threshold_;
+    }
+    return spiked;
+}
+
+
+knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF> make_flags_test_neuron(size_t index)
+{
+    knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF> neuron;
+    neuron.is_diff_ = index & 1;
+    neuron.is_reset_ = index & 2;
+    neuron.leak_rev_ = index & 4;
+    neuron.saturate_ = index & 8;
+    neuron.do_not_save_ = (index % 97) == 0;
+    neuron.potential_ = static_cast<float>(index % 41) - 20;
+    neuron.activation_threshold_ = 5 + index % 13;
+    neuron.negative_activation_threshold_ = 3 + index % 11;
+    neuron.potential_leak_ = static_cast<int16_t>(index % 7) - 3;
+    neuron.potential_reset_value_ = index % 5;
+    return neuron;
+}
+
+
+TEST(AltAiSuite, LargePopulationFlagsTest)
+{
+    // Population contains neurons with all combinations of flags, results must match the reference model.
+    using NeuronParameters = knp::neuron_traits::neuron_parameters<knp::neuron_traits::AltAILIF>;
+    constexpr size_t population_size = 600;
+    constexpr size_t steps = 20;
+    const knp::core::UID pop_uid, out_uid;
+    knp::testing::TestingBackendST backend;
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_uid, {pop_uid});
+    backend.load_populations({knp::testing::Population{pop_uid, make_flags_test_neuron, population_size}});
+    backend._init();
+    const auto &population = std::get<knp::testing::Population>(*backend.begin_populations());
+
+    std::vector<NeuronParameters> reference;
+    for (size_t i = 0; i < population_size; ++i) reference.push_back(make_flags_test_neuron(i));
+
+    for (size_t step = 0; step < steps; ++step)
+    {
+        std::vector<knp::core::messaging::SpikeIndex> expected_spikes;
+        for (size_t i = 0; i < population_size; ++i)
+        {
+            auto &neuron = reference[i];
+            neuron.potential_ = neuron.do_not_save_ ? neuron.potential_reset_value_ : std::round(neuron.potential_);
+            if (calculate_reference_altai_neuron(neuron)) expected_spikes.push_back(i);
+        }
+
+        backend._step();
+        endpoint.receive_all_messages();
+        auto out_msgs = endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_uid);
+        const auto spikes = out_msgs.empty() ? knp::core::messaging::SpikeData{} : out_msgs[0].neuron_indexes_;
+        ASSERT_EQ(spikes, expected_spikes);
+        for (size_t i = 0; i < population_size; ++i) ASSERT_EQ(population[i].potential_, reference[i].potential_);
+    }
+}
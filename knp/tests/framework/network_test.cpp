@@ -99,6 +99,29 @@ TEST(FrameworkSuite, NetworkCreation)  //!OCLINT(False positive)
 }
 
 
+TEST(FrameworkSuite, NetworkMemoryUsage)
+{
+    knp::framework::Network network;
+    auto [population1, projection1] = create_entities();
+    const auto population_usage = population1.get_memory_usage();
+    const auto projection_usage = projection1.get_memory_usage();
+
+    network.add_population(std::move(population1));
+    network.add_projection(std::move(projection1));
+
+    const auto usage = network.get_memory_usage();
+    ASSERT_GE(usage.parameters_, population_usage.parameters_ + projection_usage.parameters_);
+    ASSERT_EQ(usage.index_, projection_usage.index_);
+    ASSERT_EQ(usage.queues_, 0);
+    ASSERT_EQ(usage.total(), usage.parameters_ + usage.index_ + usage.plasticity_ + usage.tags_);
+
+    const auto estimate = knp::framework::Network::estimate_memory_usage(
+        {decltype(population1)::estimate_memory_usage(neurons_count)},
+        {DeltaProjection::estimate_memory_usage(synapses_count)});
+    ASSERT_GE(estimate.parameters_, usage.parameters_);
+}
+
+
 TEST(FrameworkSuite, NetworkRemoveEntities)  //!OCLINT(False positive)
 {
     knp::framework::Network network;
@@ -80,3 +80,30 @@ TEST(PopulationGenerators, CreatorCopy)
     ASSERT_EQ(new_pop.size(), neurons_count);
     ASSERT_EQ(new_pop[0].absolute_refractory_period_, source_neuron.absolute_refractory_period_);
 }
+
+
+TEST(PopulationGenerators, CreatorHomogeneous)
+{
+    constexpr auto neurons_count = 5;
+
+    knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron> source_neuron;
+    source_neuron.absolute_refractory_period_ = 3;
+    source_neuron.potential_decay_ = 0.5;
+
+    auto source_pop{knp::framework::population::creators::make_clone<knp::neuron_traits::BLIFATNeuron>(
+        neurons_count, source_neuron)};
+    source_pop[1].potential_ = 0.25;
+
+    const auto new_pop{knp::framework::population::creators::make_homogeneous(source_pop)};
+
+    ASSERT_EQ(new_pop.size(), neurons_count);
+    ASSERT_EQ(new_pop.get_uid(), source_pop.get_uid());
+    ASSERT_EQ(new_pop[1].potential_, source_pop[1].potential_);
+    ASSERT_EQ(new_pop.get_shared_parameters().absolute_refractory_period_, source_neuron.absolute_refractory_period_);
+    ASSERT_EQ(new_pop.get_shared_parameters().potential_decay_, source_neuron.potential_decay_);
+
+    // Static parameters must be the same for all neurons.
+    source_pop[2].activation_threshold_ = 2;
+    ASSERT_THROW(
+        static_cast<void>(knp::framework::population::creators::make_homogeneous(source_pop)), std::invalid_argument);
+}
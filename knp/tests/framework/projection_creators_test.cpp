@@ -20,10 +20,15 @@
  */
 
 #include <knp/framework/projection/creators.h>
+#include <knp/synapse-traits/compressed_delta.h>
 #include <knp/synapse-traits/delta.h>
 
 #include <tests_common.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
 #include <vector>
 
 
@@ -182,6 +187,30 @@ TEST(ProjectionConnectors, FixedProbability)
 }
 
 
+TEST(ProjectionConnectors, SeededFixedProbability)
+{
+    // Connections depend only on the synapse index and the seed, not on the order of generator calls.
+    constexpr size_t src_pop_size = 10;
+    constexpr size_t dest_pop_size = 20;
+    constexpr uint64_t seed = 1234;
+    using Synapse = knp::synapse_traits::DeltaSynapse;
+    knp::framework::projection::synapse_generators::FixedProbability<Synapse> forward_gen{
+        src_pop_size, dest_pop_size, 0.3,
+        knp::framework::projection::parameters_generators::default_synapse_gen<Synapse>, seed};
+    auto backward_gen = forward_gen;
+
+    size_t connections_count = 0;
+    for (size_t index = 0; index < src_pop_size * dest_pop_size; ++index)
+    {
+        const size_t backward_index = src_pop_size * dest_pop_size - 1 - index;
+        ASSERT_EQ(forward_gen(backward_index).has_value(), backward_gen(backward_index).has_value());
+        connections_count += forward_gen(index).has_value();
+    }
+    ASSERT_GT(connections_count, 0);
+    ASSERT_LT(connections_count, src_pop_size * dest_pop_size);
+}
+
+
 TEST(ProjectionConnectors, IndexBased)
 {
     constexpr size_t src_pop_size = 5;
@@ -281,3 +310,87 @@ TEST(ProjectionConnectors, CloneProjection)
         ASSERT_EQ(std::get<knp::core::source_neuron_id>(proj[i]), std::get<knp::core::source_neuron_id>(new_proj[i]));
     }
 }
+
+
+// Compression error is relative to the weight for floating-point encodings and to the maximum weight of the scale
+// group for integer encodings.
+template <typename WeightEncoding>
+void check_compressed_projection(bool per_presynaptic_scale, float max_relative_error, bool relative_to_max_weight)
+{
+    constexpr size_t src_pop_size = 10;
+    constexpr size_t dest_pop_size = 20;
+
+    std::mt19937 rand_gen(42);  // NOLINT
+    std::uniform_real_distribution<float> weight_dist(-2.F, 2.F);
+
+    auto proj = knp::framework::projection::creators::all_to_all<typename knp::synapse_traits::DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), src_pop_size, dest_pop_size,
+        [&](size_t, size_t)
+        {
+            return knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>{
+                weight_dist(rand_gen), 3, knp::synapse_traits::OutputType::EXCITATORY};
+        });
+
+    const auto new_proj =
+        knp::framework::projection::creators::compress_projection<WeightEncoding>(proj, per_presynaptic_scale);
+
+    ASSERT_EQ(new_proj.size(), proj.size());
+    ASSERT_EQ(new_proj.get_uid(), proj.get_uid());
+    ASSERT_EQ(new_proj.get_shared_parameters().synapses_parameters_.presynaptic_scales_.size(),
+              per_presynaptic_scale ? src_pop_size : 0);
+
+    std::vector<float> max_weights(per_presynaptic_scale ? src_pop_size : 1, 0.F);
+    for (size_t i = 0; i < proj.size(); ++i)
+    {
+        auto &max_weight = max_weights[per_presynaptic_scale ? std::get<knp::core::source_neuron_id>(proj[i]) : 0];
+        max_weight = std::max(max_weight, std::fabs(std::get<knp::core::synapse_data>(proj[i]).weight_));
+    }
+
+    const auto &shared_params = new_proj.get_shared_parameters().synapses_parameters_;
+    for (size_t i = 0; i < proj.size(); ++i)
+    {
+        const auto &params = std::get<knp::core::synapse_data>(proj[i]);
+        const auto new_synapse = new_proj[i];
+        const auto presynaptic_index = std::get<knp::core::source_neuron_id>(new_synapse);
+
+        ASSERT_EQ(presynaptic_index, std::get<knp::core::source_neuron_id>(proj[i]));
+        ASSERT_EQ(std::get<knp::core::target_neuron_id>(new_synapse), std::get<knp::core::target_neuron_id>(proj[i]));
+        ASSERT_EQ(std::get<knp::core::synapse_data>(new_synapse).delay_, params.delay_);
+        ASSERT_EQ(std::get<knp::core::synapse_data>(new_synapse).output_type_, params.output_type_);
+
+        const float weight = shared_params.decode_weight(std::get<knp::core::synapse_data>(new_synapse),
+                                                         presynaptic_index);
+        const float reference = relative_to_max_weight ? max_weights[per_presynaptic_scale ? presynaptic_index : 0]
+                                                       : std::fabs(params.weight_);
+        // Decoding of integer codes adds a rounding error of the scale multiplication.
+        ASSERT_LE(
+            std::fabs(weight - params.weight_),
+            max_relative_error * reference + std::numeric_limits<float>::epsilon() * reference);
+    }
+}
+
+
+TEST(ProjectionConnectors, CompressProjection)
+{
+    // Half of the unit in the last place relative to the maximum weight.
+    check_compressed_projection<knp::synapse_traits::Float16WeightEncoding>(false, std::ldexp(1.F, -11), false);
+    check_compressed_projection<knp::synapse_traits::BFloat16WeightEncoding>(false, std::ldexp(1.F, -8), false);
+    check_compressed_projection<knp::synapse_traits::Int8WeightEncoding>(false, 0.5F / 127, true);
+    check_compressed_projection<knp::synapse_traits::Int8WeightEncoding>(true, 0.5F / 127, true);
+}
+
+
+TEST(ProjectionConnectors, CompressProjectionDelayRange)
+{
+    auto proj = knp::framework::projection::creators::all_to_all<typename knp::synapse_traits::DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), 2, 2,
+        [](size_t, size_t)
+        {
+            return knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>{
+                1.F, std::numeric_limits<uint16_t>::max() + 1U, knp::synapse_traits::OutputType::EXCITATORY};
+        });
+
+    ASSERT_THROW(
+        knp::framework::projection::creators::compress_projection<knp::synapse_traits::Int8WeightEncoding>(proj),
+        std::out_of_range);
+}
@@ -20,6 +20,7 @@
  */
 
 #include <knp/core/projection.h>
+#include <knp/framework/projection/creators.h>
 #include <knp/framework/sonata/network_io.h>
 
 #include <generators.h>
@@ -130,3 +131,50 @@ TEST_F(SaveLoadNetworkSuite, SaveLoadTest)
     auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
     ASSERT_TRUE(are_networks_similar(network, network_loaded));
 }
+
+
+TEST_F(SaveLoadNetworkSuite, SaveLoadCompressedProjection)
+{
+    using SynapseType = knp::synapse_traits::Int8DeltaSynapse;
+    namespace kt = knp::testing;
+
+    path_to_network_ = ".";
+    kt::BLIFATPopulation population{kt::neuron_generator, 3};
+    const auto delta_projection = knp::framework::projection::creators::all_to_all<knp::synapse_traits::DeltaSynapse>(
+        population.get_uid(), population.get_uid(), 3, 3,
+        [](size_t presynaptic_index, size_t postsynaptic_index)
+        {
+            return knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>{
+                0.1F * static_cast<float>(presynaptic_index + 1) + 0.03F * static_cast<float>(postsynaptic_index),
+                static_cast<uint32_t>(postsynaptic_index + 1), knp::synapse_traits::OutputType::EXCITATORY};
+        });
+    auto projection =
+        knp::framework::projection::creators::compress_projection<knp::synapse_traits::Int8WeightEncoding>(
+            delta_projection, true);
+
+    knp::framework::Network network;
+    network.add_population(population);
+    network.add_projection(projection);
+    knp::framework::sonata::save_network(network, path_to_network_);
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+
+    const auto &loaded = network_loaded.get_projection<SynapseType>(projection.get_uid());
+    const auto &shared_params = projection.get_shared_parameters().synapses_parameters_;
+    const auto &loaded_shared_params = loaded.get_shared_parameters().synapses_parameters_;
+    EXPECT_EQ(loaded_shared_params.scale_, shared_params.scale_);
+    EXPECT_EQ(loaded_shared_params.presynaptic_scales_, shared_params.presynaptic_scales_);
+
+    ASSERT_EQ(loaded.size(), projection.size());
+    for (size_t i = 0; i < projection.size(); ++i)
+    {
+        const auto &params = std::get<knp::core::synapse_data>(projection[i]);
+        const auto &loaded_params = std::get<knp::core::synapse_data>(loaded[i]);
+        EXPECT_EQ(loaded_params.weight_code_, params.weight_code_);
+        EXPECT_EQ(loaded_params.delay_, params.delay_);
+        EXPECT_EQ(loaded_params.output_type_, params.output_type_);
+        EXPECT_EQ(
+            std::get<knp::core::source_neuron_id>(loaded[i]), std::get<knp::core::source_neuron_id>(projection[i]));
+        EXPECT_EQ(
+            std::get<knp::core::target_neuron_id>(loaded[i]), std::get<knp::core::target_neuron_id>(projection[i]));
+    }
+}
@@ -107,19 +107,14 @@ TEST(SynapseNormalizers, NormalizeNetworkWeights)
 
     for (const auto& n_proj : net.get_projections())
     {
-        std::visit(
-            [](const auto& prj)
-            {
-                for (const auto& synapse : prj)
-                {
-                    const auto params = std::get<knp::core::synapse_data>(synapse);
-
-                    SPDLOG_DEBUG("New synapse weight: {}.", params.weight_);
-
-                    ASSERT_GE(params.weight_, 0);
-                    ASSERT_LE(params.weight_, 1);
-                }
-            },
-            n_proj);
+        for (const auto& synapse : std::get<knp::core::Projection<SynapseType>>(n_proj))
+        {
+            const auto params = std::get<knp::core::synapse_data>(synapse);
+
+            SPDLOG_DEBUG("New synapse weight: {}.", params.weight_);
+
+            ASSERT_GE(params.weight_, 0);
+            ASSERT_LE(params.weight_, 1);
+        }
     }
 }